@@ -0,0 +1,347 @@
+//===----- ct_common/common/annealing_optimizer.cpp -------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class AnnealingOptimizer
+//
+//===----------------------------------------------------------------------===//
+
+#include <cmath>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <boost/random/uniform_01.hpp>
+#include <ct_common/common/annealing_optimizer.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/constraint_checker.h>
+
+using namespace ct::common;
+
+namespace {
+/**
+ * The coverage multiplicities of the target combinations, with the list of
+ * the uncovered ones for picking them at random
+ */
+class CoverageCounter {
+public:
+  CoverageCounter(const CoverageMap &targets, const std::vector<std::vector<std::size_t> > &param_sids)
+      : targets_(targets), param_sids_(param_sids),
+        counts_(targets.get_num_combinations(), 0),
+        uncovered_pos_(targets.get_num_combinations(), CID_BOUND) {
+    for (std::size_t cid = 0; cid < targets.get_num_combinations(); ++cid) {
+      if (targets.IsCovered(cid)) {
+        this->uncovered_pos_[cid] = this->uncovered_.size();
+        this->uncovered_.push_back(cid);
+      }
+    }
+  }
+
+  /** Get the number of uncovered target combinations */
+  std::size_t get_num_uncovered(void) const { return this->uncovered_.size(); }
+  /** Get the i-th uncovered target combination */
+  std::size_t get_uncovered(std::size_t i) const { return this->uncovered_[i]; }
+
+  /** Add the combinations of a test case */
+  void Add(const TestCase &test) {
+    for (std::size_t i = 0; i < this->targets_.get_num_raw_strengths(); ++i) {
+      std::size_t cid = this->targets_.GetCombinationId(i, test);
+      if (cid != CID_BOUND && this->targets_.IsCovered(cid)) {
+        this->increase(cid);
+      }
+    }
+  }
+
+  /** Remove the combinations of a test case */
+  void Remove(const TestCase &test) {
+    for (std::size_t i = 0; i < this->targets_.get_num_raw_strengths(); ++i) {
+      std::size_t cid = this->targets_.GetCombinationId(i, test);
+      if (cid != CID_BOUND && this->targets_.IsCovered(cid)) {
+        this->decrease(cid);
+      }
+    }
+  }
+
+  /** Count the target combinations covered by a test case only */
+  std::size_t CountUnique(const TestCase &test) const {
+    std::size_t tmp_return = 0;
+    for (std::size_t i = 0; i < this->targets_.get_num_raw_strengths(); ++i) {
+      std::size_t cid = this->targets_.GetCombinationId(i, test);
+      if (cid != CID_BOUND && this->targets_.IsCovered(cid) && this->counts_[cid] == 1) {
+        ++tmp_return;
+      }
+    }
+    return tmp_return;
+  }
+
+  /**
+   * Get the change of the number of uncovered combinations if the cell of pid
+   * takes vid, which is applied by the following call to Apply
+   */
+  long Evaluate(const TestCase &test, std::size_t pid, std::size_t vid) {
+    const std::vector<std::size_t> &sids = this->param_sids_[pid];
+    std::size_t level = this->targets_.get_level(pid);
+    std::size_t old_vid = test[pid];
+    this->bases_.clear();
+    this->strides_.clear();
+    long tmp_return = 0;
+    for (std::size_t i = 0; i < sids.size(); ++i) {
+      const RawStrength &raw_strength = this->targets_.get_raw_strength(sids[i]);
+      std::size_t base = this->targets_.get_offset(sids[i]);
+      std::size_t stride = 0;
+      bool is_assigned = true;
+      for (std::size_t j = 0; j < raw_strength.size(); ++j) {
+        if (raw_strength[j] == pid) {
+          stride = this->targets_.get_stride(sids[i], j);
+          continue;
+        }
+        std::size_t other_vid = test[raw_strength[j]];
+        if (other_vid >= this->targets_.get_level(raw_strength[j])) {
+          is_assigned = false;
+          break;
+        }
+        base += other_vid * this->targets_.get_stride(sids[i], j);
+      }
+      if (!is_assigned) {
+        continue;
+      }
+      this->bases_.push_back(base);
+      this->strides_.push_back(stride);
+      if (old_vid < level) {
+        std::size_t cid = base + old_vid * stride;
+        if (this->targets_.IsCovered(cid) && this->counts_[cid] == 1) {
+          ++tmp_return;
+        }
+      }
+      if (vid < level) {
+        std::size_t cid = base + vid * stride;
+        if (this->targets_.IsCovered(cid) && this->counts_[cid] == 0) {
+          --tmp_return;
+        }
+      }
+    }
+    return tmp_return;
+  }
+
+  /** Apply the change evaluated last */
+  void Apply(TestCase &test, std::size_t pid, std::size_t vid) {
+    std::size_t level = this->targets_.get_level(pid);
+    std::size_t old_vid = test[pid];
+    for (std::size_t i = 0; i < this->bases_.size(); ++i) {
+      if (old_vid < level) {
+        std::size_t cid = this->bases_[i] + old_vid * this->strides_[i];
+        if (this->targets_.IsCovered(cid)) {
+          this->decrease(cid);
+        }
+      }
+      if (vid < level) {
+        std::size_t cid = this->bases_[i] + vid * this->strides_[i];
+        if (this->targets_.IsCovered(cid)) {
+          this->increase(cid);
+        }
+      }
+    }
+    test[pid] = vid;
+  }
+
+private:
+  void increase(std::size_t cid) {
+    if (this->counts_[cid]++ == 0) {
+      // remove from the uncovered list by moving the last one in
+      std::size_t pos = this->uncovered_pos_[cid];
+      this->uncovered_[pos] = this->uncovered_.back();
+      this->uncovered_pos_[this->uncovered_[pos]] = pos;
+      this->uncovered_.pop_back();
+      this->uncovered_pos_[cid] = CID_BOUND;
+    }
+  }
+
+  void decrease(std::size_t cid) {
+    if (--this->counts_[cid] == 0) {
+      this->uncovered_pos_[cid] = this->uncovered_.size();
+      this->uncovered_.push_back(cid);
+    }
+  }
+
+private:
+  const CoverageMap &targets_;  /**< The layout of combinations, with the target ones covered */
+  const std::vector<std::vector<std::size_t> > &param_sids_;  /**< The raw strengths involving each parameter */
+  std::vector<boost::uint32_t> counts_;  /**< The coverage multiplicities */
+  std::vector<std::size_t> uncovered_;  /**< The uncovered target combinations */
+  std::vector<std::size_t> uncovered_pos_;  /**< The positions in the uncovered list */
+  std::vector<std::size_t> bases_;  /**< The combination ids of the last evaluation, with the cell taking vid 0 */
+  std::vector<std::size_t> strides_;  /**< The weights of the cell in the combination ids */
+};
+}  // namespace
+
+AnnealingOptimizer::AnnealingOptimizer(void)
+    : max_iterations_(1000000), time_limit_(0), initial_temperature_(0.5),
+      cooling_rate_(0.9999), random_seed_(0), num_iterations_(0), num_removed_(0) {
+}
+
+AnnealingOptimizer::AnnealingOptimizer(const AnnealingOptimizer &from)
+    : max_iterations_(from.max_iterations_), time_limit_(from.time_limit_),
+      initial_temperature_(from.initial_temperature_), cooling_rate_(from.cooling_rate_),
+      random_seed_(from.random_seed_), num_iterations_(from.num_iterations_),
+      num_removed_(from.num_removed_) {
+}
+
+AnnealingOptimizer &AnnealingOptimizer::operator = (const AnnealingOptimizer &right) {
+  this->max_iterations_ = right.max_iterations_;
+  this->time_limit_ = right.time_limit_;
+  this->initial_temperature_ = right.initial_temperature_;
+  this->cooling_rate_ = right.cooling_rate_;
+  this->random_seed_ = right.random_seed_;
+  this->num_iterations_ = right.num_iterations_;
+  this->num_removed_ = right.num_removed_;
+  return *this;
+}
+
+AnnealingOptimizer::~AnnealingOptimizer(void) {
+}
+
+void AnnealingOptimizer::Optimize(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->num_iterations_ = 0;
+  this->num_removed_ = 0;
+  if (tests.size() <= 1) {
+    return;
+  }
+  boost::posix_time::ptime start_time = boost::posix_time::microsec_clock::universal_time();
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  // the targets are the combinations covered by the original suite
+  CoverageMap targets(model.param_specs_, model.strengths_);
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    targets.Cover(tests[i]);
+  }
+  std::vector<std::vector<std::size_t> > param_sids(model.param_specs_.size());
+  for (std::size_t i = 0; i < targets.get_num_raw_strengths(); ++i) {
+    const RawStrength &raw_strength = targets.get_raw_strength(i);
+    for (std::size_t j = 0; j < raw_strength.size(); ++j) {
+      param_sids[raw_strength[j]].push_back(i);
+    }
+  }
+  std::vector<std::size_t> pids;
+  for (std::size_t i = 0; i < model.param_specs_.size(); ++i) {
+    if (!model.param_specs_[i]->is_auto()) {
+      pids.push_back(i);
+    }
+  }
+  if (pids.empty()) {
+    return;
+  }
+  // the test cases matching seeds are frozen
+  std::vector<bool> is_frozen(tests.size(), false);
+  for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+    if (model.seeds_[i]->get_is_starter()) {
+      continue;
+    }
+    for (std::size_t j = 0; j < tests.size(); ++j) {
+      EvalType_Bool result = model.seeds_[i]->IsMatch(tests[j], model.param_specs_);
+      if (result.is_valid_ && result.value_) {
+        is_frozen[j] = true;
+        break;
+      }
+    }
+  }
+  CoverageCounter counter(targets, param_sids);
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    counter.Add(tests[i]);
+  }
+
+  boost::random::mt19937 rng(this->random_seed_);
+  boost::random::uniform_01<double> random_real;
+  std::vector<TestCase> best_tests = tests;
+  std::vector<std::size_t> vids;
+  std::vector<std::size_t> rows;
+  bool is_out_of_budget = false;
+  while (!is_out_of_budget) {
+    // drop the test case covering the fewest combinations alone
+    std::size_t dropped = tests.size();
+    std::size_t min_unique = 0;
+    for (std::size_t i = 0; i < tests.size(); ++i) {
+      if (is_frozen[i]) {
+        continue;
+      }
+      std::size_t num_unique = counter.CountUnique(tests[i]);
+      if (dropped == tests.size() || num_unique < min_unique) {
+        dropped = i;
+        min_unique = num_unique;
+      }
+    }
+    if (dropped == tests.size()) {
+      break;
+    }
+    counter.Remove(tests[dropped]);
+    tests.erase(tests.begin() + dropped);
+    is_frozen.erase(is_frozen.begin() + dropped);
+    rows.clear();
+    for (std::size_t i = 0; i < tests.size(); ++i) {
+      if (!is_frozen[i]) {
+        rows.push_back(i);
+      }
+    }
+
+    double temperature = this->initial_temperature_;
+    while (counter.get_num_uncovered() > 0 && !rows.empty()) {
+      if (this->max_iterations_ > 0 && this->num_iterations_ >= this->max_iterations_) {
+        is_out_of_budget = true;
+        break;
+      }
+      if (this->time_limit_ > 0 && (this->num_iterations_ & 255) == 0 &&
+          (boost::posix_time::microsec_clock::universal_time() - start_time).total_microseconds() >
+          this->time_limit_ * 1e6) {
+        is_out_of_budget = true;
+        break;
+      }
+      ++this->num_iterations_;
+      TestCase &test = tests[rows[boost::random::uniform_int_distribution<std::size_t>(0, rows.size() - 1)(rng)]];
+      std::size_t pid = PID_BOUND;
+      std::size_t vid = VID_BOUND;
+      if (random_real(rng) < 0.5) {
+        // move towards a random uncovered combination
+        std::size_t cid = counter.get_uncovered(
+            boost::random::uniform_int_distribution<std::size_t>(0, counter.get_num_uncovered() - 1)(rng));
+        const RawStrength &raw_strength = targets.get_raw_strength(targets.GetRawStrengthId(cid));
+        targets.GetValues(cid, vids);
+        std::size_t first = boost::random::uniform_int_distribution<std::size_t>(0, raw_strength.size() - 1)(rng);
+        for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+          std::size_t j = (first + i) % raw_strength.size();
+          if (test[raw_strength[j]] != vids[j]) {
+            pid = raw_strength[j];
+            vid = vids[j];
+            break;
+          }
+        }
+      } else {
+        // a random change, possibly to the invalid value
+        pid = pids[boost::random::uniform_int_distribution<std::size_t>(0, pids.size() - 1)(rng)];
+        std::size_t level = model.param_specs_[pid]->get_level();
+        vid = boost::random::uniform_int_distribution<std::size_t>(0, level)(rng);
+      }
+      if (pid == PID_BOUND || vid == test[pid]) {
+        continue;
+      }
+      std::size_t old_vid = test[pid];
+      test[pid] = vid;
+      bool is_valid = checker.IsValid(test, pid);
+      test[pid] = old_vid;
+      if (!is_valid) {
+        continue;
+      }
+      long delta = counter.Evaluate(test, pid, vid);
+      if (delta <= 0 || random_real(rng) < std::exp(-delta / temperature)) {
+        counter.Apply(test, pid, vid);
+      }
+      temperature *= this->cooling_rate_;
+    }
+    if (counter.get_num_uncovered() > 0) {
+      break;
+    }
+    best_tests = tests;
+    ++this->num_removed_;
+  }
+  tests.swap(best_tests);
+}
@@ -0,0 +1,86 @@
+//===----- ct_common/common/annealing_optimizer.h ---------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the simulated annealing optimizer for test suites
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_ANNEALING_OPTIMIZER_H_
+#define CT_COMMON_ANNEALING_OPTIMIZER_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+/**
+ * The simulated annealing optimizer shrinking test suites.
+ * It repeatedly drops the test case covering the fewest combinations alone,
+ * then anneals single cells of the remaining ones until every combination
+ * covered by the original suite is covered again, or the budget runs out.
+ * The coverage multiplicities are updated incrementally on every cell change,
+ * visiting only the raw strengths involving the cell, and only the
+ * constraints touching the cell are evaluated. Test cases matching
+ * non-starter seeds are kept unchanged.
+ */
+class DLL_EXPORT AnnealingOptimizer {
+public:
+  AnnealingOptimizer(void);
+  AnnealingOptimizer(const AnnealingOptimizer &from);
+  AnnealingOptimizer &operator = (const AnnealingOptimizer &right);
+  ~AnnealingOptimizer(void);
+
+  /**
+   * Shrink a suite of complete test cases of the model, keeping every
+   * combination of the strengths it covers. The suite is replaced by the
+   * smallest one found.
+   */
+  void Optimize(const SUTModel &model, std::vector<TestCase> &tests);
+
+  /** Set the maximum number of cell changes tried, 0 for no limit */
+  void set_max_iterations(std::size_t max_iterations) { this->max_iterations_ = max_iterations; }
+  /** Get the maximum number of cell changes tried, 0 for no limit */
+  std::size_t get_max_iterations(void) const { return this->max_iterations_; }
+  /** Set the wall-clock budget in seconds, 0 for no limit */
+  void set_time_limit(double time_limit) { this->time_limit_ = time_limit; }
+  /** Get the wall-clock budget in seconds, 0 for no limit */
+  double get_time_limit(void) const { return this->time_limit_; }
+  /** Set the temperature at the start of each shrinking step */
+  void set_initial_temperature(double temperature) { this->initial_temperature_ = temperature; }
+  /** Get the temperature at the start of each shrinking step */
+  double get_initial_temperature(void) const { return this->initial_temperature_; }
+  /** Set the factor applied to the temperature after each iteration */
+  void set_cooling_rate(double cooling_rate) { this->cooling_rate_ = cooling_rate; }
+  /** Get the factor applied to the temperature after each iteration */
+  double get_cooling_rate(void) const { return this->cooling_rate_; }
+  /** Set the random seed */
+  void set_random_seed(unsigned int random_seed) { this->random_seed_ = random_seed; }
+  /** Get the random seed */
+  unsigned int get_random_seed(void) const { return this->random_seed_; }
+
+  /** Get the number of iterations of the last optimization */
+  std::size_t get_num_iterations(void) const { return this->num_iterations_; }
+  /** Get the number of test cases removed by the last optimization */
+  std::size_t get_num_removed(void) const { return this->num_removed_; }
+
+private:
+  std::size_t max_iterations_;  /**< The maximum number of iterations */
+  double time_limit_;  /**< The wall-clock budget in seconds */
+  double initial_temperature_;  /**< The initial temperature */
+  double cooling_rate_;  /**< The cooling rate */
+  unsigned int random_seed_;  /**< The random seed */
+  std::size_t num_iterations_;  /**< The number of iterations of the last optimization */
+  std::size_t num_removed_;  /**< The number of removed test cases of the last optimization */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_ANNEALING_OPTIMIZER_H_
@@ -0,0 +1,160 @@
+//===----- ct_common/common/concurrent_coverage_map.cpp ---------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class ConcurrentCoverageMap
+//
+//===----------------------------------------------------------------------===//
+
+#include <ct_common/common/concurrent_coverage_map.h>
+
+using namespace ct::common;
+
+ConcurrentCoverageMap::ConcurrentCoverageMap(void)
+    : layout_(0), word_offsets_(1, 0) {
+}
+
+ConcurrentCoverageMap::ConcurrentCoverageMap(const CoverageMap &coverage)
+    : layout_(0), word_offsets_(1, 0) {
+  this->Init(coverage);
+}
+
+ConcurrentCoverageMap::ConcurrentCoverageMap(const ConcurrentCoverageMap &from)
+    : layout_(0), word_offsets_(1, 0) {
+  *this = from;
+}
+
+ConcurrentCoverageMap &ConcurrentCoverageMap::operator = (const ConcurrentCoverageMap &right) {
+  if (this == &right) {
+    return *this;
+  }
+  this->layout_ = right.layout_;
+  this->Allocate();
+  for (std::size_t i = 0; i < this->word_offsets_.back(); ++i) {
+    this->words_[i].store(right.words_[i].load(boost::memory_order_relaxed), boost::memory_order_relaxed);
+  }
+  for (std::size_t i = 0; i + 1 < this->word_offsets_.size(); ++i) {
+    this->counters_[i].value_.store(right.GetNumCovered(i), boost::memory_order_relaxed);
+  }
+  return *this;
+}
+
+ConcurrentCoverageMap::~ConcurrentCoverageMap(void) {
+}
+
+void ConcurrentCoverageMap::Allocate(void) {
+  this->word_offsets_.assign(1, 0);
+  if (this->layout_) {
+    for (std::size_t i = 0; i < this->layout_->get_num_raw_strengths(); ++i) {
+      std::size_t num_combinations = this->layout_->get_offset(i + 1) - this->layout_->get_offset(i);
+      this->word_offsets_.push_back(this->word_offsets_.back() + (num_combinations + 63) / 64);
+    }
+  }
+  this->words_.reset(new boost::atomic<boost::uint64_t>[this->word_offsets_.back()]);
+  this->counters_.reset(new Counter[this->word_offsets_.size() - 1]);
+  this->Reset();
+}
+
+void ConcurrentCoverageMap::Init(const CoverageMap &coverage) {
+  this->layout_ = &coverage;
+  this->Allocate();
+  for (std::size_t cid = 0; cid < coverage.get_num_combinations(); ++cid) {
+    if (coverage.IsCovered(cid)) {
+      this->Cover(cid);
+    }
+  }
+}
+
+void ConcurrentCoverageMap::Reset(void) {
+  for (std::size_t i = 0; i < this->word_offsets_.back(); ++i) {
+    this->words_[i].store(0, boost::memory_order_relaxed);
+  }
+  for (std::size_t i = 0; i + 1 < this->word_offsets_.size(); ++i) {
+    this->counters_[i].value_.store(0, boost::memory_order_relaxed);
+  }
+}
+
+void ConcurrentCoverageMap::Store(CoverageMap &coverage) const {
+  if (coverage.get_num_combinations() != this->get_num_combinations() ||
+      coverage.get_num_raw_strengths() + 1 != this->word_offsets_.size()) {
+    CT_EXCEPTION("the coverage map has a different layout");
+  }
+  coverage.Reset();
+  for (std::size_t sid = 0; sid + 1 < this->word_offsets_.size(); ++sid) {
+    std::size_t offset = coverage.get_offset(sid);
+    for (std::size_t i = this->word_offsets_[sid]; i < this->word_offsets_[sid + 1]; ++i) {
+      boost::uint64_t word = this->words_[i].load(boost::memory_order_relaxed);
+      std::size_t local_id = (i - this->word_offsets_[sid]) * 64;
+      for (; word != 0; word >>= 1, ++local_id) {
+        if (word & 1) {
+          coverage.Cover(offset + local_id);
+        }
+      }
+    }
+  }
+}
+
+std::size_t ConcurrentCoverageMap::GetNumCovered(void) const {
+  std::size_t tmp_return = 0;
+  for (std::size_t i = 0; i + 1 < this->word_offsets_.size(); ++i) {
+    tmp_return += this->GetNumCovered(i);
+  }
+  return tmp_return;
+}
+
+bool ConcurrentCoverageMap::IsCovered(std::size_t cid) const {
+  std::size_t sid = this->layout_->GetRawStrengthId(cid);
+  std::size_t local_id = cid - this->layout_->get_offset(sid);
+  boost::uint64_t word = this->words_[this->word_offsets_[sid] + (local_id >> 6)].load(boost::memory_order_relaxed);
+  return (word >> (local_id & 63)) & 1;
+}
+
+bool ConcurrentCoverageMap::CoverLocal(std::size_t sid, std::size_t local_id) {
+  boost::atomic<boost::uint64_t> &word = this->words_[this->word_offsets_[sid] + (local_id >> 6)];
+  boost::uint64_t mask = boost::uint64_t(1) << (local_id & 63);
+  // a plain load first saves the locked operation on words already covered
+  if (word.load(boost::memory_order_relaxed) & mask) {
+    return false;
+  }
+  if (word.fetch_or(mask, boost::memory_order_relaxed) & mask) {
+    return false;
+  }
+  this->counters_[sid].value_.fetch_add(1, boost::memory_order_relaxed);
+  return true;
+}
+
+bool ConcurrentCoverageMap::Cover(std::size_t cid) {
+  std::size_t sid = this->layout_->GetRawStrengthId(cid);
+  return this->CoverLocal(sid, cid - this->layout_->get_offset(sid));
+}
+
+std::size_t ConcurrentCoverageMap::CountUncovered(const TestCase &test) const {
+  std::size_t tmp_return = 0;
+  for (std::size_t i = 0; i + 1 < this->word_offsets_.size(); ++i) {
+    std::size_t cid = this->layout_->GetCombinationId(i, test);
+    if (cid == CID_BOUND) {
+      continue;
+    }
+    std::size_t local_id = cid - this->layout_->get_offset(i);
+    boost::uint64_t word = this->words_[this->word_offsets_[i] + (local_id >> 6)].load(boost::memory_order_relaxed);
+    if (!((word >> (local_id & 63)) & 1)) {
+      ++tmp_return;
+    }
+  }
+  return tmp_return;
+}
+
+std::size_t ConcurrentCoverageMap::Cover(const TestCase &test) {
+  std::size_t tmp_return = 0;
+  for (std::size_t i = 0; i + 1 < this->word_offsets_.size(); ++i) {
+    std::size_t cid = this->layout_->GetCombinationId(i, test);
+    if (cid != CID_BOUND && this->CoverLocal(i, cid - this->layout_->get_offset(i))) {
+      ++tmp_return;
+    }
+  }
+  return tmp_return;
+}
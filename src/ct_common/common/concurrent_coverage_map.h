@@ -0,0 +1,100 @@
+//===----- ct_common/common/concurrent_coverage_map.h -----------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for tracking the coverage of target
+// combinations from several threads
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_CONCURRENT_COVERAGE_MAP_H_
+#define CT_COMMON_CONCURRENT_COVERAGE_MAP_H_
+
+#include <vector>
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/scoped_array.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for tracking the coverage of target combinations from several
+ * threads without locks. The combinations are numbered as in a CoverageMap,
+ * which gives the layout, but the bitmap of each raw strength starts at a
+ * word of its own, and the words are marked with atomic fetch_or, so that
+ * exactly one thread sees a combination become covered. The numbers of
+ * covered combinations are kept per raw strength in counters on separate
+ * cache lines. The layout is weak and becomes invalid when the CoverageMap
+ * is destroyed.
+ */
+class DLL_EXPORT ConcurrentCoverageMap {
+public:
+  ConcurrentCoverageMap(void);
+  /** Make a map with the layout and the covered combinations of a CoverageMap */
+  explicit ConcurrentCoverageMap(const CoverageMap &coverage);
+  ConcurrentCoverageMap(const ConcurrentCoverageMap &from);
+  ConcurrentCoverageMap &operator = (const ConcurrentCoverageMap &right);
+  ~ConcurrentCoverageMap(void);
+
+  /** Take the layout and the covered combinations of a CoverageMap, not thread-safe */
+  void Init(const CoverageMap &coverage);
+  /** Mark all combinations uncovered, not thread-safe */
+  void Reset(void);
+  /** Copy the covered combinations into a CoverageMap of the same layout, not thread-safe */
+  void Store(CoverageMap &coverage) const;
+
+  /** Get the CoverageMap giving the layout, 0 if there is none */
+  const CoverageMap *get_layout(void) const { return this->layout_; }
+  /** Get the number of target combinations */
+  std::size_t get_num_combinations(void) const {
+    return this->layout_ ? this->layout_->get_num_combinations() : 0;
+  }
+  /**
+   * Get the number of covered combinations. While other threads mark
+   * combinations, the counters are read one by one with relaxed ordering,
+   * so the result is a snapshot lying between the numbers before and after
+   * the concurrent calls; it is exact once they have finished.
+   */
+  std::size_t GetNumCovered(void) const;
+  /** Get the number of covered combinations of a raw strength, a relaxed snapshot */
+  std::size_t GetNumCovered(std::size_t sid) const {
+    return this->counters_[sid].value_.load(boost::memory_order_relaxed);
+  }
+
+  /** Whether a combination is covered */
+  bool IsCovered(std::size_t cid) const;
+  /** Mark a combination covered, returns whether this call covered it */
+  bool Cover(std::size_t cid);
+  /** Count the combinations a test case would newly cover */
+  std::size_t CountUncovered(const TestCase &test) const;
+  /** Mark the combinations of a test case covered, returns the number this call covered */
+  std::size_t Cover(const TestCase &test);
+
+private:
+  /** A counter alone on its cache line */
+  struct Counter {
+    boost::atomic<std::size_t> value_;
+    char padding_[64 - sizeof(boost::atomic<std::size_t>)];
+  };
+
+  /** Mark a combination of a raw strength covered by its local id */
+  bool CoverLocal(std::size_t sid, std::size_t local_id);
+  /** Allocate the words and the counters for the layout */
+  void Allocate(void);
+
+  const CoverageMap *layout_;  /**< The CoverageMap giving the layout */
+  std::vector<std::size_t> word_offsets_;  /**< The first words of the raw strengths, with the total number in the back */
+  boost::scoped_array<boost::atomic<boost::uint64_t> > words_;  /**< The coverage bitmap */
+  boost::scoped_array<Counter> counters_;  /**< The numbers of covered combinations of the raw strengths */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_CONCURRENT_COVERAGE_MAP_H_
@@ -45,17 +45,17 @@ std::string Constraint_A_Binary::class_name(void) {
 EvalType_Bool Constraint_A_Binary::Evaluate( const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                 const Assignment &assignment) const {
   EvalType_Bool tmp_return;
-  if (this->get_loprd()->get_type() == EAT_INT &&
-      this->get_roprd()->get_type() == EAT_INT) {
-    GET_EXP_VAL(EvalType_Int, val_l, this->get_loprd(), param_specs, assignment);
-    GET_EXP_VAL(EvalType_Int, val_r, this->get_roprd(), param_specs, assignment);
+  if (this->get_loprd_ptr()->get_type() == EAT_INT &&
+      this->get_roprd_ptr()->get_type() == EAT_INT) {
+    GET_EXP_VAL(EvalType_Int, val_l, this->get_loprd_ptr(), param_specs, assignment);
+    GET_EXP_VAL(EvalType_Int, val_r, this->get_roprd_ptr(), param_specs, assignment);
     tmp_return.is_valid_ = val_l.is_valid_ && val_r.is_valid_;
     if (tmp_return.is_valid_) {
       tmp_return.value_ = this->evaluate_func_int(val_l.value_, val_r.value_);
     }
   } else {
-    GET_EXP_VAL(EvalType_Int, val_l, this->get_loprd(), param_specs, assignment);
-    GET_EXP_VAL(EvalType_Int, val_r, this->get_roprd(), param_specs, assignment);
+    GET_EXP_VAL(EvalType_Int, val_l, this->get_loprd_ptr(), param_specs, assignment);
+    GET_EXP_VAL(EvalType_Int, val_r, this->get_roprd_ptr(), param_specs, assignment);
     tmp_return.is_valid_ = val_l.is_valid_ && val_r.is_valid_;
     if (tmp_return.is_valid_) {
       tmp_return.value_ = this->evaluate_func_int(val_l.value_, val_r.value_);
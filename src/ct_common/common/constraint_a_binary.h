@@ -38,6 +38,9 @@ public:
 
   boost::shared_ptr<const Exp_A> get_loprd(void) const { return boost::dynamic_pointer_cast<Exp_A>(this->oprds_[0]); }
   boost::shared_ptr<const Exp_A> get_roprd(void) const { return boost::dynamic_pointer_cast<Exp_A>(this->oprds_[1]); }
+  /** Get the operands without sharing the ownership, for the evaluation, 0 if not arithmetic expressions */
+  const Exp_A *get_loprd_ptr(void) const { return dynamic_cast<const Exp_A *>(this->oprds_[0].get()); }
+  const Exp_A *get_roprd_ptr(void) const { return dynamic_cast<const Exp_A *>(this->oprds_[1].get()); }
 
   void set_loprd(const boost::shared_ptr<TreeNode> &loprd) { this->oprds_[0] = loprd; }
   void set_roprd(const boost::shared_ptr<TreeNode> &roprd) { this->oprds_[1] = roprd; }
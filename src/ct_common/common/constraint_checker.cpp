@@ -0,0 +1,331 @@
+//===----- ct_common/common/constraint_checker.cpp --------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class ConstraintChecker
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+#include <ct_common/common/constraint_checker.h>
+
+using namespace ct::common;
+
+namespace {
+std::size_t find_root(std::vector<std::size_t> &parents, std::size_t pid) {
+  while (parents[pid] != pid) {
+    parents[pid] = parents[parents[pid]];
+    pid = parents[pid];
+  }
+  return pid;
+}
+}  // namespace
+
+/**
+ * The state of a search over the unassigned cells of a component.
+ * Forward checking: once a constraint is left with a single unassigned cell,
+ * the values of that cell it rejects are pruned, and restored on backtracking,
+ * so dead ends show up as empty domains before the cells between are tried.
+ * Failure cache: whether search(depth) succeeds only depends on the cells
+ * touched by the constraints of pids[depth:], so once it fails, it fails again
+ * whenever these cells take the same values.
+ */
+struct ConstraintChecker::SearchState {
+  std::vector<std::vector<bool> > domains_;  /**< The alive values of the cells, by position in the component */
+  std::vector<std::pair<std::size_t, std::size_t> > pruned_;  /**< The pruned pids and vids, to restore */
+  std::vector<std::vector<std::size_t> > frontiers_;  /**< The cells the failures depend on, by depth */
+  std::vector<std::set<std::vector<std::size_t> > > failures_;  /**< The values of the failed frontiers, by depth */
+};
+
+ConstraintChecker::ConstraintChecker(void) {
+}
+
+ConstraintChecker::ConstraintChecker(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                                     const std::vector<boost::shared_ptr<Constraint> > &constraints) {
+  this->Init(param_specs, constraints);
+}
+
+ConstraintChecker::ConstraintChecker(const ConstraintChecker &from)
+    : param_specs_(from.param_specs_), constraints_(from.constraints_),
+      rel_pids_(from.rel_pids_), param_constraints_(from.param_constraints_),
+      component_ids_(from.component_ids_), components_(from.components_), positions_(from.positions_) {
+}
+
+ConstraintChecker &ConstraintChecker::operator = (const ConstraintChecker &right) {
+  this->param_specs_ = right.param_specs_;
+  this->constraints_ = right.constraints_;
+  this->rel_pids_ = right.rel_pids_;
+  this->param_constraints_ = right.param_constraints_;
+  this->component_ids_ = right.component_ids_;
+  this->components_ = right.components_;
+  this->positions_ = right.positions_;
+  return *this;
+}
+
+ConstraintChecker::~ConstraintChecker(void) {
+}
+
+void ConstraintChecker::Init(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                             const std::vector<boost::shared_ptr<Constraint> > &constraints) {
+  this->param_specs_ = param_specs;
+  this->constraints_ = constraints;
+  this->rel_pids_.assign(constraints.size(), std::vector<std::size_t>());
+  this->param_constraints_.assign(param_specs.size(), std::vector<std::size_t>());
+  std::vector<std::size_t> parents(param_specs.size());
+  for (std::size_t i = 0; i < parents.size(); ++i) {
+    parents[i] = i;
+  }
+  for (std::size_t i = 0; i < constraints.size(); ++i) {
+    if (!constraints[i]) {
+      CT_EXCEPTION("encountered invalid constraint");
+    }
+    std::set<std::size_t> rel_pids;
+    constraints[i]->touch_pids(param_specs, rel_pids);
+    this->rel_pids_[i].assign(rel_pids.begin(), rel_pids.end());
+    for (std::size_t j = 0; j < this->rel_pids_[i].size(); ++j) {
+      std::size_t pid = this->rel_pids_[i][j];
+      this->param_constraints_[pid].push_back(i);
+      parents[find_root(parents, pid)] = find_root(parents, this->rel_pids_[i][0]);
+    }
+  }
+  // number the components, leaving out auto parameters which are never assigned
+  this->component_ids_.assign(param_specs.size(), 0);
+  this->components_.clear();
+  this->positions_.assign(param_specs.size(), 0);
+  std::vector<std::size_t> root_component_ids(param_specs.size(), PID_BOUND);
+  for (std::size_t i = 0; i < param_specs.size(); ++i) {
+    std::size_t root = find_root(parents, i);
+    if (root_component_ids[root] == PID_BOUND) {
+      root_component_ids[root] = this->components_.size();
+      this->components_.push_back(std::vector<std::size_t>());
+    }
+    this->component_ids_[i] = root_component_ids[root];
+    if (!param_specs[i]->is_auto()) {
+      this->positions_[i] = this->components_[root_component_ids[root]].size();
+      this->components_[root_component_ids[root]].push_back(i);
+    }
+  }
+}
+
+bool ConstraintChecker::check(std::size_t cid, const TestCase &test) const {
+  const std::vector<std::size_t> &rel_pids = this->rel_pids_[cid];
+  for (std::size_t i = 0; i < rel_pids.size(); ++i) {
+    if (test[rel_pids[i]] == VID_BOUND) {
+      return true;
+    }
+  }
+  EvalType_Bool result = this->constraints_[cid]->Evaluate(this->param_specs_, test);
+  return result.is_valid_ && result.value_;
+}
+
+bool ConstraintChecker::IsValid(const TestCase &test) const {
+  for (std::size_t i = 0; i < this->constraints_.size(); ++i) {
+    if (!this->check(i, test)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool ConstraintChecker::IsValid(const TestCase &test, std::size_t pid) const {
+  const std::vector<std::size_t> &param_constraints = this->param_constraints_[pid];
+  for (std::size_t i = 0; i < param_constraints.size(); ++i) {
+    if (!this->check(param_constraints[i], test)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ConstraintChecker::get_frontier(const std::vector<std::size_t> &pids, std::size_t depth,
+                                     std::vector<std::size_t> &frontier) const {
+  std::set<std::size_t> rest(pids.begin() + depth, pids.end());
+  std::set<std::size_t> cells;
+  for (std::size_t i = depth; i < pids.size(); ++i) {
+    const std::vector<std::size_t> &param_constraints = this->param_constraints_[pids[i]];
+    for (std::size_t j = 0; j < param_constraints.size(); ++j) {
+      const std::vector<std::size_t> &rel_pids = this->rel_pids_[param_constraints[j]];
+      for (std::size_t k = 0; k < rel_pids.size(); ++k) {
+        if (rest.find(rel_pids[k]) == rest.end()) {
+          cells.insert(rel_pids[k]);
+        }
+      }
+    }
+  }
+  frontier.assign(cells.begin(), cells.end());
+}
+
+bool ConstraintChecker::revise(std::size_t cid, TestCase &test, SearchState &state) const {
+  const std::vector<std::size_t> &rel_pids = this->rel_pids_[cid];
+  std::size_t pid = PID_BOUND;
+  for (std::size_t i = 0; i < rel_pids.size(); ++i) {
+    if (test[rel_pids[i]] == VID_BOUND) {
+      if (pid != PID_BOUND) {
+        return true;
+      }
+      pid = rel_pids[i];
+    }
+  }
+  if (pid == PID_BOUND) {
+    return true;
+  }
+  std::vector<bool> &domain = state.domains_[this->positions_[pid]];
+  bool tmp_return = false;
+  for (std::size_t vid = 0; vid < domain.size(); ++vid) {
+    if (!domain[vid]) {
+      continue;
+    }
+    test[pid] = vid;
+    EvalType_Bool result = this->constraints_[cid]->Evaluate(this->param_specs_, test);
+    if (result.is_valid_ && result.value_) {
+      tmp_return = true;
+    } else {
+      domain[vid] = false;
+      state.pruned_.push_back(std::pair<std::size_t, std::size_t>(pid, vid));
+    }
+  }
+  test[pid] = VID_BOUND;
+  return tmp_return;
+}
+
+bool ConstraintChecker::prepare(TestCase &test, const std::vector<std::size_t> &pids, SearchState &state) const {
+  state.domains_.resize(this->components_[this->component_ids_[pids[0]]].size());
+  for (std::size_t i = 0; i < pids.size(); ++i) {
+    state.domains_[this->positions_[pids[i]]].assign(this->param_specs_[pids[i]]->get_level() + 1, true);
+  }
+  for (std::size_t i = 0; i < pids.size(); ++i) {
+    const std::vector<std::size_t> &param_constraints = this->param_constraints_[pids[i]];
+    for (std::size_t j = 0; j < param_constraints.size(); ++j) {
+      if (!this->revise(param_constraints[j], test, state)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+bool ConstraintChecker::search(TestCase &test, const std::vector<std::size_t> &pids, std::size_t depth,
+                               SearchState &state) const {
+  while (depth < pids.size() && test[pids[depth]] != VID_BOUND) {
+    ++depth;
+  }
+  if (depth >= pids.size()) {
+    return true;
+  }
+  // the frontier is only computed once the depth has failed
+  std::vector<std::size_t> key;
+  if (depth < state.failures_.size() && !state.failures_[depth].empty()) {
+    const std::vector<std::size_t> &frontier = state.frontiers_[depth];
+    for (std::size_t i = 0; i < frontier.size(); ++i) {
+      key.push_back(test[frontier[i]]);
+    }
+    if (state.failures_[depth].find(key) != state.failures_[depth].end()) {
+      return false;
+    }
+  }
+  std::size_t pid = pids[depth];
+  const std::vector<std::size_t> &param_constraints = this->param_constraints_[pid];
+  // the values left are consistent with the assigned cells, the invalid value is tried last
+  const std::vector<bool> &domain = state.domains_[this->positions_[pid]];
+  for (std::size_t vid = 0; vid < domain.size(); ++vid) {
+    if (!domain[vid]) {
+      continue;
+    }
+    test[pid] = vid;
+    std::size_t num_pruned = state.pruned_.size();
+    bool is_consistent = true;
+    for (std::size_t i = 0; i < param_constraints.size() && is_consistent; ++i) {
+      is_consistent = this->revise(param_constraints[i], test, state);
+    }
+    if (is_consistent && this->search(test, pids, depth + 1, state)) {
+      return true;
+    }
+    for (std::size_t i = state.pruned_.size(); i-- > num_pruned;) {
+      state.domains_[this->positions_[state.pruned_[i].first]][state.pruned_[i].second] = true;
+    }
+    state.pruned_.resize(num_pruned);
+  }
+  test[pid] = VID_BOUND;
+  if (depth >= state.failures_.size()) {
+    state.frontiers_.resize(pids.size());
+    state.failures_.resize(pids.size());
+  }
+  if (state.failures_[depth].empty()) {
+    this->get_frontier(pids, depth, state.frontiers_[depth]);
+    key.clear();
+    for (std::size_t i = 0; i < state.frontiers_[depth].size(); ++i) {
+      key.push_back(test[state.frontiers_[depth][i]]);
+    }
+  }
+  state.failures_[depth].insert(key);
+  return false;
+}
+
+bool ConstraintChecker::IsExtendable(TestCase &test, std::size_t pid) const {
+  if (!this->IsValid(test, pid)) {
+    return false;
+  }
+  if (this->param_constraints_[pid].empty()) {
+    return true;
+  }
+  const std::vector<std::size_t> &component = this->get_component(pid);
+  std::vector<std::size_t> unassigned_pids;
+  for (std::size_t i = 0; i < component.size(); ++i) {
+    if (test[component[i]] == VID_BOUND) {
+      unassigned_pids.push_back(component[i]);
+    }
+  }
+  if (unassigned_pids.empty()) {
+    return true;
+  }
+  SearchState state;
+  bool tmp_return = this->prepare(test, unassigned_pids, state) && this->search(test, unassigned_pids, 0, state);
+  for (std::size_t i = 0; i < unassigned_pids.size(); ++i) {
+    test[unassigned_pids[i]] = VID_BOUND;
+  }
+  return tmp_return;
+}
+
+bool ConstraintChecker::Complete(TestCase &test) const {
+  bool tmp_return = true;
+  for (std::size_t i = 0; i < this->param_specs_.size(); ++i) {
+    if (this->param_specs_[i]->is_auto()) {
+      test[i] = this->param_specs_[i]->get_invalid_vid();
+    }
+  }
+  for (std::size_t i = 0; i < this->components_.size(); ++i) {
+    const std::vector<std::size_t> &component = this->components_[i];
+    std::vector<std::size_t> unassigned_pids;
+    for (std::size_t j = 0; j < component.size(); ++j) {
+      if (test[component[j]] == VID_BOUND) {
+        unassigned_pids.push_back(component[j]);
+      }
+    }
+    if (unassigned_pids.empty()) {
+      continue;
+    }
+    SearchState state;
+    if (!this->prepare(test, unassigned_pids, state) || !this->search(test, unassigned_pids, 0, state)) {
+      for (std::size_t j = 0; j < unassigned_pids.size(); ++j) {
+        test[unassigned_pids[j]] = VID_BOUND;
+      }
+      tmp_return = false;
+    }
+  }
+  return tmp_return;
+}
+
+TestCase ConstraintChecker::MakeEmptyTest(void) const {
+  TestCase tmp_return;
+  tmp_return.assign(this->param_specs_.size(), VID_BOUND);
+  for (std::size_t i = 0; i < this->param_specs_.size(); ++i) {
+    if (this->param_specs_[i]->is_auto()) {
+      tmp_return[i] = this->param_specs_[i]->get_invalid_vid();
+    }
+  }
+  return tmp_return;
+}
@@ -0,0 +1,105 @@
+//===----- ct_common/common/constraint_checker.h ----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for checking constraints on partially
+// assigned test cases
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_CONSTRAINT_CHECKER_H_
+#define CT_COMMON_CONSTRAINT_CHECKER_H_
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/paramspec.h>
+#include <ct_common/common/constraint.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for checking constraints on partially assigned test cases.
+ * A test case has a cell for each parameter, unassigned cells hold VID_BOUND;
+ * assigned cells may also hold the invalid vid of their parameters.
+ * A constraint is checked once all the parameters it touches (see
+ * TreeNode::touch_pids) are assigned, and is satisfied if it evaluates to a
+ * valid true. Parameters linked by constraints form components, which are
+ * solved independently when unassigned cells are filled.
+ * Auto parameters are never assigned by the checker, their cells are filled
+ * with their invalid vids.
+ */
+class DLL_EXPORT ConstraintChecker {
+public:
+  ConstraintChecker(void);
+  ConstraintChecker(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                    const std::vector<boost::shared_ptr<Constraint> > &constraints);
+  ConstraintChecker(const ConstraintChecker &from);
+  ConstraintChecker &operator = (const ConstraintChecker &right);
+  ~ConstraintChecker(void);
+
+  /** Initialize the checker, computing the related parameters of the constraints */
+  void Init(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+            const std::vector<boost::shared_ptr<Constraint> > &constraints);
+
+  /** Get the number of parameters */
+  std::size_t get_num_params(void) const { return this->param_specs_.size(); }
+  /** Get the related pids of a constraint, sorted */
+  const std::vector<std::size_t> &get_rel_pids(std::size_t cid) const { return this->rel_pids_[cid]; }
+  /** Get the ids of the constraints touching a parameter */
+  const std::vector<std::size_t> &get_param_constraints(std::size_t pid) const { return this->param_constraints_[pid]; }
+  /** Get the parameters in the same component with a parameter (including itself) */
+  const std::vector<std::size_t> &get_component(std::size_t pid) const { return this->components_[this->component_ids_[pid]]; }
+
+  /** Whether all constraints with their parameters assigned are satisfied */
+  bool IsValid(const TestCase &test) const;
+  /** Whether the constraints touching pid with their parameters assigned are satisfied */
+  bool IsValid(const TestCase &test, std::size_t pid) const;
+  /**
+   * Whether the unassigned cells in the component of pid can be assigned with
+   * all constraints of the component satisfied. The test is restored before returning.
+   */
+  bool IsExtendable(TestCase &test, std::size_t pid) const;
+  /**
+   * Assign all unassigned cells with all constraints satisfied, valid values
+   * are preferred. Returns false if impossible, in which case the cells of the
+   * failed components are left unassigned.
+   */
+  bool Complete(TestCase &test) const;
+  /** Make a test case with all cells unassigned, except those of auto parameters */
+  TestCase MakeEmptyTest(void) const;
+
+private:
+  /** The pruned domains and the failed subproblems of a search */
+  struct SearchState;
+
+  /** Whether a constraint is satisfied, or not fully assigned yet */
+  bool check(std::size_t cid, const TestCase &test) const;
+  /** Prune the values of the last unassigned cell of a constraint, false if none is left */
+  bool revise(std::size_t cid, TestCase &test, SearchState &state) const;
+  /** Set up the domains of the unassigned cells pids of a component, false if some is empty */
+  bool prepare(TestCase &test, const std::vector<std::size_t> &pids, SearchState &state) const;
+  /** Assign the unassigned cells among pids[depth:] by forward checking, skipping the cached failures */
+  bool search(TestCase &test, const std::vector<std::size_t> &pids, std::size_t depth, SearchState &state) const;
+  /** Get the cells outside pids[depth:] touched by the constraints of pids[depth:], sorted */
+  void get_frontier(const std::vector<std::size_t> &pids, std::size_t depth,
+                    std::vector<std::size_t> &frontier) const;
+
+private:
+  std::vector<boost::shared_ptr<ParamSpec> > param_specs_;  /**< The parameter specifications */
+  std::vector<boost::shared_ptr<Constraint> > constraints_;  /**< The constraints */
+  std::vector<std::vector<std::size_t> > rel_pids_;  /**< The related pids of each constraint */
+  std::vector<std::vector<std::size_t> > param_constraints_;  /**< The constraints touching each parameter */
+  std::vector<std::size_t> component_ids_;  /**< The component of each parameter */
+  std::vector<std::vector<std::size_t> > components_;  /**< The parameters of each component */
+  std::vector<std::size_t> positions_;  /**< The position of each parameter in its component */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_CONSTRAINT_CHECKER_H_
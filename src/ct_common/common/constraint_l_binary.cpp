@@ -43,8 +43,8 @@ std::string Constraint_L_Binary::class_name(void) {
 EvalType_Bool Constraint_L_Binary::Evaluate( const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                     const Assignment &assignment) const {
   EvalType_Bool l_val, r_val;
-  l_val = this->get_loprd()->Evaluate(param_specs, assignment);
-  r_val = this->get_roprd()->Evaluate(param_specs, assignment);
+  l_val = this->get_loprd_ptr()->Evaluate(param_specs, assignment);
+  r_val = this->get_roprd_ptr()->Evaluate(param_specs, assignment);
   return this->evaluate_func(l_val, r_val);
 }
 
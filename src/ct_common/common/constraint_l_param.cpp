@@ -42,21 +42,21 @@ std::string Constraint_L_Param::class_name(void) {
 
 EvalType_Bool Constraint_L_Param::Evaluate(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                   const Assignment &assignment) const {
-  boost::shared_ptr<ParamSpec_Bool> ptr = boost::dynamic_pointer_cast<ParamSpec_Bool>(param_specs[this->pid_]);
-  if (!ptr.get()) {
+  const ParamSpec_Bool *ptr = dynamic_cast<const ParamSpec_Bool *>(param_specs[this->pid_].get());
+  if (ptr == 0) {
     CT_EXCEPTION("Error: evaluating a boolean value from a non-boolean parameter!");
     return EvalType_Bool(false, false);
   }
   // FIXME: need to reconsider the logic here
   if (ptr->is_auto()) {
     for (std::size_t i = 0; i < ptr->get_auto_value_specs().size(); ++i) {
-      boost::shared_ptr<Constraint> cond = boost::dynamic_pointer_cast<Constraint>(ptr->auto_value_specs()[i].first);
+      const Constraint *cond = dynamic_cast<const Constraint *>(ptr->get_auto_value_specs()[i].first.get());
       if (cond) {
         EvalType_Bool cond_value;
         cond_value = cond->Evaluate(param_specs, assignment);
         if (cond_value.is_valid_ && cond_value.value_) {
           // condition met, taking the value
-          boost::shared_ptr<Constraint> val_exp = boost::dynamic_pointer_cast<Constraint>(ptr->auto_value_specs()[i].second);
+          const Constraint *val_exp = dynamic_cast<const Constraint *>(ptr->get_auto_value_specs()[i].second.get());
           if (val_exp) {
             return val_exp->Evaluate(param_specs, assignment);
           } else {
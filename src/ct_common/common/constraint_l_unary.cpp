@@ -41,7 +41,7 @@ std::string Constraint_L_Unary::class_name(void) {
 
 EvalType_Bool Constraint_L_Unary::Evaluate(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                   const Assignment &assignment) const {
-  EvalType_Bool tmp_return = this->get_oprd()->Evaluate(param_specs, assignment);
+  EvalType_Bool tmp_return = this->get_oprd_ptr()->Evaluate(param_specs, assignment);
   tmp_return.value_ = this->evaluate_func(tmp_return.value_);
   return tmp_return;
 }
@@ -45,8 +45,8 @@ std::string Constraint_S_Binary::class_name(void) {
 EvalType_Bool Constraint_S_Binary::Evaluate( const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                 const Assignment &assignment) const {
   EvalType_Bool tmp_return;
-  EvalType_String val_l = this->get_loprd()->Evaluate(param_specs, assignment);
-  EvalType_String val_r = this->get_roprd()->Evaluate(param_specs, assignment);
+  EvalType_String val_l = this->get_loprd_ptr()->Evaluate(param_specs, assignment);
+  EvalType_String val_r = this->get_roprd_ptr()->Evaluate(param_specs, assignment);
   tmp_return.is_valid_ = val_l.is_valid_ && val_r.is_valid_;
   if (tmp_return.is_valid_) {
     tmp_return.value_ = this->evaluate_func(val_l.value_, val_r.value_);
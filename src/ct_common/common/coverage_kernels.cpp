@@ -0,0 +1,264 @@
+//===----- ct_common/common/coverage_kernels.cpp ----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the vectorized kernels for coverage counting
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <ct_common/common/coverage_kernels.h>
+
+// the vectorized kernels are compiled with per-function target attributes,
+// so that the library runs on any x86 CPU and picks them at run time
+#if (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5)) && (defined(__x86_64__) || defined(__i386__))
+#define CT_COMMON_SIMD_KERNELS
+#include <immintrin.h>
+#define CT_TARGET(x) __attribute__((target(x)))
+#endif
+
+using namespace ct::common;
+
+namespace {
+/** The arguments of the kernels */
+struct KernelArgs {
+  std::size_t num_rows_;
+  std::vector<const void *> cols_;
+  std::vector<std::size_t> strides_;
+  std::vector<boost::uint32_t> limits_;  /**< The largest in-range value ids */
+  std::size_t num_left_;  /**< The number of combinations left unmarked */
+  boost::uint64_t *bits_;
+  std::size_t offset_;
+};
+
+inline bool set_bit(boost::uint64_t *bits, std::size_t id) {
+  boost::uint64_t mask = boost::uint64_t(1) << (id & 63);
+  if (bits[id >> 6] & mask) {
+    return false;
+  }
+  bits[id >> 6] |= mask;
+  return true;
+}
+
+/** Mark the combinations of the rows from first on, one row at a time */
+template <typename T>
+std::size_t cover_scalar(KernelArgs &args, std::size_t first) {
+  std::size_t tmp_return = 0;
+  std::size_t num_cols = args.cols_.size();
+  for (std::size_t r = first; r < args.num_rows_ && args.num_left_ > 0; ++r) {
+    std::size_t id = 0;
+    bool is_in_range = true;
+    for (std::size_t i = 0; i < num_cols; ++i) {
+      std::size_t vid = static_cast<const T *>(args.cols_[i])[r];
+      if (vid > args.limits_[i]) {
+        is_in_range = false;
+        break;
+      }
+      id += vid * args.strides_[i];
+    }
+    if (is_in_range && set_bit(args.bits_, args.offset_ + id)) {
+      ++tmp_return;
+      --args.num_left_;
+    }
+  }
+  return tmp_return;
+}
+
+/** Set the bits of the lanes in the mask */
+inline std::size_t set_lanes(KernelArgs &args, const boost::uint32_t *ids, unsigned mask, std::size_t num_lanes) {
+  std::size_t tmp_return = 0;
+  for (std::size_t l = 0; l < num_lanes; ++l) {
+    if (((mask >> l) & 1) && set_bit(args.bits_, args.offset_ + ids[l])) {
+      ++tmp_return;
+    }
+  }
+  args.num_left_ -= tmp_return;
+  return tmp_return;
+}
+
+#ifdef CT_COMMON_SIMD_KERNELS
+CT_TARGET("sse4.2") inline __m128i load_4(const boost::uint8_t *p) {
+  boost::int32_t x;
+  std::memcpy(&x, p, sizeof(x));
+  return _mm_cvtepu8_epi32(_mm_cvtsi32_si128(x));
+}
+CT_TARGET("sse4.2") inline __m128i load_4(const boost::uint16_t *p) {
+  return _mm_cvtepu16_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+}
+CT_TARGET("sse4.2") inline __m128i load_4(const boost::uint32_t *p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+}
+
+template <typename T>
+CT_TARGET("sse4.2") std::size_t cover_sse42(KernelArgs &args) {
+  std::size_t tmp_return = 0;
+  std::size_t num_cols = args.cols_.size();
+  boost::uint32_t ids[4];
+  std::size_t r = 0;
+  for (; r + 4 <= args.num_rows_ && args.num_left_ > 0; r += 4) {
+    __m128i id = _mm_setzero_si128();
+    __m128i in_range = _mm_set1_epi32(-1);
+    for (std::size_t i = 0; i < num_cols; ++i) {
+      __m128i cell = load_4(static_cast<const T *>(args.cols_[i]) + r);
+      __m128i limit = _mm_set1_epi32(boost::int32_t(args.limits_[i]));
+      in_range = _mm_and_si128(in_range, _mm_cmpeq_epi32(_mm_min_epu32(cell, limit), cell));
+      id = _mm_add_epi32(id, _mm_mullo_epi32(cell, _mm_set1_epi32(boost::int32_t(args.strides_[i]))));
+    }
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(ids), id);
+    tmp_return += set_lanes(args, ids, unsigned(_mm_movemask_ps(_mm_castsi128_ps(in_range))), 4);
+  }
+  return tmp_return + cover_scalar<T>(args, r);
+}
+
+CT_TARGET("avx2") inline __m256i load_8(const boost::uint8_t *p) {
+  return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(p)));
+}
+CT_TARGET("avx2") inline __m256i load_8(const boost::uint16_t *p) {
+  return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+CT_TARGET("avx2") inline __m256i load_8(const boost::uint32_t *p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+}
+
+template <typename T>
+CT_TARGET("avx2") std::size_t cover_avx2(KernelArgs &args) {
+  std::size_t tmp_return = 0;
+  std::size_t num_cols = args.cols_.size();
+  boost::uint32_t ids[8];
+  std::size_t r = 0;
+  for (; r + 8 <= args.num_rows_ && args.num_left_ > 0; r += 8) {
+    __m256i id = _mm256_setzero_si256();
+    __m256i in_range = _mm256_set1_epi32(-1);
+    for (std::size_t i = 0; i < num_cols; ++i) {
+      __m256i cell = load_8(static_cast<const T *>(args.cols_[i]) + r);
+      __m256i limit = _mm256_set1_epi32(boost::int32_t(args.limits_[i]));
+      in_range = _mm256_and_si256(in_range, _mm256_cmpeq_epi32(_mm256_min_epu32(cell, limit), cell));
+      id = _mm256_add_epi32(id, _mm256_mullo_epi32(cell, _mm256_set1_epi32(boost::int32_t(args.strides_[i]))));
+    }
+    _mm256_storeu_si256(reinterpret_cast<__m256i *>(ids), id);
+    tmp_return += set_lanes(args, ids, unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(in_range))), 8);
+  }
+  return tmp_return + cover_scalar<T>(args, r);
+}
+
+CT_TARGET("avx512f") inline __m512i load_16(const boost::uint8_t *p) {
+  return _mm512_cvtepu8_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(p)));
+}
+CT_TARGET("avx512f") inline __m512i load_16(const boost::uint16_t *p) {
+  return _mm512_cvtepu16_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)));
+}
+CT_TARGET("avx512f") inline __m512i load_16(const boost::uint32_t *p) {
+  return _mm512_loadu_si512(p);
+}
+
+template <typename T>
+CT_TARGET("avx512f") std::size_t cover_avx512(KernelArgs &args) {
+  std::size_t tmp_return = 0;
+  std::size_t num_cols = args.cols_.size();
+  boost::uint32_t ids[16];
+  std::size_t r = 0;
+  for (; r + 16 <= args.num_rows_ && args.num_left_ > 0; r += 16) {
+    __m512i id = _mm512_setzero_si512();
+    __mmask16 in_range = 0xFFFF;
+    for (std::size_t i = 0; i < num_cols; ++i) {
+      __m512i cell = load_16(static_cast<const T *>(args.cols_[i]) + r);
+      in_range &= _mm512_cmple_epu32_mask(cell, _mm512_set1_epi32(boost::int32_t(args.limits_[i])));
+      id = _mm512_add_epi32(id, _mm512_mullo_epi32(cell, _mm512_set1_epi32(boost::int32_t(args.strides_[i]))));
+    }
+    _mm512_storeu_si512(ids, id);
+    tmp_return += set_lanes(args, ids, unsigned(in_range), 16);
+  }
+  return tmp_return + cover_scalar<T>(args, r);
+}
+#endif  // CT_COMMON_SIMD_KERNELS
+
+template <typename T>
+std::size_t cover_dispatch(KernelArgs &args, SimdLevel level) {
+  switch (level) {
+#ifdef CT_COMMON_SIMD_KERNELS
+    case SIMD_AVX512: return cover_avx512<T>(args);
+    case SIMD_AVX2: return cover_avx2<T>(args);
+    case SIMD_SSE42: return cover_sse42<T>(args);
+#endif  // CT_COMMON_SIMD_KERNELS
+    default: return cover_scalar<T>(args, 0);
+  }
+}
+
+SimdLevel detect_simd_level(void) {
+#ifdef CT_COMMON_SIMD_KERNELS
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return SIMD_AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SIMD_AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2")) {
+    return SIMD_SSE42;
+  }
+#endif  // CT_COMMON_SIMD_KERNELS
+  return SIMD_SCALAR;
+}
+
+SimdLevel &the_simd_level(void) {
+  static SimdLevel level = get_supported_simd_level();
+  return level;
+}
+}  // namespace
+
+SimdLevel ct::common::get_supported_simd_level(void) {
+  static const SimdLevel level = detect_simd_level();
+  return level;
+}
+
+SimdLevel ct::common::get_simd_level(void) {
+  return the_simd_level();
+}
+
+void ct::common::set_simd_level(SimdLevel level) {
+  the_simd_level() = level < get_supported_simd_level() ? level : get_supported_simd_level();
+}
+
+const char *ct::common::get_simd_level_name(SimdLevel level) {
+  switch (level) {
+    case SIMD_SSE42: return "SSE4.2";
+    case SIMD_AVX2: return "AVX2";
+    case SIMD_AVX512: return "AVX-512";
+    default: return "scalar";
+  }
+}
+
+std::size_t ct::common::cover_rows(const TestSuite &suite, const RawStrength &raw_strength,
+                                   const std::vector<std::size_t> &strides,
+                                   const std::vector<std::size_t> &levels,
+                                   std::size_t num_combinations, std::size_t num_covered,
+                                   boost::uint64_t *bits, std::size_t offset) {
+  if (num_covered >= num_combinations || suite.get_num_rows() == 0) {
+    return 0;
+  }
+  KernelArgs args;
+  args.num_rows_ = suite.get_num_rows();
+  args.num_left_ = num_combinations - num_covered;
+  args.bits_ = bits;
+  args.offset_ = offset;
+  for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+    switch (suite.get_cell_width()) {
+      case 1: args.cols_.push_back(suite.get_column<boost::uint8_t>(raw_strength[i])); break;
+      case 2: args.cols_.push_back(suite.get_column<boost::uint16_t>(raw_strength[i])); break;
+      default: args.cols_.push_back(suite.get_column<boost::uint32_t>(raw_strength[i])); break;
+    }
+    args.strides_.push_back(strides[i]);
+    args.limits_.push_back(boost::uint32_t(levels[i] - 1));
+  }
+  // the vectorized kernels compute the ids in 32 bits
+  SimdLevel level = num_combinations <= 0xFFFFFFFFu ? get_simd_level() : SIMD_SCALAR;
+  switch (suite.get_cell_width()) {
+    case 1: return cover_dispatch<boost::uint8_t>(args, level);
+    case 2: return cover_dispatch<boost::uint16_t>(args, level);
+    default: return cover_dispatch<boost::uint32_t>(args, level);
+  }
+}
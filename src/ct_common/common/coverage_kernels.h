@@ -0,0 +1,62 @@
+//===----- ct_common/common/coverage_kernels.h ------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the vectorized kernels for coverage counting
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_COVERAGE_KERNELS_H_
+#define CT_COMMON_COVERAGE_KERNELS_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/strength.h>
+#include <ct_common/common/test_suite.h>
+
+namespace ct {
+namespace common {
+/** The instruction sets of the kernels */
+enum SimdLevel {
+  SIMD_SCALAR = 0,
+  SIMD_SSE42,
+  SIMD_AVX2,
+  SIMD_AVX512
+};
+
+/** Get the highest instruction set the kernels can use on this CPU */
+SimdLevel get_supported_simd_level(void);
+/** Get the instruction set the kernels use */
+SimdLevel get_simd_level(void);
+/**
+ * Limit the instruction set the kernels use, for testing and benchmarking.
+ * Levels above the supported one are lowered. Not to be called while kernels run.
+ */
+void set_simd_level(SimdLevel level);
+/** Get the name of an instruction set */
+const char *get_simd_level_name(SimdLevel level);
+
+/**
+ * Mark the combinations of a raw strength taken by the rows of a suite.
+ * The combination of a row has the mixed-radix id sum(vid_i * strides[i]),
+ * and sets bit offset + id of the bitmap; rows with a value id not less than
+ * levels[i] take no combination. The ids are computed for several rows at
+ * once with the instruction set of get_simd_level(), while the bits are set
+ * one by one, so that all levels give the same bitmap. Scanning stops once
+ * num_covered, the number of combinations already marked, reaches
+ * num_combinations. Returns the number of newly marked combinations.
+ */
+std::size_t cover_rows(const TestSuite &suite, const RawStrength &raw_strength,
+                       const std::vector<std::size_t> &strides,
+                       const std::vector<std::size_t> &levels,
+                       std::size_t num_combinations, std::size_t num_covered,
+                       boost::uint64_t *bits, std::size_t offset);
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_COVERAGE_KERNELS_H_
@@ -0,0 +1,228 @@
+//===----- ct_common/common/coverage_map.cpp --------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class CoverageMap
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <set>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/coverage_kernels.h>
+
+using namespace ct::common;
+
+CoverageMap::CoverageMap(void)
+    : offsets_(1, 0), num_covered_(0) {
+}
+
+CoverageMap::CoverageMap(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                         const std::vector<Strength> &strengths)
+    : offsets_(1, 0), num_covered_(0) {
+  this->Init(param_specs, strengths);
+}
+
+CoverageMap::CoverageMap(const CoverageMap &from)
+    : raw_strengths_(from.raw_strengths_), strides_(from.strides_),
+      offsets_(from.offsets_), levels_(from.levels_),
+      bits_(from.bits_), num_covered_(from.num_covered_) {
+}
+
+CoverageMap &CoverageMap::operator = (const CoverageMap &right) {
+  this->raw_strengths_ = right.raw_strengths_;
+  this->strides_ = right.strides_;
+  this->offsets_ = right.offsets_;
+  this->levels_ = right.levels_;
+  this->bits_ = right.bits_;
+  this->num_covered_ = right.num_covered_;
+  return *this;
+}
+
+CoverageMap::~CoverageMap(void) {
+}
+
+void CoverageMap::Init(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                       const std::vector<Strength> &strengths) {
+  std::vector<RawStrength> raw_strengths;
+  for (std::size_t i = 0; i < strengths.size(); ++i) {
+    attach_2_raw_strength(strengths[i], raw_strengths);
+  }
+  // overlapping strengths yield the same raw strengths several times
+  std::set<RawStrength> distinct_raw_strengths(raw_strengths.begin(), raw_strengths.end());
+  this->raw_strengths_.assign(distinct_raw_strengths.begin(), distinct_raw_strengths.end());
+
+  this->levels_.clear();
+  for (std::size_t i = 0; i < param_specs.size(); ++i) {
+    this->levels_.push_back(param_specs[i]->get_level());
+  }
+  this->strides_.assign(this->raw_strengths_.size(), std::vector<std::size_t>());
+  this->offsets_.assign(1, 0);
+  for (std::size_t i = 0; i < this->raw_strengths_.size(); ++i) {
+    const RawStrength &raw_strength = this->raw_strengths_[i];
+    std::vector<std::size_t> &strides = this->strides_[i];
+    strides.resize(raw_strength.size());
+    std::size_t num_combinations = 1;
+    for (std::size_t j = raw_strength.size(); j > 0; --j) {
+      if (raw_strength[j-1] >= this->levels_.size()) {
+        CT_EXCEPTION("the strength refers to an unknown parameter");
+      }
+      strides[j-1] = num_combinations;
+      num_combinations *= this->levels_[raw_strength[j-1]];
+    }
+    this->offsets_.push_back(this->offsets_.back() + num_combinations);
+  }
+  this->Reset();
+}
+
+void CoverageMap::Reset(void) {
+  this->bits_.assign((this->get_num_combinations() + 63) / 64, 0);
+  this->num_covered_ = 0;
+}
+
+std::size_t CoverageMap::GetCombinationId(std::size_t sid, const TestCase &test) const {
+  const RawStrength &raw_strength = this->raw_strengths_[sid];
+  const std::vector<std::size_t> &strides = this->strides_[sid];
+  std::size_t tmp_return = this->offsets_[sid];
+  for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+    std::size_t vid = test[raw_strength[i]];
+    if (vid >= this->levels_[raw_strength[i]]) {
+      return CID_BOUND;
+    }
+    tmp_return += vid * strides[i];
+  }
+  return tmp_return;
+}
+
+std::size_t CoverageMap::FindRawStrength(const RawStrength &raw_strength) const {
+  std::vector<RawStrength>::const_iterator iter =
+      std::lower_bound(this->raw_strengths_.begin(), this->raw_strengths_.end(), raw_strength);
+  if (iter == this->raw_strengths_.end() || *iter != raw_strength) {
+    return this->raw_strengths_.size();
+  }
+  return iter - this->raw_strengths_.begin();
+}
+
+std::size_t CoverageMap::GetRawStrengthId(std::size_t cid) const {
+  return std::upper_bound(this->offsets_.begin(), this->offsets_.end(), cid) - this->offsets_.begin() - 1;
+}
+
+void CoverageMap::GetValues(std::size_t cid, std::vector<std::size_t> &vids) const {
+  std::size_t sid = this->GetRawStrengthId(cid);
+  const RawStrength &raw_strength = this->raw_strengths_[sid];
+  std::size_t local_id = cid - this->offsets_[sid];
+  vids.resize(raw_strength.size());
+  for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+    vids[i] = (local_id / this->strides_[sid][i]) % this->levels_[raw_strength[i]];
+  }
+}
+
+Tuple CoverageMap::GetTuple(std::size_t cid) const {
+  std::vector<std::size_t> vids;
+  this->GetValues(cid, vids);
+  const RawStrength &raw_strength = this->raw_strengths_[this->GetRawStrengthId(cid)];
+  Tuple tmp_return;
+  for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+    tmp_return.push_back(PVPair(raw_strength[i], vids[i]));
+  }
+  return tmp_return;
+}
+
+std::size_t CoverageMap::FindUncovered(std::size_t from, std::size_t to) const {
+  while (from < to) {
+    // skip whole words of covered combinations
+    boost::uint64_t word = ~this->bits_[from >> 6] >> (from & 63);
+    if (word == 0) {
+      from = (from | 63) + 1;
+      continue;
+    }
+    while ((word & 1) == 0) {
+      word >>= 1;
+      ++from;
+    }
+    return (from < to) ? from : to;
+  }
+  return to;
+}
+
+std::size_t CoverageMap::CountCovered(std::size_t from, std::size_t to) const {
+  std::size_t tmp_return = 0;
+  while (from < to) {
+    boost::uint64_t word = this->bits_[from >> 6] >> (from & 63);
+    std::size_t num_bits = std::min(64 - (from & 63), to - from);
+    if (num_bits < 64) {
+      word &= (boost::uint64_t(1) << num_bits) - 1;
+    }
+    for (; word != 0; word &= word - 1) {
+      ++tmp_return;
+    }
+    from += num_bits;
+  }
+  return tmp_return;
+}
+
+std::size_t CoverageMap::CountUncovered(const TestCase &test) const {
+  std::size_t tmp_return = 0;
+  for (std::size_t i = 0; i < this->raw_strengths_.size(); ++i) {
+    std::size_t cid = this->GetCombinationId(i, test);
+    if (cid != CID_BOUND && !this->IsCovered(cid)) {
+      ++tmp_return;
+    }
+  }
+  return tmp_return;
+}
+
+std::size_t CoverageMap::Cover(const TestCase &test) {
+  std::size_t tmp_return = 0;
+  for (std::size_t i = 0; i < this->raw_strengths_.size(); ++i) {
+    std::size_t cid = this->GetCombinationId(i, test);
+    if (cid != CID_BOUND && this->Cover(cid)) {
+      ++tmp_return;
+    }
+  }
+  return tmp_return;
+}
+
+std::size_t CoverageMap::Cover(const Tuple &tuple) {
+  TestCase test;
+  test.assign(this->levels_.size(), VID_BOUND);
+  for (std::size_t i = 0; i < tuple.size(); ++i) {
+    if (tuple[i].pid_ < test.size()) {
+      test[tuple[i].pid_] = tuple[i].vid_;
+    }
+  }
+  return this->Cover(test);
+}
+
+std::size_t CoverageMap::CoverRawStrength(std::size_t sid, const TestSuite &suite) {
+  const RawStrength &raw_strength = this->raw_strengths_[sid];
+  std::vector<std::size_t> levels(raw_strength.size());
+  for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+    levels[i] = this->levels_[raw_strength[i]];
+  }
+  std::size_t offset = this->offsets_[sid];
+  std::size_t num_combinations = this->offsets_[sid + 1] - offset;
+  if (num_combinations == 0) {
+    return 0;
+  }
+  std::size_t tmp_return = cover_rows(suite, raw_strength, this->strides_[sid], levels, num_combinations,
+                                      this->CountCovered(offset, offset + num_combinations),
+                                      &this->bits_[0], offset);
+  this->num_covered_ += tmp_return;
+  return tmp_return;
+}
+
+std::size_t CoverageMap::Cover(const TestSuite &suite) {
+  if (suite.get_num_params() != this->levels_.size()) {
+    CT_EXCEPTION("the test suite does not match the parameters");
+  }
+  std::size_t tmp_return = 0;
+  for (std::size_t i = 0; i < this->raw_strengths_.size(); ++i) {
+    tmp_return += this->CoverRawStrength(i, suite);
+  }
+  return tmp_return;
+}
@@ -0,0 +1,127 @@
+//===----- ct_common/common/coverage_map.h ----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for tracking the coverage of target
+// combinations
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_COVERAGE_MAP_H_
+#define CT_COMMON_COVERAGE_MAP_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/paramspec.h>
+#include <ct_common/common/strength.h>
+#include <ct_common/common/test_case.h>
+#include <ct_common/common/test_suite.h>
+#include <ct_common/common/tuple.h>
+
+namespace ct {
+namespace common {
+const std::size_t CID_BOUND = std::size_t(-1);  /**< Upper bound for combination ids */
+
+/**
+ * The class for tracking the coverage of target combinations.
+ * The strengths are decomposed into distinct raw strengths, and the combinations
+ * of each raw strength (valid values only) are numbered in mixed radix, the first
+ * parameter being the most significant one. All combinations share one bitmap,
+ * in which the raw strength with id sid occupies [get_offset(sid), get_offset(sid+1)).
+ * Cells of test cases with vids out of range (invalid values, or VID_BOUND for
+ * unassigned cells) take part in no combination.
+ */
+class DLL_EXPORT CoverageMap {
+public:
+  CoverageMap(void);
+  CoverageMap(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+              const std::vector<Strength> &strengths);
+  CoverageMap(const CoverageMap &from);
+  CoverageMap &operator = (const CoverageMap &right);
+  ~CoverageMap(void);
+
+  /** Initialize the map with all combinations uncovered */
+  void Init(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+            const std::vector<Strength> &strengths);
+  /** Mark all combinations uncovered */
+  void Reset(void);
+
+  /** Get the number of raw strengths */
+  std::size_t get_num_raw_strengths(void) const { return this->raw_strengths_.size(); }
+  /** Get a raw strength, the pids are sorted */
+  const RawStrength &get_raw_strength(std::size_t sid) const { return this->raw_strengths_[sid]; }
+  /** Get the id of a raw strength, get_num_raw_strengths() if it is not a target */
+  std::size_t FindRawStrength(const RawStrength &raw_strength) const;
+  /** Get the id of the first combination of a raw strength, sid can be get_num_raw_strengths() */
+  std::size_t get_offset(std::size_t sid) const { return this->offsets_[sid]; }
+  /** Get the weight of the i-th parameter of a raw strength in combination ids */
+  std::size_t get_stride(std::size_t sid, std::size_t i) const { return this->strides_[sid][i]; }
+  /** Get the level of a parameter */
+  std::size_t get_level(std::size_t pid) const { return this->levels_[pid]; }
+  /** Get the number of target combinations */
+  std::size_t get_num_combinations(void) const { return this->offsets_.back(); }
+  /** Get the number of covered combinations */
+  std::size_t get_num_covered(void) const { return this->num_covered_; }
+  /** Get the number of uncovered combinations */
+  std::size_t get_num_uncovered(void) const { return this->get_num_combinations() - this->num_covered_; }
+
+  /** Get the id of the combination of a raw strength taken by a test case, CID_BOUND if there is none */
+  std::size_t GetCombinationId(std::size_t sid, const TestCase &test) const;
+  /** Get the raw strength a combination belongs to */
+  std::size_t GetRawStrengthId(std::size_t cid) const;
+  /** Get the vids of a combination, in the order of the pids of its raw strength */
+  void GetValues(std::size_t cid, std::vector<std::size_t> &vids) const;
+  /** Get a combination as a tuple */
+  Tuple GetTuple(std::size_t cid) const;
+
+  /** Whether a combination is covered */
+  bool IsCovered(std::size_t cid) const {
+    return (this->bits_[cid >> 6] >> (cid & 63)) & 1;
+  }
+  /** Mark a combination covered, returns whether it was uncovered */
+  bool Cover(std::size_t cid) {
+    boost::uint64_t mask = boost::uint64_t(1) << (cid & 63);
+    if (this->bits_[cid >> 6] & mask) {
+      return false;
+    }
+    this->bits_[cid >> 6] |= mask;
+    ++this->num_covered_;
+    return true;
+  }
+  /** Find the first uncovered combination in [from, to), to if there is none */
+  std::size_t FindUncovered(std::size_t from, std::size_t to) const;
+  /** Count the covered combinations in [from, to) */
+  std::size_t CountCovered(std::size_t from, std::size_t to) const;
+
+  /** Count the combinations a test case would newly cover */
+  std::size_t CountUncovered(const TestCase &test) const;
+  /** Mark the combinations of a test case covered, returns the number of newly covered ones */
+  std::size_t Cover(const TestCase &test);
+  /** Mark the combinations contained in a (partial) assignment covered, returns the number of newly covered ones */
+  std::size_t Cover(const Tuple &tuple);
+  /**
+   * Mark the combinations of a raw strength taken by the rows of a suite covered,
+   * with the vectorized kernels of cover_rows, returns the number of newly covered ones
+   */
+  std::size_t CoverRawStrength(std::size_t sid, const TestSuite &suite);
+  /** Mark the combinations taken by the rows of a suite covered, returns the number of newly covered ones */
+  std::size_t Cover(const TestSuite &suite);
+
+private:
+  std::vector<RawStrength> raw_strengths_;  /**< The distinct raw strengths */
+  std::vector<std::vector<std::size_t> > strides_;  /**< The weights of the parameters in combination ids */
+  std::vector<std::size_t> offsets_;  /**< The first combination ids, with the total number in the back */
+  std::vector<std::size_t> levels_;  /**< The levels of all parameters */
+  std::vector<boost::uint64_t> bits_;  /**< The coverage bitmap */
+  std::size_t num_covered_;  /**< The number of covered combinations */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_COVERAGE_MAP_H_
@@ -0,0 +1,213 @@
+//===----- ct_common/common/coverage_verifier.cpp ---------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class CoverageVerifier
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <boost/cstdint.hpp>
+#include <ct_common/common/coverage_verifier.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/coverage_kernels.h>
+#include <ct_common/common/test_suite.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/feasibility_cache.h>
+#include <ct_common/common/defs.h>
+#include <ct_common/common/strided_threads.h>
+
+using namespace ct::common;
+
+namespace {
+/** Verifies the raw strengths first, first + step, ... */
+struct VerifyWorker {
+  void operator () (std::size_t first) const {
+    std::vector<boost::uint64_t> bits;
+    std::vector<std::size_t> strides, levels, vids;
+    FeasibilityCache feasibility(*this->checker_, *this->symmetry_);
+    for (std::size_t sid = first; sid < this->coverage_->get_num_raw_strengths(); sid += this->step_) {
+      const RawStrength &raw_strength = this->coverage_->get_raw_strength(sid);
+      std::size_t offset = this->coverage_->get_offset(sid);
+      std::size_t num_combinations = this->coverage_->get_offset(sid + 1) - offset;
+      bool has_auto = false;
+      for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+        has_auto = has_auto || (*this->is_auto_)[raw_strength[i]];
+      }
+      if (has_auto) {
+        (*this->infeasible_)[sid] = num_combinations;
+        continue;
+      }
+      strides.resize(raw_strength.size());
+      levels.resize(raw_strength.size());
+      for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+        strides[i] = this->coverage_->get_stride(sid, i);
+        levels[i] = this->coverage_->get_level(raw_strength[i]);
+      }
+      bits.assign((num_combinations + 63) / 64, 0);
+      std::size_t num_covered = num_combinations == 0 ? 0 :
+          cover_rows(*this->suite_, raw_strength, strides, levels, num_combinations, 0, &bits[0], 0);
+      (*this->covered_)[sid] = num_covered;
+      std::size_t num_infeasible = 0;
+      for (std::size_t local_id = 0; local_id < num_combinations && num_covered < num_combinations; ++local_id) {
+        if ((bits[local_id >> 6] >> (local_id & 63)) & 1) {
+          continue;
+        }
+        bool is_feasible = false;
+        if (this->oracle_) {
+          is_feasible = this->oracle_->IsFeasible(sid, local_id);
+        } else {
+          this->coverage_->GetValues(offset + local_id, vids);
+          is_feasible = feasibility.IsFeasible(raw_strength, vids);
+        }
+        if (!is_feasible) {
+          ++num_infeasible;
+        } else if ((*this->missing_)[first].size() < this->max_listed_) {
+          (*this->missing_)[first].push_back(offset + local_id);
+        }
+      }
+      (*this->infeasible_)[sid] = num_infeasible;
+    }
+  }
+
+  const ConstraintChecker *checker_;
+  const ModelSymmetry *symmetry_;
+  const FeasibilityOracle *oracle_;
+  const CoverageMap *coverage_;
+  const TestSuite *suite_;
+  const std::vector<bool> *is_auto_;
+  std::vector<std::size_t> *covered_;
+  std::vector<std::size_t> *infeasible_;
+  std::vector<std::vector<std::size_t> > *missing_;
+  std::size_t max_listed_;
+  std::size_t step_;
+};
+}  // namespace
+
+StrengthCoverage::StrengthCoverage(void)
+    : num_combinations_(0), num_covered_(0), num_infeasible_(0) {
+}
+
+CoverageVerifier::CoverageVerifier(void)
+    : num_threads_(0), max_listed_(1000), use_symmetry_(true), num_incomplete_(0), num_invalid_(0) {
+}
+
+CoverageVerifier::CoverageVerifier(const CoverageVerifier &from)
+    : num_threads_(from.num_threads_), max_listed_(from.max_listed_), use_symmetry_(from.use_symmetry_),
+      feasibility_oracle_(from.feasibility_oracle_), num_incomplete_(from.num_incomplete_), num_invalid_(from.num_invalid_),
+      strength_coverages_(from.strength_coverages_), total_coverage_(from.total_coverage_),
+      missing_(from.missing_) {
+}
+
+CoverageVerifier &CoverageVerifier::operator = (const CoverageVerifier &right) {
+  this->num_threads_ = right.num_threads_;
+  this->max_listed_ = right.max_listed_;
+  this->use_symmetry_ = right.use_symmetry_;
+  this->feasibility_oracle_ = right.feasibility_oracle_;
+  this->num_incomplete_ = right.num_incomplete_;
+  this->num_invalid_ = right.num_invalid_;
+  this->strength_coverages_ = right.strength_coverages_;
+  this->total_coverage_ = right.total_coverage_;
+  this->missing_ = right.missing_;
+  return *this;
+}
+
+CoverageVerifier::~CoverageVerifier(void) {
+}
+
+bool CoverageVerifier::IsPassed(void) const {
+  return this->num_incomplete_ == 0 && this->num_invalid_ == 0 &&
+      this->total_coverage_.get_num_missing() == 0;
+}
+
+void CoverageVerifier::Verify(const SUTModel &model, const std::vector<TestCase> &tests) {
+  this->num_incomplete_ = 0;
+  this->num_invalid_ = 0;
+  this->strength_coverages_.assign(model.strengths_.size(), StrengthCoverage());
+  this->total_coverage_ = StrengthCoverage();
+  this->missing_.clear();
+
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  if (this->feasibility_oracle_ && !this->feasibility_oracle_->IsMatching(coverage)) {
+    CT_EXCEPTION("the feasibility oracle is computed for another model");
+  }
+  std::vector<bool> is_auto(model.param_specs_.size());
+  for (std::size_t i = 0; i < model.param_specs_.size(); ++i) {
+    is_auto[i] = model.param_specs_[i]->is_auto();
+  }
+
+  // the valid test cases by columns, values out of range take part in no combination
+  TestSuite suite(model.param_specs_);
+  suite.Reserve(tests.size());
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    bool is_complete = tests[i].size() == model.param_specs_.size();
+    for (std::size_t j = 0; j < tests[i].size() && is_complete; ++j) {
+      is_complete = is_auto[j] || tests[i][j] <= model.param_specs_[j]->get_invalid_vid();
+    }
+    if (!is_complete) {
+      ++this->num_incomplete_;
+      continue;
+    }
+    if (!checker.IsValid(tests[i])) {
+      ++this->num_invalid_;
+      continue;
+    }
+    suite.AppendRow(tests[i]);
+  }
+
+  std::size_t num_sids = coverage.get_num_raw_strengths();
+  std::size_t num_threads = resolve_num_threads(this->num_threads_, num_sids);
+  std::vector<std::size_t> covered(num_sids, 0), infeasible(num_sids, 0);
+  std::vector<std::vector<std::size_t> > missing(num_threads);
+  ModelSymmetry symmetry;
+  if (this->use_symmetry_ && !this->feasibility_oracle_) {
+    symmetry.Detect(model);
+  }
+  VerifyWorker worker;
+  worker.checker_ = &checker;
+  worker.symmetry_ = &symmetry;
+  worker.oracle_ = this->feasibility_oracle_.get();
+  worker.coverage_ = &coverage;
+  worker.suite_ = &suite;
+  worker.is_auto_ = &is_auto;
+  worker.covered_ = &covered;
+  worker.infeasible_ = &infeasible;
+  worker.max_listed_ = this->max_listed_;
+  worker.missing_ = &missing;
+  worker.step_ = num_threads;
+  run_strided(num_threads, worker);
+
+  for (std::size_t sid = 0; sid < num_sids; ++sid) {
+    this->total_coverage_.num_combinations_ += coverage.get_offset(sid + 1) - coverage.get_offset(sid);
+    this->total_coverage_.num_covered_ += covered[sid];
+    this->total_coverage_.num_infeasible_ += infeasible[sid];
+  }
+  for (std::size_t i = 0; i < model.strengths_.size(); ++i) {
+    std::vector<RawStrength> raw_strengths;
+    attach_2_raw_strength(model.strengths_[i], raw_strengths);
+    StrengthCoverage &strength_coverage = this->strength_coverages_[i];
+    for (std::size_t j = 0; j < raw_strengths.size(); ++j) {
+      std::size_t sid = coverage.FindRawStrength(raw_strengths[j]);
+      if (sid >= num_sids) {
+        continue;
+      }
+      strength_coverage.num_combinations_ += coverage.get_offset(sid + 1) - coverage.get_offset(sid);
+      strength_coverage.num_covered_ += covered[sid];
+      strength_coverage.num_infeasible_ += infeasible[sid];
+    }
+  }
+  std::vector<std::size_t> cids;
+  for (std::size_t i = 0; i < missing.size(); ++i) {
+    cids.insert(cids.end(), missing[i].begin(), missing[i].end());
+  }
+  std::sort(cids.begin(), cids.end());
+  cids.resize(std::min(cids.size(), this->max_listed_));
+  for (std::size_t i = 0; i < cids.size(); ++i) {
+    this->missing_.push_back(coverage.GetTuple(cids[i]));
+  }
+}
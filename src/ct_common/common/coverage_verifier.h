@@ -0,0 +1,109 @@
+//===----- ct_common/common/coverage_verifier.h -----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the verifier of the coverage of test suites
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_COVERAGE_VERIFIER_H_
+#define CT_COMMON_COVERAGE_VERIFIER_H_
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+#include <ct_common/common/tuple.h>
+#include <ct_common/common/feasibility_oracle.h>
+
+namespace ct {
+namespace common {
+/**
+ * The coverage of a strength
+ */
+struct DLL_EXPORT StrengthCoverage {
+  StrengthCoverage(void);
+
+  /** Get the number of feasible combinations left uncovered */
+  std::size_t get_num_missing(void) const { return this->num_combinations_ - this->num_covered_ - this->num_infeasible_; }
+
+  std::size_t num_combinations_;  /**< The number of target combinations */
+  std::size_t num_covered_;  /**< The number of covered combinations */
+  std::size_t num_infeasible_;  /**< The number of uncovered combinations no valid test case can take */
+};
+
+/**
+ * The verifier certifying that a test suite covers the strengths of a model.
+ * Only complete test cases satisfying the constraints count. The raw
+ * strengths are dealt out to the threads, each of which scans the columns of
+ * the test suite with a bitmap per raw strength, stopping as soon as all
+ * combinations of the raw strength are covered. Uncovered combinations are
+ * then split into feasible ones and infeasible ones by the constraint checker,
+ * up to the symmetries of the model (see FeasibilityCache), or by the
+ * feasibility oracle if one is set; combinations involving auto parameters
+ * are taken as infeasible.
+ */
+class DLL_EXPORT CoverageVerifier {
+public:
+  CoverageVerifier(void);
+  CoverageVerifier(const CoverageVerifier &from);
+  CoverageVerifier &operator = (const CoverageVerifier &right);
+  ~CoverageVerifier(void);
+
+  /** Verify a test suite against the model */
+  void Verify(const SUTModel &model, const std::vector<TestCase> &tests);
+  /** Whether the last verified suite is all valid and leaves no feasible combination uncovered */
+  bool IsPassed(void) const;
+
+  /** Set the number of threads, 0 for the hardware concurrency */
+  void set_num_threads(std::size_t num_threads) { this->num_threads_ = num_threads; }
+  /** Get the number of threads, 0 for the hardware concurrency */
+  std::size_t get_num_threads(void) const { return this->num_threads_; }
+  /** Set the largest number of missing combinations listed */
+  void set_max_listed(std::size_t max_listed) { this->max_listed_ = max_listed; }
+  /** Get the largest number of missing combinations listed */
+  std::size_t get_max_listed(void) const { return this->max_listed_; }
+  /** Set whether the infeasible combinations are found up to the symmetries of the model */
+  void set_use_symmetry(bool use_symmetry) { this->use_symmetry_ = use_symmetry; }
+  /** Get whether the infeasible combinations are found up to the symmetries of the model */
+  bool get_use_symmetry(void) const { return this->use_symmetry_; }
+  /** Set the oracle computed for the model to verify, null for searching the combinations instead */
+  void set_feasibility_oracle(const boost::shared_ptr<const FeasibilityOracle> &oracle) {
+    this->feasibility_oracle_ = oracle;
+  }
+  /** Get the oracle for the model to verify */
+  const boost::shared_ptr<const FeasibilityOracle> &get_feasibility_oracle(void) const {
+    return this->feasibility_oracle_;
+  }
+
+  /** Get the number of test cases with unassigned cells */
+  std::size_t get_num_incomplete(void) const { return this->num_incomplete_; }
+  /** Get the number of complete test cases violating the constraints */
+  std::size_t get_num_invalid(void) const { return this->num_invalid_; }
+  /** Get the coverage of each strength of the model */
+  const std::vector<StrengthCoverage> &get_strength_coverages(void) const { return this->strength_coverages_; }
+  /** Get the coverage of all distinct combinations of the model */
+  const StrengthCoverage &get_total_coverage(void) const { return this->total_coverage_; }
+  /** Get the first missing combinations, by the order of raw strengths and values */
+  const std::vector<Tuple> &get_missing(void) const { return this->missing_; }
+
+private:
+  std::size_t num_threads_;  /**< The number of threads */
+  std::size_t max_listed_;  /**< The largest number of missing combinations listed */
+  bool use_symmetry_;  /**< Whether the infeasible combinations are found up to symmetries */
+  boost::shared_ptr<const FeasibilityOracle> feasibility_oracle_;  /**< The oracle for the model to verify */
+  std::size_t num_incomplete_;  /**< The number of incomplete test cases */
+  std::size_t num_invalid_;  /**< The number of invalid test cases */
+  std::vector<StrengthCoverage> strength_coverages_;  /**< The coverage of each strength */
+  StrengthCoverage total_coverage_;  /**< The coverage of all distinct combinations */
+  std::vector<Tuple> missing_;  /**< The listed missing combinations */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_COVERAGE_VERIFIER_H_
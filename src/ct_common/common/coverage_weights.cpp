@@ -0,0 +1,222 @@
+//===----- ct_common/common/coverage_weights.cpp ----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of classes CoverageWeights and
+// CoverageWeightTable
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <ct_common/common/coverage_weights.h>
+#include <ct_common/common/coverage_map.h>
+
+using namespace ct::common;
+
+CoverageWeights::CoverageWeights(void) {
+}
+
+CoverageWeights::CoverageWeights(const CoverageWeights &from)
+    : strength_weights_(from.strength_weights_), value_weights_(from.value_weights_) {
+}
+
+CoverageWeights &CoverageWeights::operator = (const CoverageWeights &right) {
+  this->strength_weights_ = right.strength_weights_;
+  this->value_weights_ = right.value_weights_;
+  return *this;
+}
+
+CoverageWeights::~CoverageWeights(void) {
+}
+
+bool CoverageWeights::is_uniform(void) const {
+  for (std::size_t i = 0; i < this->strength_weights_.size(); ++i) {
+    if (this->strength_weights_[i] != 1.0) {
+      return false;
+    }
+  }
+  for (std::size_t i = 0; i < this->value_weights_.size(); ++i) {
+    for (std::size_t j = 0; j < this->value_weights_[i].size(); ++j) {
+      if (this->value_weights_[i][j] != 1.0) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+void CoverageWeights::Clear(void) {
+  this->strength_weights_.clear();
+  this->value_weights_.clear();
+}
+
+void CoverageWeights::set_strength_weight(std::size_t index, double weight) {
+  if (!(weight >= 0)) {
+    CT_EXCEPTION("weights cannot be negative");
+  }
+  if (index >= this->strength_weights_.size()) {
+    this->strength_weights_.resize(index + 1, 1.0);
+  }
+  this->strength_weights_[index] = weight;
+}
+
+void CoverageWeights::set_value_weight(std::size_t pid, std::size_t vid, double weight) {
+  if (!(weight >= 0)) {
+    CT_EXCEPTION("weights cannot be negative");
+  }
+  if (pid >= this->value_weights_.size()) {
+    this->value_weights_.resize(pid + 1);
+  }
+  if (vid >= this->value_weights_[pid].size()) {
+    this->value_weights_[pid].resize(vid + 1, 1.0);
+  }
+  this->value_weights_[pid][vid] = weight;
+}
+
+CoverageWeightTable::CoverageWeightTable(void)
+    : is_uniform_(true), max_test_weight_(0), total_weight_(0) {
+}
+
+CoverageWeightTable::CoverageWeightTable(const CoverageWeightTable &from)
+    : is_uniform_(from.is_uniform_), raw_strength_weights_(from.raw_strength_weights_),
+      value_weights_(from.value_weights_), max_test_weight_(from.max_test_weight_),
+      total_weight_(from.total_weight_) {
+}
+
+CoverageWeightTable &CoverageWeightTable::operator = (const CoverageWeightTable &right) {
+  this->is_uniform_ = right.is_uniform_;
+  this->raw_strength_weights_ = right.raw_strength_weights_;
+  this->value_weights_ = right.value_weights_;
+  this->max_test_weight_ = right.max_test_weight_;
+  this->total_weight_ = right.total_weight_;
+  return *this;
+}
+
+CoverageWeightTable::~CoverageWeightTable(void) {
+}
+
+void CoverageWeightTable::Init(const std::vector<Strength> &strengths, const CoverageWeights &weights,
+                               const CoverageMap &coverage) {
+  std::size_t num_sids = coverage.get_num_raw_strengths();
+  this->is_uniform_ = weights.is_uniform();
+  this->raw_strength_weights_.assign(num_sids, 1.0);
+  this->value_weights_.clear();
+  for (std::size_t sid = 0; sid < num_sids; ++sid) {
+    const RawStrength &raw_strength = coverage.get_raw_strength(sid);
+    for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+      std::size_t pid = raw_strength[i];
+      if (pid >= this->value_weights_.size()) {
+        this->value_weights_.resize(pid + 1);
+      }
+      if (this->value_weights_[pid].empty()) {
+        for (std::size_t vid = 0; vid < coverage.get_level(pid); ++vid) {
+          this->value_weights_[pid].push_back(weights.get_value_weight(pid, vid));
+        }
+      }
+    }
+  }
+  if (!this->is_uniform_) {
+    // a raw strength shared by several strengths takes the largest weight
+    std::vector<bool> is_weighted(num_sids, false);
+    std::vector<RawStrength> raw_strengths;
+    for (std::size_t i = 0; i < strengths.size(); ++i) {
+      raw_strengths.clear();
+      attach_2_raw_strength(strengths[i], raw_strengths);
+      double weight = weights.get_strength_weight(i);
+      for (std::size_t j = 0; j < raw_strengths.size(); ++j) {
+        std::size_t sid = coverage.FindRawStrength(raw_strengths[j]);
+        if (sid >= num_sids) {
+          continue;
+        }
+        if (!is_weighted[sid] || weight > this->raw_strength_weights_[sid]) {
+          this->raw_strength_weights_[sid] = weight;
+        }
+        is_weighted[sid] = true;
+      }
+    }
+  }
+
+  // a test case takes one combination per raw strength
+  this->max_test_weight_ = 0;
+  this->total_weight_ = 0;
+  for (std::size_t sid = 0; sid < num_sids; ++sid) {
+    const RawStrength &raw_strength = coverage.get_raw_strength(sid);
+    double max_weight = this->raw_strength_weights_[sid];
+    double total_weight = this->raw_strength_weights_[sid];
+    for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+      const std::vector<double> &value_weights = this->value_weights_[raw_strength[i]];
+      double max_value_weight = 0, total_value_weight = 0;
+      for (std::size_t vid = 0; vid < value_weights.size(); ++vid) {
+        max_value_weight = std::max(max_value_weight, value_weights[vid]);
+        total_value_weight += value_weights[vid];
+      }
+      max_weight *= max_value_weight;
+      total_weight *= total_value_weight;
+    }
+    this->max_test_weight_ += max_weight;
+    this->total_weight_ += total_weight;
+  }
+}
+
+double CoverageWeightTable::GetWeight(const CoverageMap &coverage, std::size_t cid) const {
+  if (this->is_uniform_) {
+    return 1.0;
+  }
+  std::size_t sid = coverage.GetRawStrengthId(cid);
+  const RawStrength &raw_strength = coverage.get_raw_strength(sid);
+  std::size_t local_id = cid - coverage.get_offset(sid);
+  double tmp_return = this->raw_strength_weights_[sid];
+  for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+    std::size_t vid = (local_id / coverage.get_stride(sid, i)) % coverage.get_level(raw_strength[i]);
+    tmp_return *= this->value_weights_[raw_strength[i]][vid];
+  }
+  return tmp_return;
+}
+
+double CoverageWeightTable::WeighUncovered(const CoverageMap &coverage, const TestCase &test,
+                                           std::size_t *num_uncovered) const {
+  if (this->is_uniform_) {
+    std::size_t count = coverage.CountUncovered(test);
+    if (num_uncovered) {
+      *num_uncovered = count;
+    }
+    return static_cast<double>(count);
+  }
+  double tmp_return = 0;
+  std::size_t count = 0;
+  for (std::size_t sid = 0; sid < coverage.get_num_raw_strengths(); ++sid) {
+    std::size_t cid = coverage.GetCombinationId(sid, test);
+    if (cid == CID_BOUND || coverage.IsCovered(cid)) {
+      continue;
+    }
+    ++count;
+    const RawStrength &raw_strength = coverage.get_raw_strength(sid);
+    double weight = this->raw_strength_weights_[sid];
+    for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+      weight *= this->value_weights_[raw_strength[i]][test[raw_strength[i]]];
+    }
+    tmp_return += weight;
+  }
+  if (num_uncovered) {
+    *num_uncovered = count;
+  }
+  return tmp_return;
+}
+
+double CoverageWeightTable::WeighCovered(const CoverageMap &coverage) const {
+  if (this->is_uniform_) {
+    return static_cast<double>(coverage.get_num_covered());
+  }
+  double tmp_return = 0;
+  std::size_t num_combinations = coverage.get_num_combinations();
+  for (std::size_t cid = 0; cid < num_combinations; ++cid) {
+    if (coverage.IsCovered(cid)) {
+      tmp_return += this->GetWeight(coverage, cid);
+    }
+  }
+  return tmp_return;
+}
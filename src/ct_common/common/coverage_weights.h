@@ -0,0 +1,117 @@
+//===----- ct_common/common/coverage_weights.h ------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the weights of the target combinations of SUT
+// models
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_COVERAGE_WEIGHTS_H_
+#define CT_COMMON_COVERAGE_WEIGHTS_H_
+
+#include <vector>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/strength.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+class CoverageMap;
+
+/**
+ * The weights of the strengths and of the parameter values of a model, by
+ * the indices of the strengths and by pids and vids. Weights not set are 1.
+ * The weights only order the target combinations for generators and
+ * prioritizers: every combination is still to be covered.
+ */
+class DLL_EXPORT CoverageWeights {
+public:
+  CoverageWeights(void);
+  CoverageWeights(const CoverageWeights &from);
+  CoverageWeights &operator = (const CoverageWeights &right);
+  ~CoverageWeights(void);
+
+  /** Whether all weights are 1 */
+  bool is_uniform(void) const;
+  /** Reset all weights to 1 */
+  void Clear(void);
+
+  /** Set the weight of a strength by its index, throws if negative */
+  void set_strength_weight(std::size_t index, double weight);
+  /** Get the weight of a strength by its index */
+  double get_strength_weight(std::size_t index) const {
+    return index < this->strength_weights_.size() ? this->strength_weights_[index] : 1.0;
+  }
+  /** Set the weight of a value, throws if negative */
+  void set_value_weight(std::size_t pid, std::size_t vid, double weight);
+  /** Get the weight of a value */
+  double get_value_weight(std::size_t pid, std::size_t vid) const {
+    return pid < this->value_weights_.size() && vid < this->value_weights_[pid].size() ?
+        this->value_weights_[pid][vid] : 1.0;
+  }
+  /** Get the weights of the strengths set, by indices */
+  const std::vector<double> &get_strength_weights(void) const { return this->strength_weights_; }
+  /** Get the weights of the values set, by pids and vids */
+  const std::vector<std::vector<double> > &get_value_weights(void) const { return this->value_weights_; }
+
+private:
+  std::vector<double> strength_weights_;  /**< The weights of the strengths, 1 beyond the end */
+  std::vector<std::vector<double> > value_weights_;  /**< The weights of the values, 1 beyond the ends */
+};
+
+/**
+ * The weights of the combinations of a coverage map. A combination weighs
+ * the weight of its raw strength, the largest one of the strengths it comes
+ * from, times the weights of its values. The weights are computed from the
+ * ids of the combinations as the counts are, so that weighted scores cost a
+ * few multiplications more than counts and nothing is stored per
+ * combination. With uniform weights, every combination weighs exactly 1 and
+ * the weighted scores equal the counts.
+ */
+class DLL_EXPORT CoverageWeightTable {
+public:
+  CoverageWeightTable(void);
+  CoverageWeightTable(const CoverageWeightTable &from);
+  CoverageWeightTable &operator = (const CoverageWeightTable &right);
+  ~CoverageWeightTable(void);
+
+  /** Compute the weights of the raw strengths and values of a coverage map built from the strengths */
+  void Init(const std::vector<Strength> &strengths, const CoverageWeights &weights, const CoverageMap &coverage);
+
+  /** Whether all combinations weigh 1 */
+  bool is_uniform(void) const { return this->is_uniform_; }
+  /** Get the weight of a raw strength */
+  double get_raw_strength_weight(std::size_t sid) const { return this->raw_strength_weights_[sid]; }
+  /** Get the weight of a value */
+  double get_value_weight(std::size_t pid, std::size_t vid) const { return this->value_weights_[pid][vid]; }
+  /** Get the largest weight a test case can cover */
+  double get_max_test_weight(void) const { return this->max_test_weight_; }
+  /** Get the total weight of the combinations */
+  double get_total_weight(void) const { return this->total_weight_; }
+
+  /** Get the weight of a combination */
+  double GetWeight(const CoverageMap &coverage, std::size_t cid) const;
+  /**
+   * Get the total weight of the uncovered combinations of a test case, see
+   * CoverageMap::CountUncovered, which is also stored in num_uncovered if not null
+   */
+  double WeighUncovered(const CoverageMap &coverage, const TestCase &test, std::size_t *num_uncovered = 0) const;
+  /** Get the total weight of the covered combinations */
+  double WeighCovered(const CoverageMap &coverage) const;
+
+private:
+  bool is_uniform_;  /**< Whether all combinations weigh 1 */
+  std::vector<double> raw_strength_weights_;  /**< The weights of the raw strengths */
+  std::vector<std::vector<double> > value_weights_;  /**< The weights of the values, by pids and vids */
+  double max_test_weight_;  /**< The largest weight a test case can cover */
+  double total_weight_;  /**< The total weight of the combinations */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_COVERAGE_WEIGHTS_H_
@@ -0,0 +1,286 @@
+//===----- ct_common/common/domain_reducer.cpp ------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class DomainReducer
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <deque>
+#include <ct_common/common/domain_reducer.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/seed_tuple.h>
+
+using namespace ct::common;
+
+namespace {
+/** Make a parameter specification like another, with some of its values */
+boost::shared_ptr<ParamSpec> make_param_spec(const ParamSpec &from, const std::vector<std::string> &values) {
+  boost::shared_ptr<ParamSpec> tmp_return;
+  if (dynamic_cast<const ParamSpec_Int *>(&from)) {
+    tmp_return.reset(new ParamSpec_Int());
+  } else if (dynamic_cast<const ParamSpec_Double *>(&from)) {
+    tmp_return.reset(new ParamSpec_Double());
+  } else if (dynamic_cast<const ParamSpec_String *>(&from)) {
+    tmp_return.reset(new ParamSpec_String());
+  } else {
+    CT_EXCEPTION("cannot reduce the domain of parameter " + from.get_param_name());
+  }
+  tmp_return->set_param_name(from.get_param_name());
+  tmp_return->set_aux(from.is_aux());
+  tmp_return->set_values(values);
+  return tmp_return;
+}
+
+/** Whether a constraint is satisfied by a test case */
+bool is_satisfied(const Constraint &constraint, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                  const TestCase &test) {
+  EvalType_Bool result = constraint.Evaluate(param_specs, test);
+  return result.is_valid_ && result.value_;
+}
+}  // namespace
+
+DomainReducer::DomainReducer(void)
+    : is_consistent_(true), num_removed_values_(0), num_removed_combinations_(0), num_removed_seeds_(0),
+      num_revisions_(0) {
+}
+
+DomainReducer::DomainReducer(const DomainReducer &from)
+    : original_vids_(from.original_vids_), reduced_vids_(from.reduced_vids_), is_consistent_(from.is_consistent_),
+      num_removed_values_(from.num_removed_values_), num_removed_combinations_(from.num_removed_combinations_),
+      num_removed_seeds_(from.num_removed_seeds_), num_revisions_(from.num_revisions_) {
+}
+
+DomainReducer &DomainReducer::operator = (const DomainReducer &right) {
+  this->original_vids_ = right.original_vids_;
+  this->reduced_vids_ = right.reduced_vids_;
+  this->is_consistent_ = right.is_consistent_;
+  this->num_removed_values_ = right.num_removed_values_;
+  this->num_removed_combinations_ = right.num_removed_combinations_;
+  this->num_removed_seeds_ = right.num_removed_seeds_;
+  this->num_revisions_ = right.num_revisions_;
+  return *this;
+}
+
+DomainReducer::~DomainReducer(void) {
+}
+
+void DomainReducer::Reduce(const SUTModel &model, SUTModel &reduced) {
+  std::size_t num_params = model.param_specs_.size();
+  this->original_vids_.resize(num_params);
+  this->reduced_vids_.resize(num_params);
+  for (std::size_t i = 0; i < num_params; ++i) {
+    std::size_t level = model.param_specs_[i]->get_level();
+    this->original_vids_[i].resize(level + 1);
+    for (std::size_t vid = 0; vid <= level; ++vid) {
+      this->original_vids_[i][vid] = vid;
+    }
+    this->reduced_vids_[i] = this->original_vids_[i];
+  }
+  this->is_consistent_ = true;
+  this->num_removed_values_ = 0;
+  this->num_removed_combinations_ = 0;
+  this->num_removed_seeds_ = 0;
+  this->num_revisions_ = 0;
+  reduced = model;
+
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  TestCase test = checker.MakeEmptyTest();
+  if (!checker.IsValid(test)) {
+    // some constraint fails without any parameter
+    this->is_consistent_ = false;
+    return;
+  }
+  // the invalid values stay, as supports for the other parameters
+  std::vector<std::vector<bool> > is_alive(num_params);
+  std::vector<bool> is_reducible(num_params);
+  for (std::size_t i = 0; i < num_params; ++i) {
+    is_alive[i].assign(model.param_specs_[i]->get_level() + 1, true);
+    is_reducible[i] = !model.param_specs_[i]->is_auto() &&
+        !dynamic_cast<const ParamSpec_Bool *>(model.param_specs_[i].get());
+  }
+
+  // node consistency, and the arcs of the binary constraints
+  std::vector<std::pair<std::size_t, std::size_t> > arcs;
+  std::vector<std::size_t> arc_constraints;
+  std::vector<std::vector<std::size_t> > param_arcs(num_params);
+  for (std::size_t i = 0; i < model.constraints_.size(); ++i) {
+    const std::vector<std::size_t> &pids = checker.get_rel_pids(i);
+    if (pids.size() == 1) {
+      std::size_t pid = pids[0];
+      for (std::size_t vid = 0; vid < model.param_specs_[pid]->get_level(); ++vid) {
+        test[pid] = vid;
+        if (is_alive[pid][vid] && !is_satisfied(*model.constraints_[i], model.param_specs_, test)) {
+          is_alive[pid][vid] = false;
+        }
+      }
+      test[pid] = VID_BOUND;
+    } else if (pids.size() == 2) {
+      // arc 2k revises pids[0] against pids[1], arc 2k + 1 the reverse
+      param_arcs[pids[1]].push_back(arcs.size());
+      arcs.push_back(std::pair<std::size_t, std::size_t>(pids[0], pids[1]));
+      arc_constraints.push_back(i);
+      param_arcs[pids[0]].push_back(arcs.size());
+      arcs.push_back(std::pair<std::size_t, std::size_t>(pids[1], pids[0]));
+      arc_constraints.push_back(i);
+    }
+  }
+
+  // AC-3: an arc is revised again whenever the domain it is against shrinks
+  std::deque<std::size_t> queue;
+  std::vector<bool> is_queued(arcs.size(), true);
+  for (std::size_t i = 0; i < arcs.size(); ++i) {
+    queue.push_back(i);
+  }
+  while (!queue.empty()) {
+    std::size_t arc = queue.front();
+    queue.pop_front();
+    is_queued[arc] = false;
+    ++this->num_revisions_;
+    std::size_t pid = arcs[arc].first, other = arcs[arc].second;
+    const Constraint &constraint = *model.constraints_[arc_constraints[arc]];
+    bool is_changed = false;
+    for (std::size_t vid = 0; vid < model.param_specs_[pid]->get_level(); ++vid) {
+      if (!is_alive[pid][vid]) {
+        continue;
+      }
+      test[pid] = vid;
+      bool is_supported = false;
+      for (std::size_t other_vid = 0; other_vid < is_alive[other].size() && !is_supported; ++other_vid) {
+        if (is_alive[other][other_vid]) {
+          test[other] = other_vid;
+          is_supported = is_satisfied(constraint, model.param_specs_, test);
+        }
+      }
+      test[other] = VID_BOUND;
+      if (!is_supported) {
+        is_alive[pid][vid] = false;
+        is_changed = true;
+      }
+    }
+    test[pid] = VID_BOUND;
+    if (!is_changed) {
+      continue;
+    }
+    for (std::size_t i = 0; i < param_arcs[pid].size(); ++i) {
+      std::size_t next = param_arcs[pid][i];
+      if (!is_queued[next] && arc_constraints[next] != arc_constraints[arc]) {
+        is_queued[next] = true;
+        queue.push_back(next);
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < num_params; ++i) {
+    std::size_t level = model.param_specs_[i]->get_level();
+    bool is_invalid_only = level > 0;
+    for (std::size_t vid = 0; vid < level; ++vid) {
+      is_invalid_only = is_invalid_only && !is_alive[i][vid];
+    }
+    // a parameter left with the invalid value only cannot be specified
+    if (is_invalid_only) {
+      is_reducible[i] = false;
+    }
+  }
+
+  for (std::size_t i = 0; i < num_params; ++i) {
+    std::size_t level = model.param_specs_[i]->get_level();
+    std::vector<std::string> values;
+    this->original_vids_[i].clear();
+    for (std::size_t vid = 0; vid <= level; ++vid) {
+      if (is_alive[i][vid] || !is_reducible[i]) {
+        this->reduced_vids_[i][vid] = this->original_vids_[i].size();
+        this->original_vids_[i].push_back(vid);
+        if (vid < level) {
+          values.push_back(model.param_specs_[i]->get_string_value(vid));
+        }
+      } else {
+        this->reduced_vids_[i][vid] = VID_BOUND;
+        ++this->num_removed_values_;
+      }
+    }
+    if (values.size() < level) {
+      reduced.param_specs_[i] = make_param_spec(*model.param_specs_[i], values);
+    }
+  }
+
+  reduced.seeds_.clear();
+  for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+    const Seed_Tuple *seed_tuple = dynamic_cast<const Seed_Tuple *>(model.seeds_[i].get());
+    if (!seed_tuple) {
+      reduced.seeds_.push_back(model.seeds_[i]);
+      continue;
+    }
+    boost::shared_ptr<Seed_Tuple> reduced_seed(new Seed_Tuple(*seed_tuple));
+    Tuple &tuple = reduced_seed->the_tuple();
+    bool is_removed = false;
+    for (std::size_t j = 0; j < tuple.size() && !is_removed; ++j) {
+      if (tuple[j].pid_ < num_params && tuple[j].vid_ < this->reduced_vids_[tuple[j].pid_].size()) {
+        tuple[j].vid_ = this->reduced_vids_[tuple[j].pid_][tuple[j].vid_];
+        is_removed = tuple[j].vid_ == VID_BOUND;
+      }
+    }
+    if (is_removed) {
+      ++this->num_removed_seeds_;
+    } else {
+      reduced.seeds_.push_back(reduced_seed);
+    }
+  }
+
+  // the weights of the values follow their reduced vids
+  const std::vector<std::vector<double> > &value_weights = model.weights_.get_value_weights();
+  reduced.weights_.Clear();
+  for (std::size_t i = 0; i < model.weights_.get_strength_weights().size(); ++i) {
+    reduced.weights_.set_strength_weight(i, model.weights_.get_strength_weight(i));
+  }
+  for (std::size_t i = 0; i < value_weights.size() && i < num_params; ++i) {
+    for (std::size_t vid = 0; vid < value_weights[i].size() && vid < this->reduced_vids_[i].size(); ++vid) {
+      if (this->reduced_vids_[i][vid] != VID_BOUND) {
+        reduced.weights_.set_value_weight(i, this->reduced_vids_[i][vid], value_weights[i][vid]);
+      }
+    }
+  }
+
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  CoverageMap reduced_coverage(reduced.param_specs_, reduced.strengths_);
+  this->num_removed_combinations_ = coverage.get_num_combinations() - reduced_coverage.get_num_combinations();
+}
+
+bool DomainReducer::ReduceTest(TestCase &test) const {
+  bool tmp_return = true;
+  for (std::size_t i = 0; i < test.size() && i < this->reduced_vids_.size(); ++i) {
+    if (test[i] == VID_BOUND) {
+      continue;
+    }
+    // values out of range are taken as invalid ones
+    std::size_t vid = std::min(test[i], this->reduced_vids_[i].size() - 1);
+    if (this->reduced_vids_[i][vid] == VID_BOUND) {
+      tmp_return = false;
+    } else {
+      test[i] = this->reduced_vids_[i][vid];
+    }
+  }
+  return tmp_return;
+}
+
+void DomainReducer::RestoreTest(TestCase &test) const {
+  for (std::size_t i = 0; i < test.size() && i < this->original_vids_.size(); ++i) {
+    if (test[i] != VID_BOUND) {
+      std::size_t vid = std::min(test[i], this->original_vids_[i].size() - 1);
+      test[i] = this->original_vids_[i][vid];
+    }
+  }
+}
+
+void DomainReducer::RestoreTests(std::vector<TestCase> &tests) const {
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    this->RestoreTest(tests[i]);
+  }
+}
@@ -0,0 +1,91 @@
+//===----- ct_common/common/domain_reducer.h --------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for reducing the domains of SUT models
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_DOMAIN_REDUCER_H_
+#define CT_COMMON_DOMAIN_REDUCER_H_
+
+#include <vector>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for removing the values which no valid test case can take from
+ * the domains of a model. Constraints touching one parameter (see
+ * TreeNode::touch_pids) remove the values violating them (node consistency),
+ * constraints touching two parameters the values without a supporting value
+ * of the other parameter (arc consistency, by AC-3), where the invalid value
+ * of a parameter may support others as in ConstraintChecker. Constraints on
+ * more parameters take no part.
+ *
+ * The reduced model shares the strengths and constraints, whose trees
+ * evaluate against the new parameter specifications, but the vids change:
+ * test cases of the reduced model are mapped back by RestoreTest. Seed tuples
+ * are mapped as well, and dropped if they take removed values. Auto and bool
+ * parameters, and the parameters left with the invalid value only, are kept
+ * as they are.
+ */
+class DLL_EXPORT DomainReducer {
+public:
+  DomainReducer(void);
+  DomainReducer(const DomainReducer &from);
+  DomainReducer &operator = (const DomainReducer &right);
+  ~DomainReducer(void);
+
+  /**
+   * Reduce the domains of a model. If some constraint fails without any
+   * parameter, the reduced model is the model itself.
+   */
+  void Reduce(const SUTModel &model, SUTModel &reduced);
+  /** Map a test case of the model to the reduced one, returns false if it takes a removed value */
+  bool ReduceTest(TestCase &test) const;
+  /** Map a test case of the reduced model back to the model */
+  void RestoreTest(TestCase &test) const;
+  /** Map test cases of the reduced model back to the model */
+  void RestoreTests(std::vector<TestCase> &tests) const;
+
+  /** Get the vid in the model of a vid in the reduced model */
+  std::size_t get_original_vid(std::size_t pid, std::size_t vid) const { return this->original_vids_[pid][vid]; }
+  /** Get the vid in the reduced model of a vid in the model, VID_BOUND if removed */
+  std::size_t get_reduced_vid(std::size_t pid, std::size_t vid) const { return this->reduced_vids_[pid][vid]; }
+  /** Whether the constraints can hold at all */
+  bool is_consistent(void) const { return this->is_consistent_; }
+  /** Get the number of values removed */
+  std::size_t get_num_removed_values(void) const { return this->num_removed_values_; }
+  /** Get the number of values removed of a parameter */
+  std::size_t get_num_removed_values(std::size_t pid) const {
+    return this->reduced_vids_[pid].size() - this->original_vids_[pid].size();
+  }
+  /** Get the number of target combinations removed */
+  std::size_t get_num_removed_combinations(void) const { return this->num_removed_combinations_; }
+  /** Get the number of seeds dropped */
+  std::size_t get_num_removed_seeds(void) const { return this->num_removed_seeds_; }
+  /** Get the number of arcs revised */
+  std::size_t get_num_revisions(void) const { return this->num_revisions_; }
+
+private:
+  /** The vids in the model by the vids in the reduced model, the invalid vid included */
+  std::vector<std::vector<std::size_t> > original_vids_;
+  /** The vids in the reduced model by the vids in the model, the invalid vid included */
+  std::vector<std::vector<std::size_t> > reduced_vids_;
+  bool is_consistent_;  /**< Whether the constraints can hold at all */
+  std::size_t num_removed_values_;  /**< The number of values removed */
+  std::size_t num_removed_combinations_;  /**< The number of target combinations removed */
+  std::size_t num_removed_seeds_;  /**< The number of seeds dropped */
+  std::size_t num_revisions_;  /**< The number of arcs revised */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_DOMAIN_REDUCER_H_
@@ -43,18 +43,18 @@ std::string Exp_A_Binary::class_name(void) {
 EvalType_Double Exp_A_Binary::EvaluateDouble_Impl(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                       const Assignment &assignment) const {
   EvalType_Double tmp_return;
-  if (this->get_loprd()->get_type() == EAT_INT &&
-      this->get_roprd()->get_type() == EAT_INT) {
-    GET_EXP_VAL(EvalType_Int, val_l, this->get_loprd(), param_specs, assignment);
-    GET_EXP_VAL(EvalType_Int, val_r, this->get_roprd(), param_specs, assignment);
+  if (this->get_loprd_ptr()->get_type() == EAT_INT &&
+      this->get_roprd_ptr()->get_type() == EAT_INT) {
+    GET_EXP_VAL(EvalType_Int, val_l, this->get_loprd_ptr(), param_specs, assignment);
+    GET_EXP_VAL(EvalType_Int, val_r, this->get_roprd_ptr(), param_specs, assignment);
     tmp_return.is_valid_ = val_l.is_valid_ && val_r.is_valid_;
     if (tmp_return.is_valid_) {
       tmp_return.value_ = this->evaluate_int(val_l.value_, val_r.value_);
     }
-  } else if (this->get_loprd()->get_type() == EAT_DOUBLE ||
-      this->get_roprd()->get_type() == EAT_DOUBLE) {
-    GET_EXP_VAL(EvalType_Double, val_l, this->get_loprd(), param_specs, assignment);
-    GET_EXP_VAL(EvalType_Double, val_r, this->get_roprd(), param_specs, assignment);
+  } else if (this->get_loprd_ptr()->get_type() == EAT_DOUBLE ||
+      this->get_roprd_ptr()->get_type() == EAT_DOUBLE) {
+    GET_EXP_VAL(EvalType_Double, val_l, this->get_loprd_ptr(), param_specs, assignment);
+    GET_EXP_VAL(EvalType_Double, val_r, this->get_roprd_ptr(), param_specs, assignment);
     tmp_return.is_valid_ = val_l.is_valid_ && val_r.is_valid_;
     if (tmp_return.is_valid_) {
       tmp_return.value_ = this->evaluate_double(val_l.value_, val_r.value_);
@@ -68,18 +68,18 @@ EvalType_Double Exp_A_Binary::EvaluateDouble_Impl(const std::vector<boost::share
 EvalType_Int Exp_A_Binary::EvaluateInt_Impl(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                 const Assignment &assignment) const {
   EvalType_Int tmp_return;
-  if (this->get_loprd()->get_type() == EAT_INT &&
-      this->get_roprd()->get_type() == EAT_INT) {
-    GET_EXP_VAL(EvalType_Int, val_l, this->get_loprd(), param_specs, assignment);
-    GET_EXP_VAL(EvalType_Int, val_r, this->get_roprd(), param_specs, assignment);
+  if (this->get_loprd_ptr()->get_type() == EAT_INT &&
+      this->get_roprd_ptr()->get_type() == EAT_INT) {
+    GET_EXP_VAL(EvalType_Int, val_l, this->get_loprd_ptr(), param_specs, assignment);
+    GET_EXP_VAL(EvalType_Int, val_r, this->get_roprd_ptr(), param_specs, assignment);
     tmp_return.is_valid_ = val_l.is_valid_ && val_r.is_valid_;
     if (tmp_return.is_valid_) {
       tmp_return.value_ = this->evaluate_int(val_l.value_, val_r.value_);
     }
-  } else if (this->get_loprd()->get_type() == EAT_DOUBLE ||
-      this->get_roprd()->get_type() == EAT_DOUBLE) {
-    GET_EXP_VAL(EvalType_Double, val_l, this->get_loprd(), param_specs, assignment);
-    GET_EXP_VAL(EvalType_Double, val_r, this->get_roprd(), param_specs, assignment);
+  } else if (this->get_loprd_ptr()->get_type() == EAT_DOUBLE ||
+      this->get_roprd_ptr()->get_type() == EAT_DOUBLE) {
+    GET_EXP_VAL(EvalType_Double, val_l, this->get_loprd_ptr(), param_specs, assignment);
+    GET_EXP_VAL(EvalType_Double, val_r, this->get_roprd_ptr(), param_specs, assignment);
     tmp_return.is_valid_ = val_l.is_valid_ && val_r.is_valid_;
     if (tmp_return.is_valid_) {
       tmp_return.value_ = (int)this->evaluate_double(val_l.value_, val_r.value_);
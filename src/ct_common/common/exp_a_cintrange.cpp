@@ -0,0 +1,74 @@
+//===----- ct_common/common/exp_a_cintrange.cpp -----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class Exp_A_CIntRange
+//
+//===----------------------------------------------------------------------===//
+
+#include <ct_common/common/exp_a_cintrange.h>
+
+using namespace ct::common;
+
+Exp_A_CIntRange::Exp_A_CIntRange(void)
+    : Exp_A_Atom(), begin_(0), step_(1), num_values_(0) {
+  this->set_type(EAT_INT);
+}
+
+Exp_A_CIntRange::Exp_A_CIntRange(const Exp_A_CIntRange &from)
+  : Exp_A_Atom(from), begin_(from.begin_), step_(from.step_), num_values_(from.num_values_) {
+}
+
+Exp_A_CIntRange &Exp_A_CIntRange::operator = (const Exp_A_CIntRange &right) {
+  Exp_A_Atom::operator=(right);
+  this->begin_ = right.begin_;
+  this->step_ = right.step_;
+  this->num_values_ = right.num_values_;
+  return *this;
+}
+
+Exp_A_CIntRange::~Exp_A_CIntRange(void) {
+}
+
+void Exp_A_CIntRange::set_range(int val_begin, int step, int val_end) {
+  if (step == 0) {
+    CT_EXCEPTION("the step of a range cannot be zero");
+  }
+  this->begin_ = val_begin;
+  this->step_ = step;
+  long long diff = (long long)val_end - val_begin;
+  if ((step > 0 && diff < 0) || (step < 0 && diff > 0)) {
+    this->num_values_ = 0;
+  } else {
+    this->num_values_ = (std::size_t)(diff / step + 1);
+  }
+}
+
+EvalType_Double Exp_A_CIntRange::EvaluateDouble_Impl( const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                                        const Assignment &assignment) const {
+  CT_EXCEPTION("cannot evaluate a range");
+  return EvalType_Double();
+}
+
+EvalType_Int Exp_A_CIntRange::EvaluateInt_Impl( const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                                  const Assignment &assignment) const {
+  CT_EXCEPTION("cannot evaluate a range");
+  return EvalType_Int();
+}
+
+std::string Exp_A_CIntRange::get_class_name(void) const {
+  return Exp_A_CIntRange::class_name();
+}
+
+std::string Exp_A_CIntRange::class_name(void) {
+  return "Exp_A_CIntRange";
+}
+
+void Exp_A_CIntRange::dump(std::ostream &os, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs) const {
+  os << "[" << this->begin_ << ":" << this->step_ << ":"
+     << ((this->num_values_ > 0) ? this->get_value(this->num_values_ - 1) : this->begin_ - this->step_) << "]";
+}
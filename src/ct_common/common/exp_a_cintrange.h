@@ -0,0 +1,69 @@
+//===----- ct_common/common/exp_a_cintrange.h -------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for constant int ranges
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_EXP_A_CINTRANGE_H
+#define CT_COMMON_EXP_A_CINTRANGE_H
+
+#include <ct_common/common/utils.h>
+#include <ct_common/common/exp_a_atom.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for constant int ranges (arithmetic progressions) in parameter
+ * value sets, e.g. [0:2:100]. The values are never materialized here.
+ * Ranges cannot be evaluated, they only appear when assembling parameters.
+ */
+class DLL_EXPORT Exp_A_CIntRange : public Exp_A_Atom {
+public:
+  Exp_A_CIntRange(void);
+  Exp_A_CIntRange(const Exp_A_CIntRange &from);
+  Exp_A_CIntRange &operator = (const Exp_A_CIntRange &right);
+  virtual ~Exp_A_CIntRange(void);
+
+public:
+  virtual std::string get_class_name(void) const;
+  static std::string class_name(void);
+  virtual void dump(std::ostream &os, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs) const;
+
+public:
+  /**
+   * Setting the range from its bounds (both inclusive) and step.
+   * A range with a non-reachable end is empty.
+   */
+  void set_range(int val_begin, int step, int val_end);
+
+  /** Getting the first value */
+  int get_begin(void) const { return this->begin_; }
+  /** Getting the step */
+  int get_step(void) const { return this->step_; }
+  /** Getting the number of values */
+  std::size_t get_num_values(void) const { return this->num_values_; }
+  /** Getting the i-th value */
+  int get_value(std::size_t i) const { return this->begin_ + this->step_ * (int)i; }
+
+private:
+  virtual EvalType_Double EvaluateDouble_Impl( const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                                      const Assignment &assignment) const;
+
+  virtual EvalType_Int EvaluateInt_Impl( const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                                const Assignment &assignment) const;
+
+private:
+  int begin_;  /**< The first value */
+  int step_;  /**< The difference between neighboring values */
+  std::size_t num_values_;  /**< The number of values */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_EXP_A_CINTRANGE_H
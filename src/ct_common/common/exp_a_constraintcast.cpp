@@ -42,14 +42,14 @@ std::string Exp_A_ConstraintCast::class_name(void) {
 EvalType_Double Exp_A_ConstraintCast::EvaluateDouble_Impl(
                       const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                       const Assignment &assignment) const {
-  EvalType_Bool val = this->get_oprd()->Evaluate(param_specs, assignment);
+  EvalType_Bool val = this->get_oprd_ptr()->Evaluate(param_specs, assignment);
   return EvalType_Double(val.value_ ? 1.0 : 0.0, val.is_valid_);
 }
 
 EvalType_Int Exp_A_ConstraintCast::EvaluateInt_Impl(
                       const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                       const Assignment &assignment) const {
-  EvalType_Bool val = this->get_oprd()->Evaluate(param_specs, assignment);
+  EvalType_Bool val = this->get_oprd_ptr()->Evaluate(param_specs, assignment);
   return EvalType_Int(val.value_ ? 1 : 0, val.is_valid_);
 }
 
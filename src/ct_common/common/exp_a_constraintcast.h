@@ -34,6 +34,8 @@ public:
   virtual void dump(std::ostream &os, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs) const;
 
   boost::shared_ptr<Constraint> get_oprd(void) const { return boost::dynamic_pointer_cast<Constraint>(this->oprds_[0]); }
+  /** Get the operand without sharing the ownership, for the evaluation, 0 if not a constraint */
+  const Constraint *get_oprd_ptr(void) const { return dynamic_cast<const Constraint *>(this->oprds_[0].get()); }
   void set_oprd(const boost::shared_ptr<TreeNode> &oprd) { this->oprds_[0] = oprd; }
   
 private:
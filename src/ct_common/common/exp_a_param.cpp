@@ -47,13 +47,13 @@ EvalType_Double Exp_A_Param::EvaluateDouble_Impl(const std::vector<boost::shared
       return tmp_return;
     }
     for (std::size_t i = 0; i < param_specs[this->pid_]->get_auto_value_specs().size(); ++i) {
-      boost::shared_ptr<Constraint> cond = boost::dynamic_pointer_cast<Constraint>(param_specs[this->pid_]->auto_value_specs()[i].first);
+      const Constraint *cond = dynamic_cast<const Constraint *>(param_specs[this->pid_]->get_auto_value_specs()[i].first.get());
       if (cond) {
         EvalType_Bool cond_value;
         cond_value = cond->Evaluate(param_specs, assignment);
         if (cond_value.is_valid_ && cond_value.value_) {
           // condition met, taking the value
-          boost::shared_ptr<Exp_A> val_exp = boost::dynamic_pointer_cast<Exp_A>(param_specs[this->pid_]->auto_value_specs()[i].second);
+          const Exp_A *val_exp = dynamic_cast<const Exp_A *>(param_specs[this->pid_]->get_auto_value_specs()[i].second.get());
           if (val_exp) {
             return val_exp->EvaluateDouble(param_specs, assignment);
           } else {
@@ -75,7 +75,7 @@ EvalType_Double Exp_A_Param::EvaluateDouble_Impl(const std::vector<boost::shared
   if (tmp_return.is_valid_) {
     if (TYPE_CHECK(param_specs[this->pid_].get(), ParamSpec_Int*)) {
       tmp_return.value_ = dynamic_cast<ParamSpec_Int *>(param_specs[this->pid_].get())
-                ->get_int_values()[vid];
+                ->get_int_value(vid);
     } else if (TYPE_CHECK(param_specs[this->pid_].get(), ParamSpec_Double*)) {
       tmp_return.value_ = dynamic_cast<ParamSpec_Double *>(param_specs[this->pid_].get())
                 ->get_double_values()[vid];
@@ -98,13 +98,13 @@ EvalType_Int Exp_A_Param::EvaluateInt_Impl(const std::vector<boost::shared_ptr<P
       return tmp_return;
     }
     for (std::size_t i = 0; i < param_specs[this->pid_]->get_auto_value_specs().size(); ++i) {
-      boost::shared_ptr<Constraint> cond = boost::dynamic_pointer_cast<Constraint>(param_specs[this->pid_]->auto_value_specs()[i].first);
+      const Constraint *cond = dynamic_cast<const Constraint *>(param_specs[this->pid_]->get_auto_value_specs()[i].first.get());
       if (cond) {
         EvalType_Bool cond_value;
         cond_value = cond->Evaluate(param_specs, assignment);
         if (cond_value.is_valid_ && cond_value.value_) {
           // condition met, taking the value
-          boost::shared_ptr<Exp_A> val_exp = boost::dynamic_pointer_cast<Exp_A>(param_specs[this->pid_]->auto_value_specs()[i].second);
+          const Exp_A *val_exp = dynamic_cast<const Exp_A *>(param_specs[this->pid_]->get_auto_value_specs()[i].second.get());
           if (val_exp) {
             return val_exp->EvaluateInt(param_specs, assignment);
           } else {
@@ -126,7 +126,7 @@ EvalType_Int Exp_A_Param::EvaluateInt_Impl(const std::vector<boost::shared_ptr<P
   if (tmp_return.is_valid_) {
     if (TYPE_CHECK(param_specs[this->pid_].get(), ParamSpec_Int*)) {
       tmp_return.value_ = dynamic_cast<ParamSpec_Int *>(param_specs[this->pid_].get())
-                ->get_int_values()[vid];
+                ->get_int_value(vid);
     } else if (TYPE_CHECK(param_specs[this->pid_].get(), ParamSpec_Double*)) {
       tmp_return.value_ = (int)dynamic_cast<ParamSpec_Double *>(param_specs[this->pid_].get())
                 ->get_double_values()[vid];
@@ -41,7 +41,7 @@ std::string Exp_A_Unary::class_name(void) {
 
 EvalType_Double Exp_A_Unary::EvaluateDouble_Impl(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                       const Assignment &assignment) const {
-  GET_EXP_VAL(EvalType_Double, oprd_val, this->get_oprd(), param_specs, assignment);
+  GET_EXP_VAL(EvalType_Double, oprd_val, this->get_oprd_ptr(), param_specs, assignment);
   if (oprd_val.is_valid_) {
     oprd_val.value_ = this->evaluate_double(oprd_val.value_);
   }
@@ -50,7 +50,7 @@ EvalType_Double Exp_A_Unary::EvaluateDouble_Impl(const std::vector<boost::shared
 
 EvalType_Int Exp_A_Unary::EvaluateInt_Impl(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
                                 const Assignment &assignment) const {
-  GET_EXP_VAL(EvalType_Int, oprd_val, this->get_oprd(), param_specs, assignment);
+  GET_EXP_VAL(EvalType_Int, oprd_val, this->get_oprd_ptr(), param_specs, assignment);
   if (oprd_val.is_valid_) {
     oprd_val.value_ = this->evaluate_int(oprd_val.value_);
   }
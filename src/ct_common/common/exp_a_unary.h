@@ -38,6 +38,8 @@ public:
 
 public:
   boost::shared_ptr<const Exp_A> get_oprd(void) const { return boost::dynamic_pointer_cast<Exp_A>(this->oprds_[0]); }
+  /** Get the operand without sharing the ownership, for the evaluation, 0 if not an arithmetic expression */
+  const Exp_A *get_oprd_ptr(void) const { return dynamic_cast<const Exp_A *>(this->oprds_[0].get()); }
 
   void set_oprd(const boost::shared_ptr<TreeNode> &oprd) { this->oprds_[0] = oprd; }
 
@@ -44,12 +44,12 @@ EvalType_String Exp_S_Param::Evaluate(const std::vector<boost::shared_ptr<ParamS
   // FIXME: need to reconsider the logic
   if (param_specs[this->pid_]->is_auto()) {
     for (std::size_t i = 0; i < param_specs[this->pid_]->get_auto_value_specs().size(); ++i) {
-      boost::shared_ptr<Constraint> cond = boost::dynamic_pointer_cast<Constraint>(param_specs[this->pid_]->auto_value_specs()[i].first);
+      const Constraint *cond = dynamic_cast<const Constraint *>(param_specs[this->pid_]->get_auto_value_specs()[i].first.get());
       if (cond) {
         EvalType_Bool cond_value = cond->Evaluate(param_specs, assignment);
         if (cond_value.is_valid_ && cond_value.value_) {
           // condition met, taking the value
-          boost::shared_ptr<Exp_S> val_exp = boost::dynamic_pointer_cast<Exp_S>(param_specs[this->pid_]->auto_value_specs()[i].second);
+          const Exp_S *val_exp = dynamic_cast<const Exp_S *>(param_specs[this->pid_]->get_auto_value_specs()[i].second.get());
           if (val_exp) {
             return val_exp->Evaluate(param_specs, assignment);
           } else {
@@ -21,6 +21,7 @@
 #include <ct_common/common/exp_a_cast.h>
 #include <ct_common/common/exp_a_cdouble.h>
 #include <ct_common/common/exp_a_cint.h>
+#include <ct_common/common/exp_a_cintrange.h>
 #include <ct_common/common/exp_a_constraintcast.h>
 #include <ct_common/common/exp_a_div.h>
 #include <ct_common/common/exp_a_mult.h>
@@ -0,0 +1,346 @@
+//===----- ct_common/common/fault_locator.cpp -------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class FaultLocator
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <boost/cstdint.hpp>
+#include <ct_common/common/fault_locator.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/coverage_kernels.h>
+#include <ct_common/common/test_suite.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/strided_threads.h>
+
+using namespace ct::common;
+
+namespace {
+/** Finds the suspicious combinations of the raw strengths first, first + step, ... */
+struct LocateWorker {
+  void operator () (std::size_t first) const {
+    std::vector<boost::uint64_t> failed_bits, passed_bits;
+    std::vector<std::size_t> strides, levels, counts;
+    for (std::size_t sid = first; sid < this->coverage_->get_num_raw_strengths(); sid += this->step_) {
+      const RawStrength &raw_strength = this->coverage_->get_raw_strength(sid);
+      std::size_t offset = this->coverage_->get_offset(sid);
+      std::size_t num_combinations = this->coverage_->get_offset(sid + 1) - offset;
+      bool has_auto = false;
+      for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+        has_auto = has_auto || (*this->is_auto_)[raw_strength[i]];
+      }
+      if (has_auto || num_combinations == 0) {
+        continue;
+      }
+      strides.resize(raw_strength.size());
+      levels.resize(raw_strength.size());
+      for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+        strides[i] = this->coverage_->get_stride(sid, i);
+        levels[i] = this->coverage_->get_level(raw_strength[i]);
+      }
+      failed_bits.assign((num_combinations + 63) / 64, 0);
+      if (cover_rows(*this->failed_, raw_strength, strides, levels, num_combinations, 0, &failed_bits[0], 0) == 0) {
+        continue;
+      }
+      passed_bits.assign(failed_bits.size(), 0);
+      cover_rows(*this->passed_, raw_strength, strides, levels, num_combinations, 0, &passed_bits[0], 0);
+      bool is_suspicious = false;
+      for (std::size_t i = 0; i < failed_bits.size(); ++i) {
+        failed_bits[i] &= ~passed_bits[i];
+        is_suspicious = is_suspicious || failed_bits[i] != 0;
+      }
+      if (!is_suspicious) {
+        continue;
+      }
+      // count the failed test cases containing each suspicious combination
+      counts.assign(num_combinations, 0);
+      for (std::size_t row = 0; row < this->failed_->get_num_rows(); ++row) {
+        std::size_t local_id = 0;
+        bool is_taken = true;
+        for (std::size_t i = 0; i < raw_strength.size() && is_taken; ++i) {
+          std::size_t vid = this->failed_->Get(row, raw_strength[i]);
+          is_taken = vid < levels[i];
+          local_id += vid * strides[i];
+        }
+        if (is_taken && ((failed_bits[local_id >> 6] >> (local_id & 63)) & 1)) {
+          ++counts[local_id];
+        }
+      }
+      for (std::size_t local_id = 0; local_id < num_combinations; ++local_id) {
+        if (counts[local_id] != 0) {
+          (*this->found_)[first].push_back(std::make_pair(offset + local_id, counts[local_id]));
+        }
+      }
+    }
+  }
+
+  const CoverageMap *coverage_;
+  const TestSuite *failed_;
+  const TestSuite *passed_;
+  const std::vector<bool> *is_auto_;
+  std::vector<std::vector<std::pair<std::size_t, std::size_t> > > *found_;
+  std::size_t step_;
+};
+
+/** Orders the combinations by their sizes, then by their ids */
+struct FoundLess {
+  explicit FoundLess(const CoverageMap &coverage) : coverage_(&coverage) {}
+  bool operator () (const std::pair<std::size_t, std::size_t> &left,
+                    const std::pair<std::size_t, std::size_t> &right) const {
+    std::size_t left_size = this->coverage_->get_raw_strength(this->coverage_->GetRawStrengthId(left.first)).size();
+    std::size_t right_size = this->coverage_->get_raw_strength(this->coverage_->GetRawStrengthId(right.first)).size();
+    return left_size != right_size ? left_size < right_size : left.first < right.first;
+  }
+  const CoverageMap *coverage_;
+};
+
+/** Ranks the suspects by their failed test cases, then by their sizes */
+struct SuspectGreater {
+  bool operator () (const FaultSuspect &left, const FaultSuspect &right) const {
+    return left.num_failed_ != right.num_failed_ ? left.num_failed_ > right.num_failed_ :
+        left.tuple_.size() < right.tuple_.size();
+  }
+};
+
+/** Orders the values of a parameter by the ratios of failures among the test cases taking them */
+struct ValueLess {
+  ValueLess(const std::vector<std::size_t> &failed, const std::vector<std::size_t> &passed)
+      : failed_(&failed), passed_(&passed) {}
+  double get_ratio(std::size_t vid) const {
+    // values never taken rank between the passing and the failing ones
+    return ((*this->failed_)[vid] + 1.0) / ((*this->failed_)[vid] + (*this->passed_)[vid] + 2.0);
+  }
+  bool operator () (std::size_t left, std::size_t right) const {
+    double left_ratio = this->get_ratio(left), right_ratio = this->get_ratio(right);
+    return left_ratio != right_ratio ? left_ratio < right_ratio : left < right;
+  }
+  const std::vector<std::size_t> *failed_;
+  const std::vector<std::size_t> *passed_;
+};
+
+/** Whether a suspect is a proper super-combination of an accepted one */
+bool is_covering_accepted(const Tuple &tuple, const std::set<Tuple> &accepted) {
+  std::size_t num_subsets = (std::size_t(1) << tuple.size()) - 1;
+  Tuple sub_tuple;
+  for (std::size_t mask = 1; mask < num_subsets; ++mask) {
+    sub_tuple.clear();
+    for (std::size_t i = 0; i < tuple.size(); ++i) {
+      if ((mask >> i) & 1) {
+        sub_tuple.push_back(tuple[i]);
+      }
+    }
+    if (accepted.find(sub_tuple) != accepted.end()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/** Whether the assigned cells of a test case complete a suspect of pid other than the skipped one */
+bool is_completing_suspect(const TestCase &test, std::size_t pid, std::size_t skipped,
+                           const std::vector<FaultSuspect> &suspects,
+                           const std::vector<std::vector<std::size_t> > &param_suspects) {
+  const std::vector<std::size_t> &ranks = param_suspects[pid];
+  for (std::size_t i = 0; i < ranks.size(); ++i) {
+    if (ranks[i] == skipped) {
+      continue;
+    }
+    const Tuple &tuple = suspects[ranks[i]].tuple_;
+    bool is_completed = true;
+    for (std::size_t j = 0; j < tuple.size() && is_completed; ++j) {
+      is_completed = test[tuple[j].pid_] == tuple[j].vid_;
+    }
+    if (is_completed) {
+      return true;
+    }
+  }
+  return false;
+}
+}  // namespace
+
+FaultSuspect::FaultSuspect(void)
+    : num_failed_(0), score_(0) {
+}
+
+FaultLocator::FaultLocator(void)
+    : max_strength_(2), num_follow_ups_(0), num_threads_(0), num_failed_(0), num_passed_(0), num_ignored_(0),
+      num_suspicious_(0) {
+}
+
+FaultLocator::FaultLocator(const FaultLocator &from)
+    : max_strength_(from.max_strength_), num_follow_ups_(from.num_follow_ups_), num_threads_(from.num_threads_),
+      suspects_(from.suspects_), follow_ups_(from.follow_ups_), follow_up_ranks_(from.follow_up_ranks_),
+      num_failed_(from.num_failed_), num_passed_(from.num_passed_), num_ignored_(from.num_ignored_),
+      num_suspicious_(from.num_suspicious_) {
+}
+
+FaultLocator &FaultLocator::operator = (const FaultLocator &right) {
+  this->max_strength_ = right.max_strength_;
+  this->num_follow_ups_ = right.num_follow_ups_;
+  this->num_threads_ = right.num_threads_;
+  this->suspects_ = right.suspects_;
+  this->follow_ups_ = right.follow_ups_;
+  this->follow_up_ranks_ = right.follow_up_ranks_;
+  this->num_failed_ = right.num_failed_;
+  this->num_passed_ = right.num_passed_;
+  this->num_ignored_ = right.num_ignored_;
+  this->num_suspicious_ = right.num_suspicious_;
+  return *this;
+}
+
+FaultLocator::~FaultLocator(void) {
+}
+
+void FaultLocator::Analyze(const SUTModel &model, const std::vector<TestCase> &tests,
+                           const std::vector<bool> &is_failed) {
+  if (is_failed.size() != tests.size()) {
+    CT_EXCEPTION("the numbers of test cases and verdicts differ");
+  }
+  this->suspects_.clear();
+  this->follow_ups_.clear();
+  this->follow_up_ranks_.clear();
+  this->num_failed_ = 0;
+  this->num_passed_ = 0;
+  this->num_ignored_ = 0;
+  this->num_suspicious_ = 0;
+
+  std::size_t num_params = model.param_specs_.size();
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  std::vector<bool> is_auto(num_params);
+  std::vector<std::size_t> pids(num_params);
+  for (std::size_t i = 0; i < num_params; ++i) {
+    is_auto[i] = model.param_specs_[i]->is_auto();
+    pids[i] = i;
+  }
+  std::vector<Strength> strengths;
+  for (std::size_t t = 1; t <= std::min(this->max_strength_, num_params); ++t) {
+    strengths.push_back(Strength(pids, t));
+  }
+  CoverageMap coverage(model.param_specs_, strengths);
+
+  // split the valid test cases by their verdicts, counting the values of each side
+  TestSuite failed(model.param_specs_), passed(model.param_specs_);
+  std::vector<std::vector<std::size_t> > value_failed(num_params), value_passed(num_params);
+  for (std::size_t i = 0; i < num_params; ++i) {
+    value_failed[i].assign(model.param_specs_[i]->get_level(), 0);
+    value_passed[i].assign(model.param_specs_[i]->get_level(), 0);
+  }
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    bool is_complete = tests[i].size() == num_params;
+    for (std::size_t j = 0; j < tests[i].size() && is_complete; ++j) {
+      is_complete = is_auto[j] || tests[i][j] <= model.param_specs_[j]->get_invalid_vid();
+    }
+    if (!is_complete || !checker.IsValid(tests[i])) {
+      ++this->num_ignored_;
+      continue;
+    }
+    (is_failed[i] ? failed : passed).AppendRow(tests[i]);
+    std::vector<std::vector<std::size_t> > &value_counts = is_failed[i] ? value_failed : value_passed;
+    for (std::size_t j = 0; j < num_params; ++j) {
+      if (!is_auto[j] && tests[i][j] < value_counts[j].size()) {
+        ++value_counts[j][tests[i][j]];
+      }
+    }
+  }
+  this->num_failed_ = failed.get_num_rows();
+  this->num_passed_ = passed.get_num_rows();
+  if (this->num_failed_ == 0) {
+    return;
+  }
+
+  std::size_t num_sids = coverage.get_num_raw_strengths();
+  std::size_t num_threads = resolve_num_threads(this->num_threads_, num_sids);
+  std::vector<std::vector<std::pair<std::size_t, std::size_t> > > found(num_threads);
+  LocateWorker worker;
+  worker.coverage_ = &coverage;
+  worker.failed_ = &failed;
+  worker.passed_ = &passed;
+  worker.is_auto_ = &is_auto;
+  worker.found_ = &found;
+  worker.step_ = num_threads;
+  run_strided(num_threads, worker);
+
+  // keep the suspicious combinations with no suspicious proper sub-combination
+  std::vector<std::pair<std::size_t, std::size_t> > combinations;
+  for (std::size_t i = 0; i < found.size(); ++i) {
+    combinations.insert(combinations.end(), found[i].begin(), found[i].end());
+  }
+  this->num_suspicious_ = combinations.size();
+  std::sort(combinations.begin(), combinations.end(), FoundLess(coverage));
+  std::set<Tuple> accepted;
+  for (std::size_t i = 0; i < combinations.size(); ++i) {
+    FaultSuspect suspect;
+    suspect.tuple_ = coverage.GetTuple(combinations[i].first);
+    suspect.tuple_.Sort();
+    if (is_covering_accepted(suspect.tuple_, accepted)) {
+      continue;
+    }
+    accepted.insert(suspect.tuple_);
+    suspect.num_failed_ = combinations[i].second;
+    suspect.score_ = double(suspect.num_failed_) / this->num_failed_;
+    this->suspects_.push_back(suspect);
+  }
+  std::stable_sort(this->suspects_.begin(), this->suspects_.end(), SuspectGreater());
+
+  // make the follow-ups, the other parameters taking the least failing values completing no other suspect
+  std::size_t num_follow_ups = std::min(this->num_follow_ups_, this->suspects_.size());
+  if (num_follow_ups == 0) {
+    return;
+  }
+  std::vector<std::vector<std::size_t> > param_suspects(num_params), value_orders(num_params);
+  for (std::size_t rank = 0; rank < this->suspects_.size(); ++rank) {
+    const Tuple &tuple = this->suspects_[rank].tuple_;
+    for (std::size_t i = 0; i < tuple.size(); ++i) {
+      param_suspects[tuple[i].pid_].push_back(rank);
+    }
+  }
+  for (std::size_t i = 0; i < num_params; ++i) {
+    for (std::size_t vid = 0; vid < value_failed[i].size() && !is_auto[i]; ++vid) {
+      value_orders[i].push_back(vid);
+    }
+    std::sort(value_orders[i].begin(), value_orders[i].end(), ValueLess(value_failed[i], value_passed[i]));
+  }
+  for (std::size_t rank = 0; rank < num_follow_ups; ++rank) {
+    const Tuple &tuple = this->suspects_[rank].tuple_;
+    TestCase test = checker.MakeEmptyTest();
+    for (std::size_t i = 0; i < tuple.size(); ++i) {
+      test[tuple[i].pid_] = tuple[i].vid_;
+    }
+    bool is_valid = true;
+    for (std::size_t pid = 0; pid < num_params && is_valid; ++pid) {
+      if (test[pid] != VID_BOUND) {
+        continue;
+      }
+      std::size_t chosen = VID_BOUND;
+      const std::vector<std::size_t> &vids = value_orders[pid];
+      for (std::size_t i = 0; i < vids.size(); ++i) {
+        test[pid] = vids[i];
+        if (!checker.IsExtendable(test, pid)) {
+          continue;
+        }
+        if (!is_completing_suspect(test, pid, rank, this->suspects_, param_suspects)) {
+          chosen = vids[i];
+          break;
+        }
+        // completing another suspect is only a fallback
+        if (chosen == VID_BOUND) {
+          chosen = vids[i];
+        }
+      }
+      test[pid] = chosen;
+      is_valid = chosen != VID_BOUND;
+    }
+    if (is_valid && checker.IsValid(test)) {
+      this->follow_ups_.push_back(test);
+      this->follow_up_ranks_.push_back(rank);
+    }
+  }
+}
@@ -0,0 +1,109 @@
+//===----- ct_common/common/fault_locator.h ---------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for locating the failure-inducing
+// combinations of executed test suites
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_FAULT_LOCATOR_H_
+#define CT_COMMON_FAULT_LOCATOR_H_
+
+#include <vector>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+#include <ct_common/common/tuple.h>
+
+namespace ct {
+namespace common {
+/**
+ * A combination suspected to induce failures
+ */
+struct DLL_EXPORT FaultSuspect {
+  FaultSuspect(void);
+
+  Tuple tuple_;  /**< The combination, sorted by pids */
+  std::size_t num_failed_;  /**< The number of failed test cases containing it */
+  double score_;  /**< The ratio of the failed test cases containing it */
+};
+
+/**
+ * The class for locating the failure-inducing combinations of a suite of
+ * executed test cases, from the verdict of each test case. All combinations
+ * of 1 to max_strength parameters are considered, except those with auto
+ * parameters. A combination is suspicious if some failed test case contains
+ * it and no passed one does: for each raw strength, the bitmap of the
+ * combinations of the failed test cases is masked by the one of the passed
+ * test cases, both taken by the kernels of CoverageVerifier, and the raw
+ * strengths are processed in parallel. The suspects are the suspicious
+ * combinations of which no proper sub-combination is suspicious, ranked by
+ * the number of failed test cases containing them, then by their sizes.
+ *
+ * Optionally, a follow-up test case is made for each of the top suspects:
+ * it contains the suspect, and takes for the other parameters the values
+ * least involved in failures that complete no other suspect, so that its
+ * verdict confirms or clears the suspect alone. Appending the executed
+ * follow-ups to the suite and analyzing again refines the suspects.
+ * Incomplete test cases and test cases violating the constraints are
+ * ignored.
+ */
+class DLL_EXPORT FaultLocator {
+public:
+  FaultLocator(void);
+  FaultLocator(const FaultLocator &from);
+  FaultLocator &operator = (const FaultLocator &right);
+  ~FaultLocator(void);
+
+  /** Locate the suspects of executed test cases of the model, by whether each test case failed */
+  void Analyze(const SUTModel &model, const std::vector<TestCase> &tests, const std::vector<bool> &is_failed);
+
+  /** Set the largest size of the combinations considered */
+  void set_max_strength(std::size_t max_strength) { this->max_strength_ = max_strength; }
+  /** Get the largest size of the combinations considered */
+  std::size_t get_max_strength(void) const { return this->max_strength_; }
+  /** Set the number of top suspects to make follow-up test cases for, 0 for none */
+  void set_num_follow_ups(std::size_t num_follow_ups) { this->num_follow_ups_ = num_follow_ups; }
+  /** Get the number of top suspects to make follow-up test cases for */
+  std::size_t get_num_follow_ups(void) const { return this->num_follow_ups_; }
+  /** Set the number of threads, 0 for the number of hardware threads */
+  void set_num_threads(std::size_t num_threads) { this->num_threads_ = num_threads; }
+  /** Get the number of threads */
+  std::size_t get_num_threads(void) const { return this->num_threads_; }
+
+  /** Get the ranked suspects of the last analysis */
+  const std::vector<FaultSuspect> &get_suspects(void) const { return this->suspects_; }
+  /** Get the follow-up test cases of the last analysis */
+  const std::vector<TestCase> &get_follow_ups(void) const { return this->follow_ups_; }
+  /** Get the ranks of the suspects of the follow-up test cases */
+  const std::vector<std::size_t> &get_follow_up_ranks(void) const { return this->follow_up_ranks_; }
+  /** Get the number of failed test cases analyzed */
+  std::size_t get_num_failed(void) const { return this->num_failed_; }
+  /** Get the number of passed test cases analyzed */
+  std::size_t get_num_passed(void) const { return this->num_passed_; }
+  /** Get the number of test cases ignored as incomplete or invalid */
+  std::size_t get_num_ignored(void) const { return this->num_ignored_; }
+  /** Get the number of suspicious combinations, the suspects included */
+  std::size_t get_num_suspicious(void) const { return this->num_suspicious_; }
+
+private:
+  std::size_t max_strength_;  /**< The largest size of the combinations considered */
+  std::size_t num_follow_ups_;  /**< The number of top suspects to make follow-up test cases for */
+  std::size_t num_threads_;  /**< The number of threads, 0 for the number of hardware threads */
+  std::vector<FaultSuspect> suspects_;  /**< The ranked suspects */
+  std::vector<TestCase> follow_ups_;  /**< The follow-up test cases */
+  std::vector<std::size_t> follow_up_ranks_;  /**< The ranks of the suspects of the follow-ups */
+  std::size_t num_failed_;  /**< The number of failed test cases analyzed */
+  std::size_t num_passed_;  /**< The number of passed test cases analyzed */
+  std::size_t num_ignored_;  /**< The number of test cases ignored */
+  std::size_t num_suspicious_;  /**< The number of suspicious combinations */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_FAULT_LOCATOR_H_
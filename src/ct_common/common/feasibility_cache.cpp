@@ -0,0 +1,70 @@
+//===----- ct_common/common/feasibility_cache.cpp ---------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class FeasibilityCache
+//
+//===----------------------------------------------------------------------===//
+
+#include <ct_common/common/feasibility_cache.h>
+
+using namespace ct::common;
+
+FeasibilityCache::FeasibilityCache(const ConstraintChecker &checker, const ModelSymmetry &symmetry)
+    : checker_(&checker), symmetry_(&symmetry), test_(checker.MakeEmptyTest()), num_queries_(0), num_searches_(0) {
+}
+
+FeasibilityCache::FeasibilityCache(const FeasibilityCache &from)
+    : checker_(from.checker_), symmetry_(from.symmetry_), test_(from.test_), tuple_(from.tuple_),
+      results_(from.results_), num_queries_(from.num_queries_), num_searches_(from.num_searches_) {
+}
+
+FeasibilityCache &FeasibilityCache::operator = (const FeasibilityCache &right) {
+  this->checker_ = right.checker_;
+  this->symmetry_ = right.symmetry_;
+  this->test_ = right.test_;
+  this->tuple_ = right.tuple_;
+  this->results_ = right.results_;
+  this->num_queries_ = right.num_queries_;
+  this->num_searches_ = right.num_searches_;
+  return *this;
+}
+
+FeasibilityCache::~FeasibilityCache(void) {
+}
+
+bool FeasibilityCache::IsFeasible(const RawStrength &pids, const std::vector<std::size_t> &vids) {
+  ++this->num_queries_;
+  this->tuple_.clear();
+  for (std::size_t i = 0; i < pids.size(); ++i) {
+    this->tuple_.push_back(PVPair(pids[i], vids[i]));
+  }
+  bool is_cached = !this->symmetry_->is_trivial();
+  if (is_cached) {
+    this->symmetry_->Canonicalize(this->tuple_);
+    boost::unordered_map<Tuple, bool, TupleHasher>::const_iterator iter = this->results_.find(this->tuple_);
+    if (iter != this->results_.end()) {
+      return iter->second;
+    }
+  }
+  ++this->num_searches_;
+  // the canonical form is equivalent to the combination itself
+  for (std::size_t i = 0; i < this->tuple_.size(); ++i) {
+    this->test_[this->tuple_[i].pid_] = this->tuple_[i].vid_;
+  }
+  bool tmp_return = true;
+  for (std::size_t i = 0; i < this->tuple_.size() && tmp_return; ++i) {
+    tmp_return = this->checker_->IsExtendable(this->test_, this->tuple_[i].pid_);
+  }
+  for (std::size_t i = 0; i < this->tuple_.size(); ++i) {
+    this->test_[this->tuple_[i].pid_] = VID_BOUND;
+  }
+  if (is_cached) {
+    this->results_[this->tuple_] = tmp_return;
+  }
+  return tmp_return;
+}
@@ -0,0 +1,61 @@
+//===----- ct_common/common/feasibility_cache.h -----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for checking combinations up to the
+// symmetries of models
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_FEASIBILITY_CACHE_H_
+#define CT_COMMON_FEASIBILITY_CACHE_H_
+
+#include <vector>
+#include <boost/unordered_map.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/strength.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/model_symmetry.h>
+#include <ct_common/common/tuplepool.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for checking whether combinations can be extended to valid test
+ * cases, the results being cached by the canonical forms of the combinations
+ * under the symmetries of the model, so that each orbit is searched once.
+ * Without symmetries nothing is cached. The checker and the symmetry are
+ * weak pointers, and a cache is not to be shared among threads.
+ */
+class DLL_EXPORT FeasibilityCache {
+public:
+  FeasibilityCache(const ConstraintChecker &checker, const ModelSymmetry &symmetry);
+  FeasibilityCache(const FeasibilityCache &from);
+  FeasibilityCache &operator = (const FeasibilityCache &right);
+  ~FeasibilityCache(void);
+
+  /** Whether parameters pids taking values vids can be extended to a valid test case */
+  bool IsFeasible(const RawStrength &pids, const std::vector<std::size_t> &vids);
+
+  /** Get the number of combinations checked */
+  std::size_t get_num_queries(void) const { return this->num_queries_; }
+  /** Get the number of combinations searched by the checker, the others being found in the cache */
+  std::size_t get_num_searches(void) const { return this->num_searches_; }
+
+private:
+  const ConstraintChecker *checker_;  /**< The checker of the model */
+  const ModelSymmetry *symmetry_;  /**< The symmetries of the model */
+  TestCase test_;  /**< The empty test case to assign the combinations in */
+  Tuple tuple_;  /**< The combination being checked */
+  boost::unordered_map<Tuple, bool, TupleHasher> results_;  /**< The results of the canonical forms */
+  std::size_t num_queries_;  /**< The number of combinations checked */
+  std::size_t num_searches_;  /**< The number of combinations searched */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_FEASIBILITY_CACHE_H_
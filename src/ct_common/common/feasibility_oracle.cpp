@@ -0,0 +1,255 @@
+//===----- ct_common/common/feasibility_oracle.cpp --------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class FeasibilityOracle
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <map>
+#include <ct_common/common/feasibility_oracle.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/feasibility_cache.h>
+#include <ct_common/common/model_symmetry.h>
+#include <ct_common/common/tree_decomposition.h>
+#include <ct_common/common/strided_threads.h>
+
+using namespace ct::common;
+
+namespace {
+/** The feasibility of the combinations of some parameters of a component */
+struct Projection {
+  std::vector<std::size_t> strides_;  /**< The strides of the parameters, by pids */
+  std::vector<unsigned char> table_;  /**< Whether each combination is feasible */
+};
+
+/** Decides the raw strengths first, first + step, ... */
+struct OracleWorker {
+  void operator () (std::size_t first) const {
+    FeasibilityCache feasibility(*this->checker_, *this->symmetry_);
+    TestCase test = this->checker_->MakeEmptyTest();
+    std::vector<std::size_t> positions(this->checker_->get_num_params(), 0);
+    std::map<std::vector<std::size_t>, Projection> projections;
+    std::vector<std::size_t> vids, component_ids, kept;
+    std::vector<std::vector<std::size_t> > groups;
+    std::vector<const Projection *> found;
+    for (std::size_t sid = first; sid < this->coverage_->get_num_raw_strengths(); sid += this->step_) {
+      const RawStrength &raw_strength = this->coverage_->get_raw_strength(sid);
+      std::size_t offset = this->coverage_->get_offset(sid);
+      std::size_t num_combinations = this->coverage_->get_offset(sid + 1) - offset;
+      std::vector<boost::uint64_t> &bits = (*this->bits_)[sid];
+      bits.assign((num_combinations + 63) / 64, 0);
+      // the positions of the constrained parameters, grouped by components
+      bool has_auto = false;
+      component_ids.clear();
+      groups.clear();
+      for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+        has_auto = has_auto || (*this->is_auto_)[raw_strength[i]];
+        if (this->checker_->get_param_constraints(raw_strength[i]).empty()) {
+          continue;
+        }
+        std::size_t component_id = this->checker_->get_component(raw_strength[i])[0];
+        std::size_t j = std::find(component_ids.begin(), component_ids.end(), component_id) - component_ids.begin();
+        if (j == component_ids.size()) {
+          component_ids.push_back(component_id);
+          groups.push_back(std::vector<std::size_t>());
+        }
+        groups[j].push_back(i);
+      }
+      if (has_auto) {
+        continue;
+      }
+      // project each component onto its parameters, searching the combinations if too wide
+      bool is_projected = true;
+      found.clear();
+      for (std::size_t i = 0; i < groups.size() && is_projected; ++i) {
+        kept.clear();
+        for (std::size_t j = 0; j < groups[i].size(); ++j) {
+          kept.push_back(raw_strength[groups[i][j]]);
+        }
+        std::map<std::vector<std::size_t>, Projection>::iterator iter = projections.find(kept);
+        if (iter == projections.end()) {
+          is_projected = this->project(kept, positions, test, projections[kept]);
+          iter = projections.find(kept);
+          if (!is_projected) {
+            projections.erase(iter);
+            continue;
+          }
+        }
+        found.push_back(&iter->second);
+      }
+      std::size_t num_feasible = 0;
+      for (std::size_t local_id = 0; local_id < num_combinations; ++local_id) {
+        this->coverage_->GetValues(offset + local_id, vids);
+        bool is_feasible = true;
+        if (!is_projected) {
+          is_feasible = feasibility.IsFeasible(raw_strength, vids);
+        }
+        for (std::size_t i = 0; i < found.size() && is_feasible && is_projected; ++i) {
+          std::size_t index = 0;
+          for (std::size_t j = 0; j < groups[i].size(); ++j) {
+            index += vids[groups[i][j]] * found[i]->strides_[j];
+          }
+          is_feasible = found[i]->table_[index] != 0;
+        }
+        if (is_feasible) {
+          bits[local_id >> 6] |= boost::uint64_t(1) << (local_id & 63);
+          ++num_feasible;
+        }
+      }
+      (*this->num_feasible_)[sid] = num_feasible;
+    }
+    (*this->num_searches_)[first] = feasibility.get_num_searches();
+    (*this->num_projections_)[first] = projections.size();
+  }
+
+  /** Project the component of some parameters onto them, returns false if too wide */
+  bool project(const std::vector<std::size_t> &kept, std::vector<std::size_t> &positions, TestCase &test,
+               Projection &projection) const {
+    TreeDecomposition decomposition;
+    BagTable<unsigned char> table;
+    try {
+      decompose_component(*this->checker_, this->checker_->get_component(kept[0]), ELIMINATION_MIN_FILL,
+                          positions, decomposition, &kept);
+      project_component(*this->model_, *this->checker_, decomposition, positions, *this->domains_,
+                        this->max_table_size_, kept.size(), test, table);
+    } catch (std::exception &) {
+      return false;
+    }
+    // the table is over the kept parameters in the elimination order
+    projection.strides_.resize(kept.size());
+    std::size_t stride = 1;
+    for (std::size_t i = table.pids_.size(); i-- > 0;) {
+      std::size_t j = std::find(kept.begin(), kept.end(), table.pids_[i]) - kept.begin();
+      projection.strides_[j] = stride;
+      stride *= (*this->domains_)[table.pids_[i]].size();
+    }
+    projection.table_.swap(table.table_);
+    return true;
+  }
+
+  const SUTModel *model_;
+  const ConstraintChecker *checker_;
+  const ModelSymmetry *symmetry_;
+  const CoverageMap *coverage_;
+  const std::vector<bool> *is_auto_;
+  const std::vector<std::vector<std::size_t> > *domains_;
+  std::size_t max_table_size_;
+  std::vector<std::vector<boost::uint64_t> > *bits_;
+  std::vector<std::size_t> *num_feasible_;
+  std::vector<std::size_t> *num_searches_;
+  std::vector<std::size_t> *num_projections_;
+  std::size_t step_;
+};
+}  // namespace
+
+FeasibilityOracle::FeasibilityOracle(void)
+    : num_threads_(0), max_table_size_(1 << 22), use_symmetry_(true), offsets_(1, 0), num_feasible_(0),
+      num_projections_(0), num_searches_(0) {
+}
+
+FeasibilityOracle::FeasibilityOracle(const FeasibilityOracle &from)
+    : num_threads_(from.num_threads_), max_table_size_(from.max_table_size_), use_symmetry_(from.use_symmetry_),
+      raw_strengths_(from.raw_strengths_), offsets_(from.offsets_), bits_(from.bits_),
+      sid_num_feasible_(from.sid_num_feasible_), num_feasible_(from.num_feasible_),
+      num_projections_(from.num_projections_), num_searches_(from.num_searches_) {
+}
+
+FeasibilityOracle &FeasibilityOracle::operator = (const FeasibilityOracle &right) {
+  this->num_threads_ = right.num_threads_;
+  this->max_table_size_ = right.max_table_size_;
+  this->use_symmetry_ = right.use_symmetry_;
+  this->raw_strengths_ = right.raw_strengths_;
+  this->offsets_ = right.offsets_;
+  this->bits_ = right.bits_;
+  this->sid_num_feasible_ = right.sid_num_feasible_;
+  this->num_feasible_ = right.num_feasible_;
+  this->num_projections_ = right.num_projections_;
+  this->num_searches_ = right.num_searches_;
+  return *this;
+}
+
+FeasibilityOracle::~FeasibilityOracle(void) {
+}
+
+void FeasibilityOracle::Compute(const SUTModel &model) {
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  std::size_t num_sids = coverage.get_num_raw_strengths();
+  this->raw_strengths_.resize(num_sids);
+  this->offsets_.resize(num_sids + 1);
+  for (std::size_t sid = 0; sid < num_sids; ++sid) {
+    this->raw_strengths_[sid] = coverage.get_raw_strength(sid);
+    this->offsets_[sid] = coverage.get_offset(sid);
+  }
+  this->offsets_[num_sids] = coverage.get_num_combinations();
+  this->bits_.assign(num_sids, std::vector<boost::uint64_t>());
+  this->sid_num_feasible_.assign(num_sids, 0);
+  this->num_feasible_ = 0;
+  this->num_projections_ = 0;
+  this->num_searches_ = 0;
+  if (!checker.IsValid(checker.MakeEmptyTest())) {
+    // some constraint fails without any parameter
+    for (std::size_t sid = 0; sid < num_sids; ++sid) {
+      this->bits_[sid].assign((this->offsets_[sid + 1] - this->offsets_[sid] + 63) / 64, 0);
+    }
+    return;
+  }
+  std::vector<bool> is_auto(model.param_specs_.size());
+  std::vector<std::vector<std::size_t> > domains(model.param_specs_.size());
+  for (std::size_t i = 0; i < model.param_specs_.size(); ++i) {
+    is_auto[i] = model.param_specs_[i]->is_auto();
+    // the other parameters may take the invalid value, as in ConstraintChecker::search
+    for (std::size_t vid = 0; vid <= model.param_specs_[i]->get_level() && !is_auto[i]; ++vid) {
+      domains[i].push_back(vid);
+    }
+  }
+  ModelSymmetry symmetry;
+  if (this->use_symmetry_) {
+    symmetry.Detect(model);
+  }
+
+  std::size_t num_threads = resolve_num_threads(this->num_threads_, num_sids);
+  std::vector<std::size_t> num_searches(num_threads, 0), num_projections(num_threads, 0);
+  OracleWorker worker;
+  worker.model_ = &model;
+  worker.checker_ = &checker;
+  worker.symmetry_ = &symmetry;
+  worker.coverage_ = &coverage;
+  worker.is_auto_ = &is_auto;
+  worker.domains_ = &domains;
+  worker.max_table_size_ = this->max_table_size_;
+  worker.bits_ = &this->bits_;
+  worker.num_feasible_ = &this->sid_num_feasible_;
+  worker.num_searches_ = &num_searches;
+  worker.num_projections_ = &num_projections;
+  worker.step_ = num_threads;
+  run_strided(num_threads, worker);
+  for (std::size_t sid = 0; sid < num_sids; ++sid) {
+    this->num_feasible_ += this->sid_num_feasible_[sid];
+  }
+  for (std::size_t i = 0; i < num_threads; ++i) {
+    this->num_projections_ += num_projections[i];
+    this->num_searches_ += num_searches[i];
+  }
+}
+
+bool FeasibilityOracle::IsMatching(const CoverageMap &coverage) const {
+  bool tmp_return = coverage.get_num_raw_strengths() == this->raw_strengths_.size() &&
+      coverage.get_num_combinations() == this->get_num_combinations();
+  for (std::size_t sid = 0; sid < this->raw_strengths_.size() && tmp_return; ++sid) {
+    tmp_return = coverage.get_raw_strength(sid) == this->raw_strengths_[sid] &&
+        coverage.get_offset(sid) == this->offsets_[sid];
+  }
+  return tmp_return;
+}
+
+bool FeasibilityOracle::IsFeasible(std::size_t cid) const {
+  std::size_t sid = std::upper_bound(this->offsets_.begin(), this->offsets_.end(), cid) - this->offsets_.begin() - 1;
+  return this->IsFeasible(sid, cid - this->offsets_[sid]);
+}
@@ -0,0 +1,102 @@
+//===----- ct_common/common/feasibility_oracle.h ----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for deciding the feasibility of all
+// target combinations of SUT models
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_FEASIBILITY_ORACLE_H_
+#define CT_COMMON_FEASIBILITY_ORACLE_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/strength.h>
+#include <ct_common/common/coverage_map.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for deciding once which target combinations of a model can be
+ * extended to valid test cases, so that generators and verifiers look them
+ * up instead of searching again. The combinations are those of the
+ * CoverageMap of the model, each raw strength with a bitmap indexed by the
+ * ids of its combinations relative to its offset.
+ *
+ * The raw strengths are decided in parallel. The parameters of a raw
+ * strength in the same constraint component are decided together, by
+ * eliminating the other parameters of the component (see project_component)
+ * into a table over all their combinations, which is shared with the other
+ * raw strengths of the thread on the same parameters. The eliminated
+ * parameters may take the invalid value, as in the search of the checker.
+ * Unconstrained parameters take no part, and combinations involving auto
+ * parameters are infeasible. Raw strengths whose tables would be too large are searched
+ * combination by combination with a FeasibilityCache instead.
+ */
+class DLL_EXPORT FeasibilityOracle {
+public:
+  FeasibilityOracle(void);
+  FeasibilityOracle(const FeasibilityOracle &from);
+  FeasibilityOracle &operator = (const FeasibilityOracle &right);
+  ~FeasibilityOracle(void);
+
+  /** Decide the feasibility of all target combinations of a model */
+  void Compute(const SUTModel &model);
+  /** Whether the oracle is computed for the combinations of a coverage map */
+  bool IsMatching(const CoverageMap &coverage) const;
+  /** Whether a combination is feasible, by its raw strength and its id relative to the offset */
+  bool IsFeasible(std::size_t sid, std::size_t local_id) const {
+    return (this->bits_[sid][local_id >> 6] >> (local_id & 63)) & 1;
+  }
+  /** Whether a combination is feasible, by its id in the coverage map */
+  bool IsFeasible(std::size_t cid) const;
+
+  /** Set the number of threads, 0 for the number of hardware threads */
+  void set_num_threads(std::size_t num_threads) { this->num_threads_ = num_threads; }
+  /** Get the number of threads */
+  std::size_t get_num_threads(void) const { return this->num_threads_; }
+  /** Set the largest number of entries of a table, beyond which the combinations are searched */
+  void set_max_table_size(std::size_t max_table_size) { this->max_table_size_ = max_table_size; }
+  /** Get the largest number of entries of a table */
+  std::size_t get_max_table_size(void) const { return this->max_table_size_; }
+  /** Set whether the combinations left to the search are searched up to the symmetries of the model */
+  void set_use_symmetry(bool use_symmetry) { this->use_symmetry_ = use_symmetry; }
+  /** Get whether the combinations left to the search are searched up to the symmetries of the model */
+  bool get_use_symmetry(void) const { return this->use_symmetry_; }
+
+  /** Get the number of raw strengths */
+  std::size_t get_num_raw_strengths(void) const { return this->raw_strengths_.size(); }
+  /** Get the number of target combinations */
+  std::size_t get_num_combinations(void) const { return this->offsets_.back(); }
+  /** Get the number of feasible combinations */
+  std::size_t get_num_feasible(void) const { return this->num_feasible_; }
+  /** Get the number of feasible combinations of a raw strength */
+  std::size_t get_num_feasible(std::size_t sid) const { return this->sid_num_feasible_[sid]; }
+  /** Get the number of tables computed */
+  std::size_t get_num_projections(void) const { return this->num_projections_; }
+  /** Get the number of combinations searched by the checker */
+  std::size_t get_num_searches(void) const { return this->num_searches_; }
+
+private:
+  std::size_t num_threads_;  /**< The number of threads, 0 for the number of hardware threads */
+  std::size_t max_table_size_;  /**< The largest number of entries of a table */
+  bool use_symmetry_;  /**< Whether the combinations are searched up to symmetries */
+  std::vector<RawStrength> raw_strengths_;  /**< The raw strengths of the coverage map */
+  std::vector<std::size_t> offsets_;  /**< The first combination ids, with the total number in the back */
+  std::vector<std::vector<boost::uint64_t> > bits_;  /**< The feasibility bitmaps of the raw strengths */
+  std::vector<std::size_t> sid_num_feasible_;  /**< The numbers of feasible combinations of the raw strengths */
+  std::size_t num_feasible_;  /**< The number of feasible combinations */
+  std::size_t num_projections_;  /**< The number of tables computed */
+  std::size_t num_searches_;  /**< The number of combinations searched */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_FEASIBILITY_ORACLE_H_
@@ -0,0 +1,190 @@
+//===----- ct_common/common/galois_field.cpp --------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class GaloisField
+//
+//===----------------------------------------------------------------------===//
+
+#include <ct_common/common/galois_field.h>
+
+using namespace ct::common;
+
+const std::size_t GaloisField::MAX_ORDER;
+
+namespace {
+typedef std::vector<std::size_t> Poly;  /**< Coefficients over GF(p), constant first */
+
+Poly to_poly(std::size_t a, std::size_t prime, std::size_t size) {
+  Poly tmp_return(size, 0);
+  for (std::size_t i = 0; i < size; ++i) {
+    tmp_return[i] = a % prime;
+    a /= prime;
+  }
+  return tmp_return;
+}
+
+std::size_t from_poly(const Poly &poly, std::size_t prime, std::size_t size) {
+  std::size_t tmp_return = 0;
+  for (std::size_t i = size; i > 0; --i) {
+    tmp_return = tmp_return * prime + poly[i - 1];
+  }
+  return tmp_return;
+}
+
+/** Reduce the polynomial modulo the monic divisor in place, leaving the remainder */
+void poly_reduce(Poly &poly, const Poly &divisor, std::size_t prime) {
+  std::size_t degree = divisor.size() - 1;
+  for (std::size_t i = poly.size(); i > degree; --i) {
+    std::size_t c = poly[i - 1];
+    if (c == 0) {
+      continue;
+    }
+    std::size_t shift = i - 1 - degree;
+    for (std::size_t j = 0; j <= degree; ++j) {
+      poly[shift + j] = (poly[shift + j] + (prime - c) * divisor[j]) % prime;
+    }
+  }
+}
+
+/** Whether the monic polynomial has a monic factor of a lower positive degree */
+bool has_factor(const Poly &poly, std::size_t prime) {
+  std::size_t degree = poly.size() - 1;
+  for (std::size_t d = 1; d * 2 <= degree; ++d) {
+    std::size_t num_divisors = 1;
+    for (std::size_t i = 0; i < d; ++i) {
+      num_divisors *= prime;
+    }
+    for (std::size_t lower = 0; lower < num_divisors; ++lower) {
+      Poly divisor = to_poly(lower, prime, d);
+      divisor.push_back(1);
+      Poly remainder = poly;
+      poly_reduce(remainder, divisor, prime);
+      bool is_zero = true;
+      for (std::size_t i = 0; i < d && is_zero; ++i) {
+        is_zero = remainder[i] == 0;
+      }
+      if (is_zero) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+}  // namespace
+
+GaloisField::GaloisField(std::size_t order)
+    : order_(order), prime_(0), power_(0), modulus_(0) {
+  if (order > MAX_ORDER || !IsPrimePower(order, &this->prime_, &this->power_)) {
+    CT_EXCEPTION("the order of a finite field must be a prime power");
+    return;
+  }
+  std::size_t p = this->prime_, m = this->power_, q = this->order_;
+  // the modulus x^m + lower terms
+  Poly modulus;
+  for (this->modulus_ = 0; this->modulus_ < q; ++this->modulus_) {
+    modulus = to_poly(this->modulus_, p, m);
+    modulus.push_back(1);
+    if (!has_factor(modulus, p)) {
+      break;
+    }
+  }
+  this->add_.resize(q * q);
+  this->mul_.resize(q * q);
+  this->neg_.resize(q);
+  this->inv_.assign(q, 0);
+  for (std::size_t a = 0; a < q; ++a) {
+    Poly pa = to_poly(a, p, m);
+    for (std::size_t b = 0; b < q; ++b) {
+      Poly pb = to_poly(b, p, m);
+      Poly sum(m);
+      for (std::size_t i = 0; i < m; ++i) {
+        sum[i] = (pa[i] + pb[i]) % p;
+      }
+      this->add_[a * q + b] = from_poly(sum, p, m);
+      Poly product(2 * m - 1, 0);
+      for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < m; ++j) {
+          product[i + j] = (product[i + j] + pa[i] * pb[j]) % p;
+        }
+      }
+      poly_reduce(product, modulus, p);
+      std::size_t c = from_poly(product, p, m);
+      this->mul_[a * q + b] = c;
+      if (this->add_[a * q + b] == 0) {
+        this->neg_[a] = b;
+      }
+      if (c == 1) {
+        this->inv_[a] = b;
+      }
+    }
+  }
+}
+
+GaloisField::GaloisField(const GaloisField &from)
+    : order_(from.order_), prime_(from.prime_), power_(from.power_), modulus_(from.modulus_),
+      add_(from.add_), mul_(from.mul_), neg_(from.neg_), inv_(from.inv_) {
+}
+
+GaloisField &GaloisField::operator = (const GaloisField &right) {
+  this->order_ = right.order_;
+  this->prime_ = right.prime_;
+  this->power_ = right.power_;
+  this->modulus_ = right.modulus_;
+  this->add_ = right.add_;
+  this->mul_ = right.mul_;
+  this->neg_ = right.neg_;
+  this->inv_ = right.inv_;
+  return *this;
+}
+
+GaloisField::~GaloisField(void) {
+}
+
+bool GaloisField::IsPrimePower(std::size_t n, std::size_t *prime, std::size_t *power) {
+  if (n < 2) {
+    return false;
+  }
+  std::size_t p = n;
+  for (std::size_t d = 2; d * d <= n; ++d) {
+    if (n % d == 0) {
+      p = d;
+      break;
+    }
+  }
+  std::size_t m = 0;
+  while (n % p == 0) {
+    n /= p;
+    ++m;
+  }
+  if (n != 1) {
+    return false;
+  }
+  if (prime) {
+    *prime = p;
+  }
+  if (power) {
+    *power = m;
+  }
+  return true;
+}
+
+std::size_t GaloisField::NextPrimePower(std::size_t n) {
+  std::size_t tmp_return = n < 2 ? 2 : n;
+  while (!IsPrimePower(tmp_return)) {
+    ++tmp_return;
+  }
+  return tmp_return;
+}
+
+std::size_t GaloisField::Evaluate(const std::vector<std::size_t> &coefs, std::size_t x) const {
+  std::size_t tmp_return = 0;
+  for (std::size_t i = coefs.size(); i > 0; --i) {
+    tmp_return = this->Add(this->Mul(tmp_return, x), coefs[i - 1]);
+  }
+  return tmp_return;
+}
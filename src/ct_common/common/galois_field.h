@@ -0,0 +1,70 @@
+//===----- ct_common/common/galois_field.h ----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for finite field arithmetic
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_GALOIS_FIELD_H_
+#define CT_COMMON_GALOIS_FIELD_H_
+
+#include <vector>
+#include <ct_common/common/utils.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for the arithmetic of the finite field GF(q), q = p^m.
+ * Elements are 0 .. q-1, standing for polynomials over GF(p) of degree < m
+ * by their base-p digits, and the products are taken modulo an irreducible
+ * polynomial of degree m. All operations are table lookups.
+ */
+class DLL_EXPORT GaloisField {
+public:
+  /** The largest supported order */
+  static const std::size_t MAX_ORDER = 256;
+
+  /** Build the field of the given order, which must be a prime power */
+  explicit GaloisField(std::size_t order = 2);
+  GaloisField(const GaloisField &from);
+  GaloisField &operator = (const GaloisField &right);
+  ~GaloisField(void);
+
+  /** Whether n is a prime power, optionally giving the prime and the exponent */
+  static bool IsPrimePower(std::size_t n, std::size_t *prime = 0, std::size_t *power = 0);
+  /** Get the smallest prime power not less than n */
+  static std::size_t NextPrimePower(std::size_t n);
+
+  /** Get the order q */
+  std::size_t get_order(void) const { return this->order_; }
+  /** Get the characteristic p */
+  std::size_t get_characteristic(void) const { return this->prime_; }
+
+  std::size_t Add(std::size_t a, std::size_t b) const { return this->add_[a * this->order_ + b]; }
+  std::size_t Mul(std::size_t a, std::size_t b) const { return this->mul_[a * this->order_ + b]; }
+  std::size_t Neg(std::size_t a) const { return this->neg_[a]; }
+  std::size_t Sub(std::size_t a, std::size_t b) const { return this->Add(a, this->Neg(b)); }
+  /** Get the multiplicative inverse of a non-zero element */
+  std::size_t Inv(std::size_t a) const { return this->inv_[a]; }
+  /** Evaluate the polynomial with the given coefficients (constant first) at x */
+  std::size_t Evaluate(const std::vector<std::size_t> &coefs, std::size_t x) const;
+
+private:
+  std::size_t order_;  /**< The order q */
+  std::size_t prime_;  /**< The characteristic p */
+  std::size_t power_;  /**< The exponent m */
+  std::size_t modulus_;  /**< The lower coefficients of the monic irreducible modulus in digit form */
+  std::vector<std::size_t> add_;  /**< The addition table */
+  std::vector<std::size_t> mul_;  /**< The multiplication table */
+  std::vector<std::size_t> neg_;  /**< The additive inverses */
+  std::vector<std::size_t> inv_;  /**< The multiplicative inverses, 0 for 0 */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_GALOIS_FIELD_H_
@@ -0,0 +1,184 @@
+//===----- ct_common/common/generator.cpp -----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class Generator
+//
+//===----------------------------------------------------------------------===//
+
+#include <ct_common/common/generator.h>
+#include <ct_common/common/seed_tuple.h>
+#include <ct_common/common/seed_constraint.h>
+
+using namespace ct::common;
+
+Generator::Generator(void)
+    : num_combinations_(0), num_infeasible_(0), num_ignored_seeds_(0) {
+}
+
+Generator::Generator(const Generator &from)
+    : feasibility_oracle_(from.feasibility_oracle_), num_combinations_(from.num_combinations_),
+      num_infeasible_(from.num_infeasible_), num_ignored_seeds_(from.num_ignored_seeds_) {
+}
+
+Generator &Generator::operator = (const Generator &right) {
+  this->feasibility_oracle_ = right.feasibility_oracle_;
+  this->num_combinations_ = right.num_combinations_;
+  this->num_infeasible_ = right.num_infeasible_;
+  this->num_ignored_seeds_ = right.num_ignored_seeds_;
+  return *this;
+}
+
+Generator::~Generator(void) {
+}
+
+std::string Generator::get_class_name(void) const {
+  return Generator::class_name();
+}
+
+std::string Generator::class_name(void) {
+  return "Generator";
+}
+
+void Generator::reset_stats(void) {
+  this->num_combinations_ = 0;
+  this->num_infeasible_ = 0;
+  this->num_ignored_seeds_ = 0;
+}
+
+void Generator::skip_auto_combinations(const SUTModel &model, CoverageMap &coverage) {
+  for (std::size_t i = 0; i < coverage.get_num_raw_strengths(); ++i) {
+    const RawStrength &raw_strength = coverage.get_raw_strength(i);
+    bool has_auto = false;
+    for (std::size_t j = 0; j < raw_strength.size(); ++j) {
+      has_auto = has_auto || model.param_specs_[raw_strength[j]]->is_auto();
+    }
+    if (!has_auto) {
+      continue;
+    }
+    for (std::size_t cid = coverage.get_offset(i); cid < coverage.get_offset(i + 1); ++cid) {
+      if (coverage.Cover(cid)) {
+        ++this->num_infeasible_;
+      }
+    }
+  }
+}
+
+bool Generator::skip_infeasible_combinations(CoverageMap &coverage) {
+  if (!this->feasibility_oracle_) {
+    return false;
+  }
+  if (!this->feasibility_oracle_->IsMatching(coverage)) {
+    CT_EXCEPTION("the feasibility oracle is computed for another model");
+  }
+  for (std::size_t i = 0; i < coverage.get_num_raw_strengths(); ++i) {
+    std::size_t offset = coverage.get_offset(i);
+    for (std::size_t cid = offset; cid < coverage.get_offset(i + 1); ++cid) {
+      if (!this->feasibility_oracle_->IsFeasible(i, cid - offset) && coverage.Cover(cid)) {
+        ++this->num_infeasible_;
+      }
+    }
+  }
+  return true;
+}
+
+void Generator::cover_starters(const SUTModel &model, CoverageMap &coverage) const {
+  for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+    const Seed_Tuple *seed = dynamic_cast<const Seed_Tuple *>(model.seeds_[i].get());
+    if (seed && seed->get_is_starter()) {
+      coverage.Cover(seed->get_tuple());
+    }
+  }
+}
+
+void Generator::make_seed_tests(const SUTModel &model, const ConstraintChecker &checker,
+                                std::vector<TestCase> &tests) {
+  for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+    const Seed_Tuple *seed = dynamic_cast<const Seed_Tuple *>(model.seeds_[i].get());
+    if (!seed || seed->get_is_starter()) {
+      continue;
+    }
+    const Tuple &tuple = seed->get_tuple();
+    TestCase test = checker.MakeEmptyTest();
+    bool is_valid = true;
+    for (std::size_t j = 0; j < tuple.size() && is_valid; ++j) {
+      if (tuple[j].pid_ >= test.size() || model.param_specs_[tuple[j].pid_]->is_auto() ||
+          tuple[j].vid_ > model.param_specs_[tuple[j].pid_]->get_invalid_vid()) {
+        is_valid = false;
+        break;
+      }
+      test[tuple[j].pid_] = tuple[j].vid_;
+    }
+    for (std::size_t j = 0; j < tuple.size() && is_valid; ++j) {
+      is_valid = checker.IsExtendable(test, tuple[j].pid_);
+    }
+    if (!is_valid) {
+      ++this->num_ignored_seeds_;
+      continue;
+    }
+    tests.push_back(test);
+  }
+}
+
+std::size_t Generator::repair_test(const ConstraintChecker &checker, TestCase &test) const {
+  TestCase row = test;
+  test = checker.MakeEmptyTest();
+  std::size_t tmp_return = 0;
+  for (std::size_t i = 0; i < row.size(); ++i) {
+    if (row[i] == VID_BOUND || row[i] == test[i]) {
+      continue;
+    }
+    test[i] = row[i];
+    if (checker.IsExtendable(test, i)) {
+      ++tmp_return;
+    } else {
+      test[i] = VID_BOUND;
+    }
+  }
+  return tmp_return;
+}
+
+void Generator::make_seeded_model(const SUTModel &model, const std::vector<TestCase> &tests,
+                                  SUTModel &seeded_model) const {
+  seeded_model = model;
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    boost::shared_ptr<Seed_Tuple> seed(new Seed_Tuple());
+    for (std::size_t j = 0; j < tests[i].size(); ++j) {
+      if (tests[i][j] != VID_BOUND && !model.param_specs_[j]->is_auto()) {
+        seed->the_tuple().push_back(PVPair(j, tests[i][j]));
+      }
+    }
+    seeded_model.seeds_.push_back(seed);
+  }
+}
+
+void Generator::cover_constraint_seeds(const SUTModel &model, std::vector<TestCase> &tests) {
+  for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+    Seed_Constraint *seed = dynamic_cast<Seed_Constraint *>(model.seeds_[i].get());
+    if (!seed || seed->get_is_starter() || !seed->get_constraint()) {
+      continue;
+    }
+    bool is_matched = false;
+    for (std::size_t j = 0; j < tests.size() && !is_matched; ++j) {
+      EvalType_Bool result = seed->IsMatch(tests[j], model.param_specs_);
+      is_matched = result.is_valid_ && result.value_;
+    }
+    if (is_matched) {
+      continue;
+    }
+    // search a test case satisfying the seed along with the constraints
+    std::vector<boost::shared_ptr<Constraint> > constraints = model.constraints_;
+    constraints.push_back(seed->get_constraint());
+    ConstraintChecker checker(model.param_specs_, constraints);
+    TestCase test = checker.MakeEmptyTest();
+    if (checker.Complete(test)) {
+      tests.push_back(test);
+    } else {
+      ++this->num_ignored_seeds_;
+    }
+  }
+}
@@ -0,0 +1,113 @@
+//===----- ct_common/common/generator.h -------------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the base class for covering array generators
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_GENERATOR_H_
+#define CT_COMMON_GENERATOR_H_
+
+#include <vector>
+#include <string>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/feasibility_oracle.h>
+
+namespace ct {
+namespace common {
+/**
+ * The base class for covering array generators.
+ * A generator produces complete test cases satisfying all constraints of the
+ * model, which together cover every feasible combination of the strengths.
+ * Non-starter seeds are included in the generated test suite, while the
+ * combinations of starter seeds are taken as covered by preceding test cases.
+ * Generators consulting a FeasibilityOracle skip the combinations it finds
+ * infeasible instead of searching them.
+ */
+class DLL_EXPORT Generator {
+public:
+  Generator(void);
+  Generator(const Generator &from);
+  Generator &operator = (const Generator &right);
+  virtual ~Generator(void) = 0;
+
+  /** Generate a test suite for the model */
+  virtual void Generate(const SUTModel &model, std::vector<TestCase> &tests) = 0;
+  /**
+   * Make a copy of the generator on the heap, with copies of the generators
+   * it uses, so that the copies can run in different threads
+   */
+  virtual Generator *Clone(void) const = 0;
+
+  virtual std::string get_class_name(void) const;
+  static std::string class_name(void);
+
+  /** Set the oracle computed for the model to generate, null for searching the combinations instead */
+  void set_feasibility_oracle(const boost::shared_ptr<const FeasibilityOracle> &oracle) {
+    this->feasibility_oracle_ = oracle;
+  }
+  /** Get the oracle for the model to generate */
+  const boost::shared_ptr<const FeasibilityOracle> &get_feasibility_oracle(void) const {
+    return this->feasibility_oracle_;
+  }
+
+  /** Get the number of target combinations of the last generation */
+  std::size_t get_num_combinations(void) const { return this->num_combinations_; }
+  /** Get the number of target combinations found infeasible in the last generation */
+  std::size_t get_num_infeasible(void) const { return this->num_infeasible_; }
+  /** Get the number of seeds ignored in the last generation for conflicting with the constraints */
+  std::size_t get_num_ignored_seeds(void) const { return this->num_ignored_seeds_; }
+
+protected:
+  /** Reset the statistics */
+  void reset_stats(void);
+  /** Mark the combinations involving auto parameters covered and infeasible, as auto parameters take no values */
+  void skip_auto_combinations(const SUTModel &model, CoverageMap &coverage);
+  /**
+   * Mark the combinations the oracle finds infeasible covered and infeasible,
+   * returns false if there is no oracle. Throws if the oracle is not computed
+   * for the combinations of the coverage map.
+   */
+  bool skip_infeasible_combinations(CoverageMap &coverage);
+  /** Mark the combinations of starter tuple seeds covered */
+  void cover_starters(const SUTModel &model, CoverageMap &coverage) const;
+  /** Make the partial test cases of non-starter tuple seeds, which are to be completed by the generator */
+  void make_seed_tests(const SUTModel &model, const ConstraintChecker &checker,
+                       std::vector<TestCase> &tests);
+  /**
+   * Drop the cells of a partial test case which cannot be extended under the
+   * constraints, in the order of pids. Returns the number of cells kept.
+   */
+  std::size_t repair_test(const ConstraintChecker &checker, TestCase &test) const;
+  /** Copy the model with the partial test cases appended as non-starter tuple seeds */
+  void make_seeded_model(const SUTModel &model, const std::vector<TestCase> &tests,
+                         SUTModel &seeded_model) const;
+  /** Append test cases for the non-starter constraint seeds not matched by the generated ones */
+  void cover_constraint_seeds(const SUTModel &model, std::vector<TestCase> &tests);
+  /** Record combinations found infeasible */
+  void add_infeasible(std::size_t num_combinations = 1) { this->num_infeasible_ += num_combinations; }
+  /** Record seeds ignored for conflicting with the constraints */
+  void add_ignored_seeds(std::size_t num_seeds = 1) { this->num_ignored_seeds_ += num_seeds; }
+  /** Record the number of target combinations */
+  void set_num_combinations(std::size_t num_combinations) { this->num_combinations_ = num_combinations; }
+
+private:
+  boost::shared_ptr<const FeasibilityOracle> feasibility_oracle_;  /**< The oracle for the model to generate */
+  std::size_t num_combinations_;  /**< The number of target combinations */
+  std::size_t num_infeasible_;  /**< The number of infeasible combinations */
+  std::size_t num_ignored_seeds_;  /**< The number of ignored seeds */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_GENERATOR_H_
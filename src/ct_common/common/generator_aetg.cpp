@@ -0,0 +1,268 @@
+//===----- ct_common/common/generator_aetg.cpp ------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class Generator_AETG
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <ct_common/common/generator_aetg.h>
+#include <ct_common/common/feasibility_cache.h>
+#include <ct_common/common/coverage_weights.h>
+#include <ct_common/common/strided_threads.h>
+
+using namespace ct::common;
+
+namespace {
+/** Orders values by decreasing gains */
+struct GainGreater {
+  explicit GainGreater(const std::vector<double> &gains)
+      : gains_(gains) {
+  }
+  bool operator () (std::size_t left, std::size_t right) const {
+    return this->gains_[left] > this->gains_[right];
+  }
+  const std::vector<double> &gains_;
+};
+
+/** Shuffle a vector by Fisher-Yates */
+void shuffle(std::vector<std::size_t> &items, boost::random::mt19937 &rng) {
+  for (std::size_t i = items.size(); i > 1; --i) {
+    boost::random::uniform_int_distribution<std::size_t> dist(0, i - 1);
+    std::swap(items[i - 1], items[dist(rng)]);
+  }
+}
+
+/**
+ * Builds and scores candidates. It only reads the checker and the coverage,
+ * so that several threads can share it.
+ */
+class CandidateBuilder {
+public:
+  CandidateBuilder(const ConstraintChecker &checker, const CoverageMap &coverage, const CoverageWeightTable &weights,
+                   const std::vector<std::vector<std::size_t> > &param_sids)
+      : checker_(checker), coverage_(coverage), weights_(weights), param_sids_(param_sids) {
+  }
+
+  /** Assign the unassigned cells of a test case greedily, returns the weight of the newly covered combinations */
+  double Build(TestCase &test, boost::random::mt19937 &rng) const {
+    std::vector<std::size_t> pids;
+    for (std::size_t i = 0; i < test.size(); ++i) {
+      if (test[i] == VID_BOUND) {
+        pids.push_back(i);
+      }
+    }
+    shuffle(pids, rng);
+    std::vector<double> gains;
+    std::vector<std::size_t> vids;
+    for (std::size_t i = 0; i < pids.size(); ++i) {
+      std::size_t pid = pids[i];
+      std::size_t level = this->coverage_.get_level(pid);
+      gains.assign(level, 0.0);
+      const std::vector<std::size_t> &sids = this->param_sids_[pid];
+      for (std::size_t j = 0; j < sids.size(); ++j) {
+        const RawStrength &raw_strength = this->coverage_.get_raw_strength(sids[j]);
+        std::size_t base = this->coverage_.get_offset(sids[j]);
+        std::size_t stride = 0;
+        double scale = this->weights_.get_raw_strength_weight(sids[j]);
+        bool is_assigned = true;
+        for (std::size_t k = 0; k < raw_strength.size(); ++k) {
+          if (raw_strength[k] == pid) {
+            stride = this->coverage_.get_stride(sids[j], k);
+            continue;
+          }
+          std::size_t vid = test[raw_strength[k]];
+          if (vid >= this->coverage_.get_level(raw_strength[k])) {
+            is_assigned = false;
+            break;
+          }
+          base += vid * this->coverage_.get_stride(sids[j], k);
+          scale *= this->weights_.get_value_weight(raw_strength[k], vid);
+        }
+        if (!is_assigned) {
+          continue;
+        }
+        for (std::size_t vid = 0; vid < level; ++vid) {
+          if (!this->coverage_.IsCovered(base + vid * stride)) {
+            gains[vid] += scale;
+          }
+        }
+      }
+      for (std::size_t vid = 0; vid < level; ++vid) {
+        gains[vid] *= this->weights_.get_value_weight(pid, vid);
+      }
+      // ties are broken randomly, the invalid value is tried last
+      vids.resize(level);
+      for (std::size_t vid = 0; vid < level; ++vid) {
+        vids[vid] = vid;
+      }
+      shuffle(vids, rng);
+      std::stable_sort(vids.begin(), vids.end(), GainGreater(gains));
+      vids.push_back(level);
+      for (std::size_t j = 0; j < vids.size(); ++j) {
+        test[pid] = vids[j];
+        if (this->checker_.IsExtendable(test, pid)) {
+          break;
+        }
+        test[pid] = VID_BOUND;
+      }
+    }
+    return this->weights_.WeighUncovered(this->coverage_, test);
+  }
+
+private:
+  const ConstraintChecker &checker_;
+  const CoverageMap &coverage_;
+  const CoverageWeightTable &weights_;
+  const std::vector<std::vector<std::size_t> > &param_sids_;  /**< The raw strengths involving each parameter */
+};
+
+/** Builds the candidates first, first + step, ... */
+struct CandidateWorker {
+  void operator () (std::size_t first) const {
+    for (std::size_t i = first; i < this->candidates_->size(); i += this->step_) {
+      boost::random::mt19937 rng(static_cast<boost::uint32_t>(this->random_seed_ + i));
+      (*this->candidates_)[i] = *this->start_;
+      (*this->scores_)[i] = this->builder_->Build((*this->candidates_)[i], rng);
+    }
+  }
+
+  const CandidateBuilder *builder_;
+  const TestCase *start_;
+  std::vector<TestCase> *candidates_;
+  std::vector<double> *scores_;
+  std::size_t step_;
+  std::size_t random_seed_;
+};
+}  // namespace
+
+Generator_AETG::Generator_AETG(void)
+    : Generator(), num_candidates_(50), num_threads_(0), random_seed_(0), use_symmetry_(true) {
+}
+
+Generator_AETG::Generator_AETG(const Generator_AETG &from)
+    : Generator(from), num_candidates_(from.num_candidates_),
+      num_threads_(from.num_threads_), random_seed_(from.random_seed_), use_symmetry_(from.use_symmetry_) {
+}
+
+Generator_AETG &Generator_AETG::operator = (const Generator_AETG &right) {
+  Generator::operator = (right);
+  this->num_candidates_ = right.num_candidates_;
+  this->num_threads_ = right.num_threads_;
+  this->random_seed_ = right.random_seed_;
+  this->use_symmetry_ = right.use_symmetry_;
+  return *this;
+}
+
+Generator_AETG::~Generator_AETG(void) {
+}
+
+Generator *Generator_AETG::Clone(void) const {
+  return new Generator_AETG(*this);
+}
+
+std::string Generator_AETG::get_class_name(void) const {
+  return Generator_AETG::class_name();
+}
+
+std::string Generator_AETG::class_name(void) {
+  return "Generator_AETG";
+}
+
+void Generator_AETG::Generate(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->reset_stats();
+  tests.clear();
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  this->set_num_combinations(coverage.get_num_combinations());
+  if (!checker.IsValid(checker.MakeEmptyTest())) {
+    // some constraint fails without any parameter
+    this->add_infeasible(coverage.get_num_uncovered());
+    return;
+  }
+  this->skip_auto_combinations(model, coverage);
+  this->cover_starters(model, coverage);
+  this->skip_infeasible_combinations(coverage);
+
+  std::vector<std::vector<std::size_t> > param_sids(model.param_specs_.size());
+  for (std::size_t i = 0; i < coverage.get_num_raw_strengths(); ++i) {
+    const RawStrength &raw_strength = coverage.get_raw_strength(i);
+    for (std::size_t j = 0; j < raw_strength.size(); ++j) {
+      param_sids[raw_strength[j]].push_back(i);
+    }
+  }
+  std::size_t num_threads = resolve_num_threads(this->num_threads_, this->num_candidates_);
+  std::vector<TestCase> candidates(std::max(this->num_candidates_, std::size_t(1)));
+  std::vector<double> scores(candidates.size());
+  CoverageWeightTable weights;
+  weights.Init(model.strengths_, model.weights_, coverage);
+  CandidateBuilder builder(checker, coverage, weights, param_sids);
+
+  // the seeds are completed first
+  std::vector<TestCase> seed_tests;
+  this->make_seed_tests(model, checker, seed_tests);
+  for (std::size_t i = 0; i < seed_tests.size(); ++i) {
+    boost::random::mt19937 rng(this->random_seed_);
+    builder.Build(seed_tests[i], rng);
+    if (!checker.Complete(seed_tests[i])) {
+      CT_EXCEPTION("failed to complete a test case");
+    }
+    coverage.Cover(seed_tests[i]);
+    tests.push_back(seed_tests[i]);
+  }
+
+  ModelSymmetry symmetry;
+  if (this->use_symmetry_ && !this->get_feasibility_oracle()) {
+    symmetry.Detect(model);
+  }
+  FeasibilityCache feasibility(checker, symmetry);
+  std::vector<std::size_t> vids;
+  // the threads build the candidates of every row
+  StridedThreads threads(num_threads);
+  for (std::size_t cid = coverage.FindUncovered(0, coverage.get_num_combinations());
+       cid < coverage.get_num_combinations();
+       cid = coverage.FindUncovered(cid, coverage.get_num_combinations())) {
+    // every candidate takes the first uncovered combination
+    const RawStrength &raw_strength = coverage.get_raw_strength(coverage.GetRawStrengthId(cid));
+    coverage.GetValues(cid, vids);
+    // with an oracle the infeasible combinations are covered already
+    if (!this->get_feasibility_oracle() && !feasibility.IsFeasible(raw_strength, vids)) {
+      coverage.Cover(cid);
+      this->add_infeasible();
+      continue;
+    }
+    TestCase start = checker.MakeEmptyTest();
+    for (std::size_t i = 0; i < raw_strength.size(); ++i) {
+      start[raw_strength[i]] = vids[i];
+    }
+
+    CandidateWorker worker;
+    worker.builder_ = &builder;
+    worker.start_ = &start;
+    worker.candidates_ = &candidates;
+    worker.scores_ = &scores;
+    worker.step_ = num_threads;
+    worker.random_seed_ = this->random_seed_ + tests.size() * candidates.size();
+    threads.Run(worker);
+
+    std::size_t best = 0;
+    for (std::size_t i = 1; i < candidates.size(); ++i) {
+      if (scores[i] > scores[best]) {
+        best = i;
+      }
+    }
+    if (!checker.Complete(candidates[best])) {
+      CT_EXCEPTION("failed to complete a test case");
+    }
+    coverage.Cover(candidates[best]);
+    tests.push_back(candidates[best]);
+  }
+  this->cover_constraint_seeds(model, tests);
+}
@@ -0,0 +1,72 @@
+//===----- ct_common/common/generator_aetg.h --------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the one-test-at-a-time covering array generator
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_GENERATOR_AETG_H_
+#define CT_COMMON_GENERATOR_AETG_H_
+
+#include <ct_common/common/generator.h>
+
+namespace ct {
+namespace common {
+/**
+ * The AETG-style covering array generator, which adds one test case at a time.
+ * Each test case is the best of a number of candidates. A candidate starts
+ * from the first uncovered combination, then assigns the other parameters in
+ * a random order, each taking the value covering the largest weight of
+ * uncovered combinations with the parameters assigned before (the most with
+ * the default uniform weights), and the candidate covering the largest
+ * weight wins. Candidates are built and scored by several threads against
+ * the coverage, which is only updated between test cases. The result does not depend on the number of threads.
+ * The first uncovered combinations are checked by a FeasibilityCache, so that
+ * the symmetric ones found infeasible are not searched again, or looked up in
+ * the feasibility oracle if one is set.
+ */
+class DLL_EXPORT Generator_AETG : public Generator {
+public:
+  Generator_AETG(void);
+  Generator_AETG(const Generator_AETG &from);
+  Generator_AETG &operator = (const Generator_AETG &right);
+  virtual ~Generator_AETG(void);
+
+  virtual void Generate(const SUTModel &model, std::vector<TestCase> &tests);
+  virtual Generator *Clone(void) const;
+
+  virtual std::string get_class_name(void) const;
+  static std::string class_name(void);
+
+  /** Set the number of candidates for each test case */
+  void set_num_candidates(std::size_t num_candidates) { this->num_candidates_ = num_candidates; }
+  /** Get the number of candidates for each test case */
+  std::size_t get_num_candidates(void) const { return this->num_candidates_; }
+  /** Set the number of threads, 0 for the number of hardware threads */
+  void set_num_threads(std::size_t num_threads) { this->num_threads_ = num_threads; }
+  /** Get the number of threads, 0 for the number of hardware threads */
+  std::size_t get_num_threads(void) const { return this->num_threads_; }
+  /** Set the seed of the random orders */
+  void set_random_seed(unsigned int random_seed) { this->random_seed_ = random_seed; }
+  /** Get the seed of the random orders */
+  unsigned int get_random_seed(void) const { return this->random_seed_; }
+  /** Set whether the infeasible combinations are found up to the symmetries of the model */
+  void set_use_symmetry(bool use_symmetry) { this->use_symmetry_ = use_symmetry; }
+  /** Get whether the infeasible combinations are found up to the symmetries of the model */
+  bool get_use_symmetry(void) const { return this->use_symmetry_; }
+
+private:
+  std::size_t num_candidates_;  /**< The number of candidates for each test case */
+  std::size_t num_threads_;  /**< The number of threads, 0 for the number of hardware threads */
+  unsigned int random_seed_;  /**< The seed of the random orders */
+  bool use_symmetry_;  /**< Whether the infeasible combinations are found up to symmetries */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_GENERATOR_AETG_H_
@@ -0,0 +1,163 @@
+//===----- ct_common/common/generator_decomposed.cpp ------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class Generator_Decomposed
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <ct_common/common/generator_decomposed.h>
+#include <ct_common/common/generator_ipog.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/model_decomposition.h>
+#include <ct_common/common/strided_threads.h>
+
+using namespace ct::common;
+
+namespace {
+/** The suite and the statistics of a component */
+struct ComponentResult {
+  std::vector<TestCase> tests_;
+  std::size_t num_combinations_;
+  std::size_t num_infeasible_;
+  std::size_t num_ignored_seeds_;
+  std::string error_;  /**< The message of the exception thrown, if any */
+};
+
+/** Generates the components first, first + step, ... */
+struct ComponentWorker {
+  void operator () (std::size_t first) const {
+    boost::shared_ptr<Generator> generator(this->generator_->Clone());
+    for (std::size_t i = first; i < this->models_->size(); i += this->step_) {
+      ComponentResult &result = (*this->results_)[i];
+      // exceptions must not leave the thread
+      try {
+        generator->Generate((*this->models_)[i], result.tests_);
+      } catch (std::exception &e) {
+        result.error_ = e.what();
+        continue;
+      }
+      result.num_combinations_ = generator->get_num_combinations();
+      result.num_infeasible_ = generator->get_num_infeasible();
+      result.num_ignored_seeds_ = generator->get_num_ignored_seeds();
+    }
+  }
+
+  const Generator *generator_;
+  const std::vector<SUTModel> *models_;
+  std::vector<ComponentResult> *results_;
+  std::size_t step_;
+};
+}  // namespace
+
+Generator_Decomposed::Generator_Decomposed(void)
+    : Generator(), component_generator_(new Generator_IPOG()), num_threads_(0) {
+}
+
+Generator_Decomposed::Generator_Decomposed(const Generator_Decomposed &from)
+    : Generator(from), component_generator_(from.component_generator_), num_threads_(from.num_threads_),
+      components_(from.components_), component_sizes_(from.component_sizes_) {
+}
+
+Generator_Decomposed &Generator_Decomposed::operator = (const Generator_Decomposed &right) {
+  Generator::operator = (right);
+  this->component_generator_ = right.component_generator_;
+  this->num_threads_ = right.num_threads_;
+  this->components_ = right.components_;
+  this->component_sizes_ = right.component_sizes_;
+  return *this;
+}
+
+Generator_Decomposed::~Generator_Decomposed(void) {
+}
+
+Generator *Generator_Decomposed::Clone(void) const {
+  Generator_Decomposed *tmp_return = new Generator_Decomposed(*this);
+  if (this->component_generator_) {
+    tmp_return->component_generator_.reset(this->component_generator_->Clone());
+  }
+  return tmp_return;
+}
+
+std::string Generator_Decomposed::get_class_name(void) const {
+  return Generator_Decomposed::class_name();
+}
+
+std::string Generator_Decomposed::class_name(void) {
+  return "Generator_Decomposed";
+}
+
+void Generator_Decomposed::Generate(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->reset_stats();
+  this->components_.clear();
+  this->component_sizes_.clear();
+  tests.clear();
+  if (!this->component_generator_) {
+    CT_EXCEPTION("no component generator");
+  }
+  std::vector<std::vector<std::size_t> > components;
+  find_model_components(model, components);
+  std::vector<SUTModel> models;
+  for (std::size_t i = 0; i < components.size(); ++i) {
+    SUTModel component_model;
+    make_component_model(model, components[i], component_model);
+    if (!component_model.strengths_.empty() || !component_model.seeds_.empty()) {
+      models.push_back(component_model);
+      this->components_.push_back(components[i]);
+    }
+  }
+  if (models.size() <= 1) {
+    this->component_generator_->Generate(model, tests);
+    this->set_num_combinations(this->component_generator_->get_num_combinations());
+    this->add_infeasible(this->component_generator_->get_num_infeasible());
+    this->add_ignored_seeds(this->component_generator_->get_num_ignored_seeds());
+    this->component_sizes_.assign(this->components_.size(), tests.size());
+    return;
+  }
+
+  std::size_t num_threads = resolve_num_threads(this->num_threads_, models.size());
+  std::vector<ComponentResult> results(models.size());
+  ComponentWorker worker;
+  worker.generator_ = this->component_generator_.get();
+  worker.models_ = &models;
+  worker.results_ = &results;
+  worker.step_ = num_threads;
+  run_strided(num_threads, worker);
+
+  std::size_t num_rows = 0;
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    if (!results[i].error_.empty()) {
+      CT_EXCEPTION(results[i].error_);
+    }
+    std::size_t num_combinations = this->get_num_combinations() + results[i].num_combinations_;
+    this->set_num_combinations(num_combinations);
+    this->add_infeasible(results[i].num_infeasible_);
+    this->add_ignored_seeds(results[i].num_ignored_seeds_);
+    this->component_sizes_.push_back(results[i].tests_.size());
+    num_rows = std::max(num_rows, results[i].tests_.size());
+  }
+  // the components share no constraint, so the zipped cells satisfy them all
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  tests.resize(num_rows);
+  for (std::size_t r = 0; r < num_rows; ++r) {
+    TestCase &test = tests[r];
+    test = checker.MakeEmptyTest();
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      if (results[i].tests_.empty()) {
+        continue;
+      }
+      const TestCase &row = results[i].tests_[r % results[i].tests_.size()];
+      for (std::size_t j = 0; j < this->components_[i].size(); ++j) {
+        test[this->components_[i][j]] = row[this->components_[i][j]];
+      }
+    }
+    if (!checker.Complete(test)) {
+      CT_EXCEPTION("failed to complete a test case");
+    }
+  }
+}
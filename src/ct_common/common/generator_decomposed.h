@@ -0,0 +1,69 @@
+//===----- ct_common/common/generator_decomposed.h --------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the generator for models of independent components
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_GENERATOR_DECOMPOSED_H_
+#define CT_COMMON_GENERATOR_DECOMPOSED_H_
+
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/generator.h>
+
+namespace ct {
+namespace common {
+/**
+ * The generator splitting models into the independent components found by
+ * find_model_components. The components with strengths or seeds are
+ * generated separately by copies of the component generator, in parallel,
+ * and their test suites are zipped: test case r takes the cells of each
+ * component from row r of its suite, cycling through the shorter suites, so
+ * that the result has as many test cases as the longest suite. The cells of
+ * the other parameters are completed under their constraints. Models of a
+ * single component go to the component generator directly.
+ */
+class DLL_EXPORT Generator_Decomposed : public Generator {
+public:
+  Generator_Decomposed(void);
+  Generator_Decomposed(const Generator_Decomposed &from);
+  Generator_Decomposed &operator = (const Generator_Decomposed &right);
+  virtual ~Generator_Decomposed(void);
+
+  virtual void Generate(const SUTModel &model, std::vector<TestCase> &tests);
+  virtual Generator *Clone(void) const;
+
+  virtual std::string get_class_name(void) const;
+  static std::string class_name(void);
+
+  /** Set the generator for the components */
+  void set_component_generator(const boost::shared_ptr<Generator> &generator) { this->component_generator_ = generator; }
+  /** Get the generator for the components */
+  const boost::shared_ptr<Generator> &get_component_generator(void) const { return this->component_generator_; }
+  /** Set the number of threads, 0 for the number of hardware threads */
+  void set_num_threads(std::size_t num_threads) { this->num_threads_ = num_threads; }
+  /** Get the number of threads, 0 for the number of hardware threads */
+  std::size_t get_num_threads(void) const { return this->num_threads_; }
+
+  /** Get the parameters of the components generated in the last generation */
+  const std::vector<std::vector<std::size_t> > &get_components(void) const { return this->components_; }
+  /** Get the numbers of test cases of the components generated in the last generation */
+  const std::vector<std::size_t> &get_component_sizes(void) const { return this->component_sizes_; }
+
+private:
+  boost::shared_ptr<Generator> component_generator_;  /**< The generator for the components */
+  std::size_t num_threads_;  /**< The number of threads, 0 for the number of hardware threads */
+  std::vector<std::vector<std::size_t> > components_;  /**< The parameters of the generated components */
+  std::vector<std::size_t> component_sizes_;  /**< The numbers of test cases of the generated components */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_GENERATOR_DECOMPOSED_H_
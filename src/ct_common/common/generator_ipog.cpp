@@ -0,0 +1,289 @@
+//===----- ct_common/common/generator_ipog.cpp ------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class Generator_IPOG
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <functional>
+#include <ct_common/common/generator_ipog.h>
+#include <ct_common/common/feasibility_cache.h>
+
+using namespace ct::common;
+
+namespace {
+/** Orders parameters by decreasing levels */
+struct LevelGreater {
+  explicit LevelGreater(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs)
+      : param_specs_(param_specs) {
+  }
+  bool operator () (std::size_t left, std::size_t right) const {
+    return this->param_specs_[left]->get_level() > this->param_specs_[right]->get_level();
+  }
+  const std::vector<boost::shared_ptr<ParamSpec> > &param_specs_;
+};
+}  // namespace
+
+Generator_IPOG::Generator_IPOG(void)
+    : Generator(), use_symmetry_(true) {
+}
+
+Generator_IPOG::Generator_IPOG(const Generator_IPOG &from)
+    : Generator(from), base_tests_(from.base_tests_), use_symmetry_(from.use_symmetry_) {
+}
+
+Generator_IPOG &Generator_IPOG::operator = (const Generator_IPOG &right) {
+  Generator::operator = (right);
+  this->base_tests_ = right.base_tests_;
+  this->use_symmetry_ = right.use_symmetry_;
+  return *this;
+}
+
+Generator_IPOG::~Generator_IPOG(void) {
+}
+
+Generator *Generator_IPOG::Clone(void) const {
+  return new Generator_IPOG(*this);
+}
+
+std::string Generator_IPOG::get_class_name(void) const {
+  return Generator_IPOG::class_name();
+}
+
+std::string Generator_IPOG::class_name(void) {
+  return "Generator_IPOG";
+}
+
+void Generator_IPOG::Generate(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->reset_stats();
+  tests.clear();
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  this->set_num_combinations(coverage.get_num_combinations());
+  if (!checker.IsValid(checker.MakeEmptyTest())) {
+    // some constraint fails without any parameter
+    this->add_infeasible(coverage.get_num_uncovered());
+    return;
+  }
+  this->skip_auto_combinations(model, coverage);
+  this->cover_starters(model, coverage);
+  this->skip_infeasible_combinations(coverage);
+  // the base test cases come first, their assigned cells being fixed like the ones of seeds
+  for (std::size_t i = 0; i < this->base_tests_.size(); ++i) {
+    TestCase test = this->base_tests_[i];
+    if (test.size() != model.param_specs_.size()) {
+      CT_EXCEPTION("a base test case does not match the parameters");
+    }
+    for (std::size_t j = 0; j < test.size(); ++j) {
+      if (test[j] != VID_BOUND && !checker.IsExtendable(test, j)) {
+        CT_EXCEPTION("a base test case violates the constraints");
+      }
+    }
+    tests.push_back(test);
+  }
+  this->make_seed_tests(model, checker, tests);
+
+  std::vector<std::size_t> order;
+  std::vector<std::size_t> positions(model.param_specs_.size(), PID_BOUND);
+  for (std::size_t i = 0; i < model.param_specs_.size(); ++i) {
+    if (!model.param_specs_[i]->is_auto()) {
+      order.push_back(i);
+    }
+  }
+  std::stable_sort(order.begin(), order.end(), LevelGreater(model.param_specs_));
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    positions[order[i]] = i;
+  }
+  // group the raw strengths by their last parameters in the order
+  std::vector<std::vector<std::size_t> > groups(model.param_specs_.size());
+  for (std::size_t i = 0; i < coverage.get_num_raw_strengths(); ++i) {
+    const RawStrength &raw_strength = coverage.get_raw_strength(i);
+    std::size_t last_pid = PID_BOUND;
+    bool has_auto = false;
+    for (std::size_t j = 0; j < raw_strength.size(); ++j) {
+      if (positions[raw_strength[j]] == PID_BOUND) {
+        has_auto = true;
+      } else if (last_pid == PID_BOUND || positions[raw_strength[j]] > positions[last_pid]) {
+        last_pid = raw_strength[j];
+      }
+    }
+    // the combinations with auto parameters are skipped
+    if (!has_auto && last_pid != PID_BOUND) {
+      groups[last_pid].push_back(i);
+    }
+  }
+
+  ModelSymmetry symmetry;
+  if (this->use_symmetry_ && !this->get_feasibility_oracle()) {
+    symmetry.Detect(model);
+  }
+  FeasibilityCache feasibility(checker, symmetry);
+  CoverageWeightTable weights;
+  weights.Init(model.strengths_, model.weights_, coverage);
+  for (std::size_t i = 0; i < order.size(); ++i) {
+    this->horizontal_growth(order[i], groups[order[i]], checker, weights, coverage, tests);
+    this->vertical_growth(groups[order[i]], checker, feasibility, coverage, tests);
+  }
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (!checker.Complete(tests[i])) {
+      CT_EXCEPTION("failed to complete a test case");
+    }
+  }
+  this->cover_constraint_seeds(model, tests);
+}
+
+void Generator_IPOG::horizontal_growth(std::size_t pid, const std::vector<std::size_t> &sids,
+                                       const ConstraintChecker &checker, const CoverageWeightTable &weights,
+                                       CoverageMap &coverage, std::vector<TestCase> &tests) const {
+  std::size_t level = coverage.get_level(pid);
+  std::vector<std::size_t> bases;
+  std::vector<std::size_t> strides;
+  std::vector<double> scales;
+  std::vector<std::size_t> counts(level);
+  std::vector<double> gains(level);
+  std::vector<std::pair<double, std::size_t> > candidates;
+  for (std::size_t r = 0; r < tests.size(); ++r) {
+    TestCase &test = tests[r];
+    // the ids of the combinations with pid taking vid 0, for the combinations fully assigned
+    bases.clear();
+    strides.clear();
+    scales.clear();
+    for (std::size_t i = 0; i < sids.size(); ++i) {
+      const RawStrength &raw_strength = coverage.get_raw_strength(sids[i]);
+      std::size_t base = coverage.get_offset(sids[i]);
+      std::size_t stride = 0;
+      double scale = weights.get_raw_strength_weight(sids[i]);
+      bool is_assigned = true;
+      for (std::size_t j = 0; j < raw_strength.size(); ++j) {
+        if (raw_strength[j] == pid) {
+          stride = coverage.get_stride(sids[i], j);
+          continue;
+        }
+        std::size_t vid = test[raw_strength[j]];
+        if (vid >= coverage.get_level(raw_strength[j])) {
+          is_assigned = false;
+          break;
+        }
+        base += vid * coverage.get_stride(sids[i], j);
+        scale *= weights.get_value_weight(raw_strength[j], vid);
+      }
+      if (is_assigned) {
+        bases.push_back(base);
+        strides.push_back(stride);
+        scales.push_back(scale);
+      }
+    }
+    if (test[pid] != VID_BOUND) {
+      // fixed by a seed
+      if (test[pid] < level) {
+        for (std::size_t i = 0; i < bases.size(); ++i) {
+          coverage.Cover(bases[i] + test[pid] * strides[i]);
+        }
+      }
+      continue;
+    }
+    std::fill(counts.begin(), counts.end(), 0);
+    std::fill(gains.begin(), gains.end(), 0.0);
+    for (std::size_t i = 0; i < bases.size(); ++i) {
+      for (std::size_t vid = 0; vid < level; ++vid) {
+        if (!coverage.IsCovered(bases[i] + vid * strides[i])) {
+          ++counts[vid];
+          gains[vid] += scales[i];
+        }
+      }
+    }
+    // try the values by decreasing weighted gains, smaller vids first on ties
+    candidates.clear();
+    for (std::size_t vid = 0; vid < level; ++vid) {
+      if (counts[vid] > 0) {
+        candidates.push_back(std::pair<double, std::size_t>(gains[vid] * weights.get_value_weight(pid, vid),
+                                                            level - vid));
+      }
+    }
+    std::sort(candidates.begin(), candidates.end(), std::greater<std::pair<double, std::size_t> >());
+    for (std::size_t i = 0; i < candidates.size(); ++i) {
+      std::size_t vid = level - candidates[i].second;
+      test[pid] = vid;
+      if (checker.IsExtendable(test, pid)) {
+        for (std::size_t j = 0; j < bases.size(); ++j) {
+          coverage.Cover(bases[j] + vid * strides[j]);
+        }
+        break;
+      }
+      test[pid] = VID_BOUND;
+    }
+    // without gains the cell is left don't-care for the vertical growth
+  }
+}
+
+void Generator_IPOG::vertical_growth(const std::vector<std::size_t> &sids,
+                                     const ConstraintChecker &checker, FeasibilityCache &feasibility,
+                                     CoverageMap &coverage, std::vector<TestCase> &tests) {
+  std::vector<std::size_t> vids;
+  std::vector<std::size_t> assigned_pids;
+  for (std::size_t i = 0; i < sids.size(); ++i) {
+    const RawStrength &raw_strength = coverage.get_raw_strength(sids[i]);
+    std::size_t end = coverage.get_offset(sids[i] + 1);
+    for (std::size_t cid = coverage.FindUncovered(coverage.get_offset(sids[i]), end);
+         cid < end; cid = coverage.FindUncovered(cid + 1, end)) {
+      coverage.GetValues(cid, vids);
+      std::size_t row = tests.size();
+      for (std::size_t r = 0; r < tests.size() && row == tests.size(); ++r) {
+        TestCase &test = tests[r];
+        bool is_compatible = true;
+        for (std::size_t j = 0; j < raw_strength.size() && is_compatible; ++j) {
+          std::size_t vid = test[raw_strength[j]];
+          is_compatible = (vid == VID_BOUND || vid == vids[j]);
+        }
+        if (!is_compatible) {
+          continue;
+        }
+        assigned_pids.clear();
+        for (std::size_t j = 0; j < raw_strength.size(); ++j) {
+          if (test[raw_strength[j]] == VID_BOUND) {
+            test[raw_strength[j]] = vids[j];
+            assigned_pids.push_back(raw_strength[j]);
+          }
+        }
+        bool is_valid = true;
+        for (std::size_t j = 0; j < assigned_pids.size() && is_valid; ++j) {
+          is_valid = checker.IsExtendable(test, assigned_pids[j]);
+        }
+        if (is_valid) {
+          row = r;
+        } else {
+          for (std::size_t j = 0; j < assigned_pids.size(); ++j) {
+            test[assigned_pids[j]] = VID_BOUND;
+          }
+        }
+      }
+      if (row == tests.size()) {
+        // with an oracle the infeasible combinations are covered already
+        if (!this->get_feasibility_oracle() && !feasibility.IsFeasible(raw_strength, vids)) {
+          // no complete test case can take the combination
+          coverage.Cover(cid);
+          this->add_infeasible();
+          continue;
+        }
+        TestCase test = checker.MakeEmptyTest();
+        for (std::size_t j = 0; j < raw_strength.size(); ++j) {
+          test[raw_strength[j]] = vids[j];
+        }
+        tests.push_back(test);
+      }
+      // the new cells may complete other combinations of pid as well
+      for (std::size_t j = 0; j < sids.size(); ++j) {
+        std::size_t covered_cid = coverage.GetCombinationId(sids[j], tests[row]);
+        if (covered_cid != CID_BOUND) {
+          coverage.Cover(covered_cid);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,83 @@
+//===----- ct_common/common/generator_ipog.h --------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the in-parameter-order covering array generator
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_GENERATOR_IPOG_H_
+#define CT_COMMON_GENERATOR_IPOG_H_
+
+#include <ct_common/common/generator.h>
+#include <ct_common/common/feasibility_cache.h>
+#include <ct_common/common/coverage_weights.h>
+
+namespace ct {
+namespace common {
+/**
+ * The in-parameter-order (IPOG) covering array generator.
+ * Parameters are added one at a time, by decreasing levels. For each new
+ * parameter, the existing test cases are first extended with the values
+ * covering the largest weight of uncovered combinations, the most with the
+ * default uniform weights (horizontal growth), then the combinations left
+ * are placed into don't-care cells of existing test cases or into new ones
+ * (vertical growth). Only the raw strengths whose last
+ * parameter is the new one are concerned at each step. Test cases are kept
+ * extendable to complete ones by ConstraintChecker::IsExtendable whenever a
+ * cell is assigned, so that only the components touched by the cell are searched.
+ * Combinations starting new test cases are checked by a FeasibilityCache, so
+ * that the symmetric ones found infeasible are not searched again, or looked
+ * up in the feasibility oracle if one is set.
+ *
+ * A suite generated for an earlier version of the model can be extended by
+ * setting it as the base tests, e.g. as read by load_test_suite with missing
+ * columns allowed. Like starter seeds, the combinations they cover are not
+ * generated again, but the base tests also come first in the result,
+ * unchanged except for their unassigned cells, which the growth fills in as
+ * don't-care cells. So a new parameter only gets new cells in the old rows,
+ * and new values only get new rows.
+ */
+class DLL_EXPORT Generator_IPOG : public Generator {
+public:
+  Generator_IPOG(void);
+  Generator_IPOG(const Generator_IPOG &from);
+  Generator_IPOG &operator = (const Generator_IPOG &right);
+  virtual ~Generator_IPOG(void);
+
+  virtual void Generate(const SUTModel &model, std::vector<TestCase> &tests);
+  virtual Generator *Clone(void) const;
+
+  virtual std::string get_class_name(void) const;
+  static std::string class_name(void);
+
+  /** Set the test cases to extend, which form the prefix of the generated suite */
+  void set_base_tests(const std::vector<TestCase> &base_tests) { this->base_tests_ = base_tests; }
+  /** Get the test cases to extend */
+  const std::vector<TestCase> &get_base_tests(void) const { return this->base_tests_; }
+  /** Set whether the infeasible combinations are found up to the symmetries of the model */
+  void set_use_symmetry(bool use_symmetry) { this->use_symmetry_ = use_symmetry; }
+  /** Get whether the infeasible combinations are found up to the symmetries of the model */
+  bool get_use_symmetry(void) const { return this->use_symmetry_; }
+
+private:
+  /** Extend the test cases with parameter pid */
+  void horizontal_growth(std::size_t pid, const std::vector<std::size_t> &sids,
+                         const ConstraintChecker &checker, const CoverageWeightTable &weights,
+                         CoverageMap &coverage, std::vector<TestCase> &tests) const;
+  /** Cover the combinations left for the parameter of the strengths sids */
+  void vertical_growth(const std::vector<std::size_t> &sids,
+                       const ConstraintChecker &checker, FeasibilityCache &feasibility,
+                       CoverageMap &coverage, std::vector<TestCase> &tests);
+
+  std::vector<TestCase> base_tests_;  /**< The test cases to extend */
+  bool use_symmetry_;  /**< Whether the infeasible combinations are found up to symmetries */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_GENERATOR_IPOG_H_
@@ -0,0 +1,288 @@
+//===----- ct_common/common/generator_oa.cpp --------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class Generator_OA
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+#include <algorithm>
+#include <functional>
+#include <ct_common/common/generator_oa.h>
+#include <ct_common/common/generator_ipog.h>
+#include <ct_common/common/galois_field.h>
+
+using namespace ct::common;
+
+namespace {
+double power(std::size_t base, std::size_t exponent) {
+  double tmp_return = 1;
+  for (std::size_t i = 0; i < exponent; ++i) {
+    tmp_return *= double(base);
+  }
+  return tmp_return;
+}
+
+/** Build Bush's OA(q^t, q+1, q, t) restricted to the first num_cols columns */
+void build_bush(const GaloisField &field, std::size_t strength, std::size_t num_cols,
+                std::vector<std::vector<std::size_t> > &rows) {
+  std::size_t q = field.get_order();
+  std::size_t num_rows = std::size_t(power(q, strength));
+  std::vector<std::size_t> coefs(strength);
+  rows.assign(num_rows, std::vector<std::size_t>(num_cols));
+  for (std::size_t r = 0; r < num_rows; ++r) {
+    for (std::size_t i = 0, x = r; i < strength; ++i, x /= q) {
+      coefs[i] = x % q;
+    }
+    for (std::size_t i = 0; i < num_cols; ++i) {
+      // the last column is the leading coefficient, i.e. the value at infinity
+      rows[r][i] = i < q ? field.Evaluate(coefs, i) : coefs[strength - 1];
+    }
+  }
+}
+
+/** Build the Rao-Hamming OA(q^k, (q^k-1)/(q-1), q, 2) restricted to the first num_cols columns */
+void build_rao_hamming(const GaloisField &field, std::size_t dimension, std::size_t num_cols,
+                       std::vector<std::vector<std::size_t> > &rows) {
+  std::size_t q = field.get_order();
+  // the points of PG(k-1, q), with the first non-zero coordinate being 1
+  std::vector<std::vector<std::size_t> > points;
+  for (std::size_t lead = 0; lead < dimension && points.size() < num_cols; ++lead) {
+    std::size_t num_tails = std::size_t(power(q, dimension - lead - 1));
+    for (std::size_t tail = 0; tail < num_tails && points.size() < num_cols; ++tail) {
+      std::vector<std::size_t> point(dimension, 0);
+      point[lead] = 1;
+      for (std::size_t i = lead + 1, x = tail; i < dimension; ++i, x /= q) {
+        point[i] = x % q;
+      }
+      points.push_back(point);
+    }
+  }
+  std::size_t num_rows = std::size_t(power(q, dimension));
+  std::vector<std::size_t> u(dimension);
+  rows.assign(num_rows, std::vector<std::size_t>(num_cols));
+  for (std::size_t r = 0; r < num_rows; ++r) {
+    for (std::size_t i = 0, x = r; i < dimension; ++i, x /= q) {
+      u[i] = x % q;
+    }
+    for (std::size_t i = 0; i < num_cols; ++i) {
+      std::size_t v = 0;
+      for (std::size_t j = 0; j < dimension; ++j) {
+        v = field.Add(v, field.Mul(u[j], points[i][j]));
+      }
+      rows[r][i] = v;
+    }
+  }
+}
+}  // namespace
+
+Generator_OA::Generator_OA(void)
+    : Generator(), fallback_(new Generator_IPOG()), max_size_ratio_(1.5),
+      construction_(CONSTRUCTION_NONE), num_constructed_(0), num_repaired_(0), num_removed_(0) {
+}
+
+Generator_OA::Generator_OA(const Generator_OA &from)
+    : Generator(from), fallback_(from.fallback_), max_size_ratio_(from.max_size_ratio_),
+      construction_(from.construction_), num_constructed_(from.num_constructed_),
+      num_repaired_(from.num_repaired_), num_removed_(from.num_removed_) {
+}
+
+Generator_OA &Generator_OA::operator = (const Generator_OA &right) {
+  Generator::operator = (right);
+  this->fallback_ = right.fallback_;
+  this->max_size_ratio_ = right.max_size_ratio_;
+  this->construction_ = right.construction_;
+  this->num_constructed_ = right.num_constructed_;
+  this->num_repaired_ = right.num_repaired_;
+  this->num_removed_ = right.num_removed_;
+  return *this;
+}
+
+Generator_OA::~Generator_OA(void) {
+}
+
+Generator *Generator_OA::Clone(void) const {
+  Generator_OA *tmp_return = new Generator_OA(*this);
+  if (this->fallback_) {
+    tmp_return->fallback_.reset(this->fallback_->Clone());
+  }
+  return tmp_return;
+}
+
+std::string Generator_OA::get_class_name(void) const {
+  return Generator_OA::class_name();
+}
+
+std::string Generator_OA::class_name(void) {
+  return "Generator_OA";
+}
+
+bool Generator_OA::choose(const SUTModel &model, std::vector<std::size_t> &block, std::size_t &strength,
+                          std::size_t &order, std::size_t &dimension) {
+  bool tmp_return = false;
+  for (std::size_t i = 0; i < model.strengths_.size(); ++i) {
+    std::vector<std::size_t> pids;
+    for (std::size_t j = 0; j < model.strengths_[i].first.size(); ++j) {
+      std::size_t pid = model.strengths_[i].first[j];
+      if (pid < model.param_specs_.size() && !model.param_specs_[pid]->is_auto()) {
+        pids.push_back(pid);
+      }
+    }
+    std::sort(pids.begin(), pids.end());
+    pids.erase(std::unique(pids.begin(), pids.end()), pids.end());
+    std::size_t t = model.strengths_[i].second;
+    if (t < 2 || pids.size() < t) {
+      continue;
+    }
+    if (tmp_return && (t < strength || (t == strength && pids.size() <= block.size()))) {
+      continue;
+    }
+    std::vector<std::size_t> levels;
+    for (std::size_t j = 0; j < pids.size(); ++j) {
+      levels.push_back(model.param_specs_[pids[j]]->get_level());
+    }
+    std::sort(levels.begin(), levels.end(), std::greater<std::size_t>());
+    if (levels[t - 1] == 0 || levels[0] > GaloisField::MAX_ORDER) {
+      continue;
+    }
+    double bound = 1;
+    for (std::size_t j = 0; j < t; ++j) {
+      bound *= double(levels[j]);
+    }
+    // Bush's construction needs t <= q and at most q + 1 columns
+    Construction construction = CONSTRUCTION_NONE;
+    std::size_t q = GaloisField::NextPrimePower(std::max(std::max(levels[0], t), pids.size() - 1));
+    std::size_t k = t;
+    double size = power(q, t);
+    if (q > GaloisField::MAX_ORDER) {
+      size = 0;
+    } else {
+      construction = CONSTRUCTION_BUSH;
+    }
+    if (t == 2) {
+      std::size_t rh_q = GaloisField::NextPrimePower(levels[0]);
+      std::size_t rh_k = 2;
+      while ((power(rh_q, rh_k) - 1) / double(rh_q - 1) < double(pids.size())) {
+        ++rh_k;
+      }
+      double rh_size = power(rh_q, rh_k);
+      if (construction == CONSTRUCTION_NONE || rh_size < size) {
+        construction = CONSTRUCTION_RAO_HAMMING;
+        q = rh_q;
+        k = rh_k;
+        size = rh_size;
+      }
+    }
+    if (construction == CONSTRUCTION_NONE || size > bound * this->max_size_ratio_) {
+      continue;
+    }
+    tmp_return = true;
+    block = pids;
+    strength = t;
+    order = q;
+    dimension = k;
+    this->construction_ = construction;
+  }
+  return tmp_return;
+}
+
+void Generator_OA::run_fallback(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->fallback_->Generate(model, tests);
+  this->set_num_combinations(this->fallback_->get_num_combinations());
+  this->add_infeasible(this->fallback_->get_num_infeasible());
+  this->add_ignored_seeds(this->fallback_->get_num_ignored_seeds());
+}
+
+void Generator_OA::Generate(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->reset_stats();
+  this->construction_ = CONSTRUCTION_NONE;
+  this->num_constructed_ = 0;
+  this->num_repaired_ = 0;
+  this->num_removed_ = 0;
+  tests.clear();
+  if (!this->fallback_) {
+    CT_EXCEPTION("no fallback generator");
+    return;
+  }
+  std::vector<std::size_t> block;
+  std::size_t strength = 0, order = 0, dimension = 0;
+  if (!this->choose(model, block, strength, order, dimension)) {
+    this->run_fallback(model, tests);
+    return;
+  }
+
+  GaloisField field(order);
+  std::vector<std::vector<std::size_t> > rows;
+  if (this->construction_ == CONSTRUCTION_BUSH) {
+    build_bush(field, strength, block.size(), rows);
+  } else {
+    build_rao_hamming(field, dimension, block.size(), rows);
+  }
+  // fold the symbols into the levels, which may make some rows the same
+  std::set<std::vector<std::size_t> > folded;
+  for (std::size_t i = 0; i < rows.size(); ++i) {
+    for (std::size_t j = 0; j < block.size(); ++j) {
+      rows[i][j] %= model.param_specs_[block[j]]->get_level();
+    }
+    folded.insert(rows[i]);
+  }
+  this->num_constructed_ = folded.size();
+
+  // repair the rows by dropping the cells which cannot be extended
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  std::vector<TestCase> oa_tests;
+  for (std::set<std::vector<std::size_t> >::const_iterator iter = folded.begin();
+       iter != folded.end(); ++iter) {
+    TestCase test = checker.MakeEmptyTest();
+    for (std::size_t j = 0; j < block.size(); ++j) {
+      test[block[j]] = (*iter)[j];
+    }
+    std::size_t num_assigned = this->repair_test(checker, test);
+    if (num_assigned < strength) {
+      ++this->num_removed_;
+      continue;
+    }
+    if (num_assigned < block.size()) {
+      ++this->num_repaired_;
+    }
+    oa_tests.push_back(test);
+  }
+
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  bool is_complete = model.seeds_.empty() && this->num_repaired_ == 0 && this->num_removed_ == 0;
+  // every raw strength must lie in the block and be no stronger than the array
+  for (std::size_t i = 0; i < coverage.get_num_raw_strengths() && is_complete; ++i) {
+    const RawStrength &raw_strength = coverage.get_raw_strength(i);
+    std::size_t num_pids = 0;
+    for (std::size_t j = 0; j < raw_strength.size() && is_complete; ++j) {
+      if (model.param_specs_[raw_strength[j]]->is_auto()) {
+        continue;
+      }
+      ++num_pids;
+      is_complete = std::binary_search(block.begin(), block.end(), raw_strength[j]);
+    }
+    is_complete = is_complete && num_pids <= strength;
+  }
+  if (is_complete) {
+    // the array alone covers every combination
+    this->set_num_combinations(coverage.get_num_combinations());
+    this->skip_auto_combinations(model, coverage);
+    for (std::size_t i = 0; i < oa_tests.size(); ++i) {
+      if (!checker.Complete(oa_tests[i])) {
+        CT_EXCEPTION("failed to complete a test case");
+      }
+      tests.push_back(oa_tests[i]);
+    }
+    return;
+  }
+
+  // the rows go first as seeds, after the seeds of the model
+  SUTModel seeded_model;
+  this->make_seeded_model(model, oa_tests, seeded_model);
+  this->run_fallback(seeded_model, tests);
+}
@@ -0,0 +1,93 @@
+//===----- ct_common/common/generator_oa.h ----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the generator based on orthogonal arrays
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_GENERATOR_OA_H_
+#define CT_COMMON_GENERATOR_OA_H_
+
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/generator.h>
+
+namespace ct {
+namespace common {
+/**
+ * The generator building orthogonal arrays over finite fields directly.
+ * The strength with the largest uniform block of parameters fitting a known
+ * construction is chosen: Bush's OA(q^t, q+1, q, t) from the polynomials of
+ * degree < t, or, for t = 2, the Rao-Hamming OA(q^k, (q^k-1)/(q-1), q, 2)
+ * from the points of the projective geometry. Here q is the smallest prime
+ * power not less than the levels in the block, and values of parameters with
+ * fewer levels are folded by modulo. A construction is only taken when its
+ * size is within max_size_ratio of the product of the t largest levels.
+ * The rows violating the constraints are repaired by dropping the offending
+ * cells, and removed if fewer than t cells are left. When the block covers
+ * the whole model with no strength above t and no row is changed, the array
+ * is the test suite;
+ * otherwise the rows are handed to the fallback generator as seeds, which
+ * covers the rest. Models fitting no construction go to the fallback directly.
+ */
+class DLL_EXPORT Generator_OA : public Generator {
+public:
+  /** The constructions */
+  enum Construction {
+    CONSTRUCTION_NONE,
+    CONSTRUCTION_BUSH,
+    CONSTRUCTION_RAO_HAMMING
+  };
+
+  Generator_OA(void);
+  Generator_OA(const Generator_OA &from);
+  Generator_OA &operator = (const Generator_OA &right);
+  virtual ~Generator_OA(void);
+
+  virtual void Generate(const SUTModel &model, std::vector<TestCase> &tests);
+  virtual Generator *Clone(void) const;
+
+  virtual std::string get_class_name(void) const;
+  static std::string class_name(void);
+
+  /** Set the generator used when no construction fits, or for the combinations left */
+  void set_fallback(const boost::shared_ptr<Generator> &fallback) { this->fallback_ = fallback; }
+  /** Get the generator used when no construction fits, or for the combinations left */
+  const boost::shared_ptr<Generator> &get_fallback(void) const { return this->fallback_; }
+  /** Set the largest accepted ratio between the size of a construction and the lower bound */
+  void set_max_size_ratio(double max_size_ratio) { this->max_size_ratio_ = max_size_ratio; }
+  /** Get the largest accepted ratio between the size of a construction and the lower bound */
+  double get_max_size_ratio(void) const { return this->max_size_ratio_; }
+
+  /** Get the construction used in the last generation */
+  Construction get_construction(void) const { return this->construction_; }
+  /** Get the number of rows of the constructed array in the last generation */
+  std::size_t get_num_constructed(void) const { return this->num_constructed_; }
+  /** Get the number of rows repaired against the constraints in the last generation */
+  std::size_t get_num_repaired(void) const { return this->num_repaired_; }
+  /** Get the number of rows removed for the constraints in the last generation */
+  std::size_t get_num_removed(void) const { return this->num_removed_; }
+
+private:
+  /** Choose the block and the construction, returns false if nothing fits */
+  bool choose(const SUTModel &model, std::vector<std::size_t> &block, std::size_t &strength,
+              std::size_t &order, std::size_t &dimension);
+  /** Run the fallback generator and take its statistics */
+  void run_fallback(const SUTModel &model, std::vector<TestCase> &tests);
+
+private:
+  boost::shared_ptr<Generator> fallback_;  /**< The fallback generator */
+  double max_size_ratio_;  /**< The largest accepted size ratio */
+  Construction construction_;  /**< The construction of the last generation */
+  std::size_t num_constructed_;  /**< The number of constructed rows */
+  std::size_t num_repaired_;  /**< The number of repaired rows */
+  std::size_t num_removed_;  /**< The number of removed rows */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_GENERATOR_OA_H_
@@ -0,0 +1,249 @@
+//===----- ct_common/common/generator_recursive.cpp -------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class Generator_Recursive
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+#include <cmath>
+#include <sstream>
+#include <algorithm>
+#include <ct_common/common/generator_recursive.h>
+#include <ct_common/common/generator_oa.h>
+#include <ct_common/common/paramspec_int.h>
+
+using namespace ct::common;
+
+Generator_Recursive::Generator_Recursive(void)
+    : Generator(), ingredient_(new Generator_OA()), max_block_size_(50),
+      num_ingredients_(0), num_composed_(0) {
+}
+
+Generator_Recursive::Generator_Recursive(const Generator_Recursive &from)
+    : Generator(from), ingredient_(from.ingredient_), max_block_size_(from.max_block_size_),
+      num_ingredients_(from.num_ingredients_), num_composed_(from.num_composed_) {
+}
+
+Generator_Recursive &Generator_Recursive::operator = (const Generator_Recursive &right) {
+  Generator::operator = (right);
+  this->ingredient_ = right.ingredient_;
+  this->max_block_size_ = right.max_block_size_;
+  this->num_ingredients_ = right.num_ingredients_;
+  this->num_composed_ = right.num_composed_;
+  this->cache_.clear();
+  return *this;
+}
+
+Generator_Recursive::~Generator_Recursive(void) {
+}
+
+Generator *Generator_Recursive::Clone(void) const {
+  Generator_Recursive *tmp_return = new Generator_Recursive(*this);
+  if (this->ingredient_) {
+    tmp_return->ingredient_.reset(this->ingredient_->Clone());
+  }
+  return tmp_return;
+}
+
+std::string Generator_Recursive::get_class_name(void) const {
+  return Generator_Recursive::class_name();
+}
+
+std::string Generator_Recursive::class_name(void) {
+  return "Generator_Recursive";
+}
+
+void Generator_Recursive::build_ingredient(std::size_t num_cols, std::size_t strength,
+                                           std::size_t num_values, Rows &rows) {
+  SUTModel model;
+  std::vector<std::string> values;
+  for (std::size_t i = 0; i < num_values; ++i) {
+    std::ostringstream ss;
+    ss << i;
+    values.push_back(ss.str());
+  }
+  std::vector<std::size_t> pids;
+  for (std::size_t i = 0; i < num_cols; ++i) {
+    std::ostringstream ss;
+    ss << "p" << i;
+    boost::shared_ptr<ParamSpec> param_spec(new ParamSpec_Int());
+    param_spec->set_param_name(ss.str());
+    param_spec->set_values(values);
+    model.param_specs_.push_back(param_spec);
+    pids.push_back(i);
+  }
+  model.strengths_.push_back(Strength(pids, std::min(strength, num_cols)));
+  std::vector<TestCase> tests;
+  this->ingredient_->Generate(model, tests);
+  rows.resize(tests.size());
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    rows[i].assign(tests[i].begin(), tests[i].end());
+  }
+  ++this->num_ingredients_;
+}
+
+const Generator_Recursive::Rows &Generator_Recursive::build(std::size_t num_cols, std::size_t strength,
+                                                            std::size_t num_values) {
+  std::pair<std::size_t, std::size_t> key(num_cols, strength);
+  std::map<std::pair<std::size_t, std::size_t>, Rows>::iterator iter = this->cache_.find(key);
+  if (iter != this->cache_.end()) {
+    return iter->second;
+  }
+  Rows rows;
+  if (num_cols <= this->max_block_size_ || num_cols <= strength || strength < 2 || strength > 3) {
+    this->build_ingredient(num_cols, strength, num_values, rows);
+  } else if (strength == 2) {
+    // the product on a k x l grid, pairs in different grid rows are covered by A, others by B
+    std::size_t k = std::size_t(std::ceil(std::sqrt(double(num_cols))));
+    std::size_t l = (num_cols + k - 1) / k;
+    const Rows &a = this->build(k, 2, num_values);
+    const Rows &b = this->build(l, 2, num_values);
+    for (std::size_t r = 0; r < a.size(); ++r) {
+      std::vector<std::size_t> row(num_cols);
+      for (std::size_t c = 0; c < num_cols; ++c) {
+        row[c] = a[r][c / l];
+      }
+      rows.push_back(row);
+    }
+    for (std::size_t r = 0; r < b.size(); ++r) {
+      std::vector<std::size_t> row(num_cols);
+      for (std::size_t c = 0; c < num_cols; ++c) {
+        row[c] = b[r][c % l];
+      }
+      rows.push_back(row);
+    }
+  } else {
+    // the Roux construction, triples over both halves with a repeated column are covered by the shifts
+    std::size_t k = (num_cols + 1) / 2;
+    const Rows &a = this->build(k, 3, num_values);
+    const Rows &b = this->build(k, 2, num_values);
+    for (std::size_t r = 0; r < a.size(); ++r) {
+      std::vector<std::size_t> row(num_cols);
+      for (std::size_t c = 0; c < num_cols; ++c) {
+        row[c] = a[r][c < k ? c : c - k];
+      }
+      rows.push_back(row);
+    }
+    for (std::size_t s = 1; s < num_values; ++s) {
+      for (std::size_t r = 0; r < b.size(); ++r) {
+        std::vector<std::size_t> row(num_cols);
+        for (std::size_t c = 0; c < num_cols; ++c) {
+          row[c] = c < k ? b[r][c] : (b[r][c - k] + s) % num_values;
+        }
+        rows.push_back(row);
+      }
+    }
+  }
+  Rows &tmp_return = this->cache_[key];
+  tmp_return.swap(rows);
+  return tmp_return;
+}
+
+void Generator_Recursive::run_ingredient(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->ingredient_->Generate(model, tests);
+  this->set_num_combinations(this->ingredient_->get_num_combinations());
+  this->add_infeasible(this->ingredient_->get_num_infeasible());
+  this->add_ignored_seeds(this->ingredient_->get_num_ignored_seeds());
+}
+
+void Generator_Recursive::Generate(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->reset_stats();
+  this->num_ingredients_ = 0;
+  this->num_composed_ = 0;
+  this->cache_.clear();
+  tests.clear();
+  if (!this->ingredient_) {
+    CT_EXCEPTION("no ingredient generator");
+    return;
+  }
+
+  // the strength of the largest t, which must subsume all others
+  std::vector<std::vector<std::size_t> > blocks(model.strengths_.size());
+  std::size_t chosen = model.strengths_.size();
+  for (std::size_t i = 0; i < model.strengths_.size(); ++i) {
+    for (std::size_t j = 0; j < model.strengths_[i].first.size(); ++j) {
+      std::size_t pid = model.strengths_[i].first[j];
+      if (pid < model.param_specs_.size() && !model.param_specs_[pid]->is_auto()) {
+        blocks[i].push_back(pid);
+      }
+    }
+    std::sort(blocks[i].begin(), blocks[i].end());
+    blocks[i].erase(std::unique(blocks[i].begin(), blocks[i].end()), blocks[i].end());
+    if (chosen == model.strengths_.size() ||
+        model.strengths_[i].second > model.strengths_[chosen].second ||
+        (model.strengths_[i].second == model.strengths_[chosen].second &&
+         blocks[i].size() > blocks[chosen].size())) {
+      chosen = i;
+    }
+  }
+  bool is_composable = chosen < model.strengths_.size();
+  std::size_t strength = is_composable ? model.strengths_[chosen].second : 0;
+  for (std::size_t i = 0; i < model.strengths_.size() && is_composable; ++i) {
+    is_composable = model.strengths_[i].second <= strength &&
+        std::includes(blocks[chosen].begin(), blocks[chosen].end(), blocks[i].begin(), blocks[i].end());
+  }
+  if (!is_composable || strength < 2 || strength > 3 || blocks[chosen].size() <= this->max_block_size_) {
+    this->run_ingredient(model, tests);
+    return;
+  }
+
+  const std::vector<std::size_t> &block = blocks[chosen];
+  std::size_t num_values = 0;
+  for (std::size_t i = 0; i < block.size(); ++i) {
+    num_values = std::max(num_values, model.param_specs_[block[i]]->get_level());
+  }
+  const Rows &rows = this->build(block.size(), strength, num_values);
+
+  // fold the symbols into the levels, and repair the rows against the constraints
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  std::set<std::vector<std::size_t> > folded;
+  std::vector<TestCase> composed;
+  bool is_repaired = false;
+  for (std::size_t r = 0; r < rows.size(); ++r) {
+    std::vector<std::size_t> cells(block.size());
+    for (std::size_t i = 0; i < block.size(); ++i) {
+      cells[i] = rows[r][i] % model.param_specs_[block[i]]->get_level();
+    }
+    if (!folded.insert(cells).second) {
+      continue;
+    }
+    TestCase test = checker.MakeEmptyTest();
+    for (std::size_t i = 0; i < block.size(); ++i) {
+      test[block[i]] = cells[i];
+    }
+    if (!model.constraints_.empty()) {
+      std::size_t num_assigned = this->repair_test(checker, test);
+      if (num_assigned < block.size()) {
+        is_repaired = true;
+      }
+      if (num_assigned < strength) {
+        continue;
+      }
+    }
+    composed.push_back(test);
+  }
+  this->num_composed_ = folded.size();
+  this->cache_.clear();
+
+  if (!is_repaired && model.seeds_.empty()) {
+    CoverageMap coverage(model.param_specs_, model.strengths_);
+    this->set_num_combinations(coverage.get_num_combinations());
+    this->skip_auto_combinations(model, coverage);
+    for (std::size_t i = 0; i < composed.size(); ++i) {
+      if (!checker.Complete(composed[i])) {
+        CT_EXCEPTION("failed to complete a test case");
+      }
+      tests.push_back(composed[i]);
+    }
+    return;
+  }
+  SUTModel seeded_model;
+  this->make_seeded_model(model, composed, seeded_model);
+  this->run_ingredient(seeded_model, tests);
+}
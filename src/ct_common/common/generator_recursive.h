@@ -0,0 +1,84 @@
+//===----- ct_common/common/generator_recursive.h ---------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the generator composing covering arrays recursively
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_GENERATOR_RECURSIVE_H_
+#define CT_COMMON_GENERATOR_RECURSIVE_H_
+
+#include <map>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/generator.h>
+
+namespace ct {
+namespace common {
+/**
+ * The generator composing covering arrays of many parameters from the arrays
+ * of few ones. It applies to models whose strengths amount to a single
+ * uniform strength t = 2 or 3 over a set of parameters, with v being their
+ * largest level. For t = 2, the columns are laid out on a k x l grid, and the
+ * product of CA(N, 2, k, v) A and CA(M, 2, l, v) B gives CA(N + M, 2, kl, v),
+ * column (i, j) taking A[.][i] then B[.][j]. For t = 3, the Roux construction
+ * doubles the columns: CA(N, 3, k, v) A and CA(M, 2, k, v) B give
+ * CA(N + (v-1)M, 3, 2k, v) of the rows [A | A] and [B | B + s], s = 1 .. v-1.
+ * Both recurse until at most max_block_size columns are left, where the
+ * ingredient generator builds the arrays on uniform models without
+ * constraints. Symbols are folded into the levels by modulo. With constraints
+ * or seeds, the rows are repaired and completed by the ingredient generator
+ * on the whole model as seeds. Other models go to the ingredient directly.
+ */
+class DLL_EXPORT Generator_Recursive : public Generator {
+public:
+  Generator_Recursive(void);
+  Generator_Recursive(const Generator_Recursive &from);
+  Generator_Recursive &operator = (const Generator_Recursive &right);
+  virtual ~Generator_Recursive(void);
+
+  virtual void Generate(const SUTModel &model, std::vector<TestCase> &tests);
+  virtual Generator *Clone(void) const;
+
+  virtual std::string get_class_name(void) const;
+  static std::string class_name(void);
+
+  /** Set the generator for the ingredient arrays and for the models not composed */
+  void set_ingredient(const boost::shared_ptr<Generator> &ingredient) { this->ingredient_ = ingredient; }
+  /** Get the generator for the ingredient arrays and for the models not composed */
+  const boost::shared_ptr<Generator> &get_ingredient(void) const { return this->ingredient_; }
+  /** Set the largest number of columns generated without composition */
+  void set_max_block_size(std::size_t max_block_size) { this->max_block_size_ = max_block_size; }
+  /** Get the largest number of columns generated without composition */
+  std::size_t get_max_block_size(void) const { return this->max_block_size_; }
+
+  /** Get the number of ingredient arrays built in the last generation */
+  std::size_t get_num_ingredients(void) const { return this->num_ingredients_; }
+  /** Get the number of rows composed in the last generation, before any repairing */
+  std::size_t get_num_composed(void) const { return this->num_composed_; }
+
+private:
+  typedef std::vector<std::vector<std::size_t> > Rows;
+
+  /** Build a covering array of the given strength on num_cols columns of num_values symbols */
+  const Rows &build(std::size_t num_cols, std::size_t strength, std::size_t num_values);
+  /** Build an ingredient array with the ingredient generator */
+  void build_ingredient(std::size_t num_cols, std::size_t strength, std::size_t num_values, Rows &rows);
+  /** Run the ingredient generator on the model and take its statistics */
+  void run_ingredient(const SUTModel &model, std::vector<TestCase> &tests);
+
+private:
+  boost::shared_ptr<Generator> ingredient_;  /**< The ingredient generator */
+  std::size_t max_block_size_;  /**< The largest block generated directly */
+  std::size_t num_ingredients_;  /**< The number of ingredient arrays built */
+  std::size_t num_composed_;  /**< The number of composed rows */
+  std::map<std::pair<std::size_t, std::size_t>, Rows> cache_;  /**< The arrays built, by columns and strength */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_GENERATOR_RECURSIVE_H_
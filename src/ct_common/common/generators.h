@@ -0,0 +1,23 @@
+//===----- ct_common/common/generators.h ------------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file includes all covering array generators
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_GENERATORS_H_
+#define CT_COMMON_GENERATORS_H_
+
+#include <ct_common/common/generator.h>
+#include <ct_common/common/generator_ipog.h>
+#include <ct_common/common/generator_aetg.h>
+#include <ct_common/common/generator_oa.h>
+#include <ct_common/common/generator_recursive.h>
+#include <ct_common/common/generator_decomposed.h>
+
+#endif  // CT_COMMON_GENERATORS_H_
@@ -0,0 +1,114 @@
+//===----- ct_common/common/mapped_file.cpp ---------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class MappedFile
+//
+//===----------------------------------------------------------------------===//
+
+#include <fstream>
+#include <iterator>
+#include <ct_common/common/mapped_file.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else  // _WIN32
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif  // _WIN32
+
+using namespace ct::common;
+
+MappedFile::MappedFile(void)
+    : data_(0), size_(0), is_open_(false), is_mapped_(false) {
+#ifdef _WIN32
+  this->file_handle_ = INVALID_HANDLE_VALUE;
+  this->mapping_handle_ = 0;
+#endif  // _WIN32
+}
+
+MappedFile::~MappedFile(void) {
+  this->Close();
+}
+
+bool MappedFile::Open(const std::string &file_name) {
+  this->Close();
+#ifdef _WIN32
+  HANDLE file = CreateFileA(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, 0);
+  if (file == INVALID_HANDLE_VALUE) {
+    return false;
+  }
+  LARGE_INTEGER file_size;
+  if (GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0) {
+    HANDLE mapping = CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0);
+    if (mapping != 0) {
+      void *view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if (view != 0) {
+        this->file_handle_ = file;
+        this->mapping_handle_ = mapping;
+        this->data_ = static_cast<const char *>(view);
+        this->size_ = static_cast<std::size_t>(file_size.QuadPart);
+        this->is_mapped_ = true;
+        this->is_open_ = true;
+        return true;
+      }
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(file);
+#else  // _WIN32
+  int fd = open(file_name.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  struct stat st;
+  if (fstat(fd, &st) == 0 && st.st_size > 0) {
+    void *addr = mmap(0, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (addr != MAP_FAILED) {
+      close(fd);
+      this->data_ = static_cast<const char *>(addr);
+      this->size_ = static_cast<std::size_t>(st.st_size);
+      this->is_mapped_ = true;
+      this->is_open_ = true;
+      return true;
+    }
+  }
+  close(fd);
+#endif  // _WIN32
+  // fall back to plain reading, e.g. for empty files or pipes
+  std::ifstream infile(file_name.c_str(), std::ios::in | std::ios::binary);
+  if (!infile.is_open()) {
+    return false;
+  }
+  this->buffer_.assign(std::istreambuf_iterator<char>(infile), std::istreambuf_iterator<char>());
+  this->data_ = this->buffer_.empty() ? 0 : &this->buffer_[0];
+  this->size_ = this->buffer_.size();
+  this->is_open_ = true;
+  return true;
+}
+
+void MappedFile::Close(void) {
+  if (this->is_mapped_) {
+#ifdef _WIN32
+    UnmapViewOfFile(this->data_);
+    CloseHandle(this->mapping_handle_);
+    CloseHandle(this->file_handle_);
+    this->mapping_handle_ = 0;
+    this->file_handle_ = INVALID_HANDLE_VALUE;
+#else  // _WIN32
+    munmap(const_cast<char *>(this->data_), this->size_);
+#endif  // _WIN32
+  }
+  this->buffer_.clear();
+  this->data_ = 0;
+  this->size_ = 0;
+  this->is_mapped_ = false;
+  this->is_open_ = false;
+}
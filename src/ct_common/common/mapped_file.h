@@ -0,0 +1,62 @@
+//===----- ct_common/common/mapped_file.h -----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for read-only memory-mapped files
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_MAPPED_FILE_H_
+#define CT_COMMON_MAPPED_FILE_H_
+
+#include <string>
+#include <vector>
+#include <ct_common/common/utils.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for read-only memory-mapped files.
+ * Falls back to reading the whole file into memory when mapping is not possible.
+ */
+class DLL_EXPORT MappedFile {
+public:
+  MappedFile(void);
+  ~MappedFile(void);
+
+  /** Map the given file, returns false if the file cannot be opened */
+  bool Open(const std::string &file_name);
+  /** Unmap the file */
+  void Close(void);
+
+  /** Whether a file is mapped */
+  bool is_open(void) const { return this->is_open_; }
+  /** Get the mapped bytes, 0 for empty files */
+  const char *get_data(void) const { return this->data_; }
+  /** Get the number of mapped bytes */
+  std::size_t get_size(void) const { return this->size_; }
+
+private:
+  // This class is not supposed to be copied
+  MappedFile(const MappedFile &from);
+  MappedFile &operator = (const MappedFile &right);
+
+private:
+  const char *data_;  /**< The mapped bytes */
+  std::size_t size_;  /**< The number of mapped bytes */
+  bool is_open_;  /**< Whether a file is mapped */
+  bool is_mapped_;  /**< Whether data_ is a real mapping (otherwise it points into buffer_) */
+  std::vector<char> buffer_;  /**< The fallback buffer */
+#ifdef _WIN32
+  void *file_handle_;  /**< The file handle */
+  void *mapping_handle_;  /**< The file mapping handle */
+#endif  // _WIN32
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_MAPPED_FILE_H_
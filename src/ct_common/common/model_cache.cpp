@@ -0,0 +1,689 @@
+//===----- ct_common/common/model_cache.cpp ---------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the functions for the binary precompiled format of SUT
+// models
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <stack>
+#include <ct_common/common/model_cache.h>
+#include <ct_common/common/mapped_file.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/seed_tuple.h>
+#include <ct_common/common/seed_constraint.h>
+
+using namespace ct::common;
+
+namespace {
+const char MAGIC[4] = { 'C', 'T', 'M', 'C' };
+const boost::uint32_t ENDIAN_MARK = 0x01020304;
+const std::size_t HEADER_SIZE = 32;  // magic, version, endian mark, reserved, source hash, file size
+
+/**
+ * Tags of the serialized tree nodes.
+ * Trees are stored in post-order, so that each node follows its operands.
+ */
+enum eNODE_TAG {
+  NT_REF,  /**< Reference to a node stored before */
+  NT_CONSTRAINT_A_EQ,
+  NT_CONSTRAINT_A_NE,
+  NT_CONSTRAINT_A_GT,
+  NT_CONSTRAINT_A_GE,
+  NT_CONSTRAINT_A_LT,
+  NT_CONSTRAINT_A_LE,
+  NT_CONSTRAINT_L_AND,
+  NT_CONSTRAINT_L_OR,
+  NT_CONSTRAINT_L_XOR,
+  NT_CONSTRAINT_L_IMPLY,
+  NT_CONSTRAINT_L_IFF,
+  NT_CONSTRAINT_L_NOT,
+  NT_CONSTRAINT_L_CBOOL,
+  NT_CONSTRAINT_L_IVLD,
+  NT_CONSTRAINT_L_PARAM,
+  NT_CONSTRAINT_S_EQ,
+  NT_CONSTRAINT_S_NE,
+  NT_EXP_A_ADD,
+  NT_EXP_A_SUB,
+  NT_EXP_A_MULT,
+  NT_EXP_A_DIV,
+  NT_EXP_A_MOD,
+  NT_EXP_A_NEG,
+  NT_EXP_A_CAST,
+  NT_EXP_A_CONSTRAINTCAST,
+  NT_EXP_A_CINT,
+  NT_EXP_A_CDOUBLE,
+  NT_EXP_A_PARAM,
+  NT_EXP_S_CSTRING,
+  NT_EXP_S_PARAM,
+};
+
+/** Parameter types */
+enum ePARAM_KIND {
+  PK_INT,
+  PK_DOUBLE,
+  PK_STRING,
+  PK_BOOL,
+};
+
+/** Seed types */
+enum eSEED_KIND {
+  SK_TUPLE,
+  SK_CONSTRAINT,
+};
+
+/** Appending plain values to a byte buffer */
+class Writer {
+public:
+  explicit Writer(std::vector<char> &buffer) : buffer_(buffer) {}
+
+  void put_bytes(const void *data, std::size_t size) {
+    const char *bytes = static_cast<const char *>(data);
+    this->buffer_.insert(this->buffer_.end(), bytes, bytes + size);
+  }
+  void put_u8(boost::uint8_t val) { this->put_bytes(&val, sizeof(val)); }
+  void put_u32(boost::uint32_t val) { this->put_bytes(&val, sizeof(val)); }
+  void put_u64(boost::uint64_t val) { this->put_bytes(&val, sizeof(val)); }
+  void put_i32(boost::int32_t val) { this->put_bytes(&val, sizeof(val)); }
+  void put_f64(double val) { this->put_bytes(&val, sizeof(val)); }
+  void put_str(const std::string &str) {
+    this->put_u32(static_cast<boost::uint32_t>(str.size()));
+    this->put_bytes(str.data(), str.size());
+  }
+  /** Overwrite a previously written u32 */
+  void patch_u32(std::size_t pos, boost::uint32_t val) {
+    std::memcpy(&this->buffer_[pos], &val, sizeof(val));
+  }
+  std::size_t pos(void) const { return this->buffer_.size(); }
+
+private:
+  std::vector<char> &buffer_;
+};
+
+/** Reading plain values from (possibly mapped) memory, with bounds checking */
+class Reader {
+public:
+  Reader(const char *data, std::size_t size) : data_(data), size_(size), pos_(0) {}
+
+  const char *get_bytes(std::size_t size) {
+    if (size > this->size_ - this->pos_) {
+      CT_EXCEPTION("corrupted model cache: unexpected end of data");
+    }
+    const char *tmp_return = this->data_ + this->pos_;
+    this->pos_ += size;
+    return tmp_return;
+  }
+  boost::uint8_t get_u8(void) { boost::uint8_t val; std::memcpy(&val, this->get_bytes(sizeof(val)), sizeof(val)); return val; }
+  boost::uint32_t get_u32(void) { boost::uint32_t val; std::memcpy(&val, this->get_bytes(sizeof(val)), sizeof(val)); return val; }
+  boost::uint64_t get_u64(void) { boost::uint64_t val; std::memcpy(&val, this->get_bytes(sizeof(val)), sizeof(val)); return val; }
+  boost::int32_t get_i32(void) { boost::int32_t val; std::memcpy(&val, this->get_bytes(sizeof(val)), sizeof(val)); return val; }
+  double get_f64(void) { double val; std::memcpy(&val, this->get_bytes(sizeof(val)), sizeof(val)); return val; }
+  std::string get_str(void) {
+    boost::uint32_t size = this->get_u32();
+    const char *bytes = this->get_bytes(size);
+    return std::string(bytes, size);
+  }
+  bool at_end(void) const { return this->pos_ == this->size_; }
+
+private:
+  const char *data_;
+  std::size_t size_;
+  std::size_t pos_;
+};
+
+eNODE_TAG tag_of(const TreeNode *node) {
+  if (TYPE_CHECK(node, const Constraint_A_EQ*)) return NT_CONSTRAINT_A_EQ;
+  if (TYPE_CHECK(node, const Constraint_A_NE*)) return NT_CONSTRAINT_A_NE;
+  if (TYPE_CHECK(node, const Constraint_A_GT*)) return NT_CONSTRAINT_A_GT;
+  if (TYPE_CHECK(node, const Constraint_A_GE*)) return NT_CONSTRAINT_A_GE;
+  if (TYPE_CHECK(node, const Constraint_A_LT*)) return NT_CONSTRAINT_A_LT;
+  if (TYPE_CHECK(node, const Constraint_A_LE*)) return NT_CONSTRAINT_A_LE;
+  if (TYPE_CHECK(node, const Constraint_L_And*)) return NT_CONSTRAINT_L_AND;
+  if (TYPE_CHECK(node, const Constraint_L_Or*)) return NT_CONSTRAINT_L_OR;
+  if (TYPE_CHECK(node, const Constraint_L_Xor*)) return NT_CONSTRAINT_L_XOR;
+  if (TYPE_CHECK(node, const Constraint_L_Imply*)) return NT_CONSTRAINT_L_IMPLY;
+  if (TYPE_CHECK(node, const Constraint_L_Iff*)) return NT_CONSTRAINT_L_IFF;
+  if (TYPE_CHECK(node, const Constraint_L_Not*)) return NT_CONSTRAINT_L_NOT;
+  if (TYPE_CHECK(node, const Constraint_L_CBool*)) return NT_CONSTRAINT_L_CBOOL;
+  if (TYPE_CHECK(node, const Constraint_L_IVLD*)) return NT_CONSTRAINT_L_IVLD;
+  if (TYPE_CHECK(node, const Constraint_L_Param*)) return NT_CONSTRAINT_L_PARAM;
+  if (TYPE_CHECK(node, const Constraint_S_EQ*)) return NT_CONSTRAINT_S_EQ;
+  if (TYPE_CHECK(node, const Constraint_S_NE*)) return NT_CONSTRAINT_S_NE;
+  if (TYPE_CHECK(node, const Exp_A_Add*)) return NT_EXP_A_ADD;
+  if (TYPE_CHECK(node, const Exp_A_Sub*)) return NT_EXP_A_SUB;
+  if (TYPE_CHECK(node, const Exp_A_Mult*)) return NT_EXP_A_MULT;
+  if (TYPE_CHECK(node, const Exp_A_Div*)) return NT_EXP_A_DIV;
+  if (TYPE_CHECK(node, const Exp_A_Mod*)) return NT_EXP_A_MOD;
+  if (TYPE_CHECK(node, const Exp_A_Neg*)) return NT_EXP_A_NEG;
+  if (TYPE_CHECK(node, const Exp_A_Cast*)) return NT_EXP_A_CAST;
+  if (TYPE_CHECK(node, const Exp_A_ConstraintCast*)) return NT_EXP_A_CONSTRAINTCAST;
+  if (TYPE_CHECK(node, const Exp_A_CInt*)) return NT_EXP_A_CINT;
+  if (TYPE_CHECK(node, const Exp_A_CDouble*)) return NT_EXP_A_CDOUBLE;
+  if (TYPE_CHECK(node, const Exp_A_Param*)) return NT_EXP_A_PARAM;
+  if (TYPE_CHECK(node, const Exp_S_CString*)) return NT_EXP_S_CSTRING;
+  if (TYPE_CHECK(node, const Exp_S_Param*)) return NT_EXP_S_PARAM;
+  CT_EXCEPTION(std::string("cannot serialize tree node of type ") + node->get_class_name());
+  return NT_REF;
+}
+
+TreeNode *create_node(boost::uint8_t tag) {
+  switch (tag) {
+  case NT_CONSTRAINT_A_EQ: return new Constraint_A_EQ();
+  case NT_CONSTRAINT_A_NE: return new Constraint_A_NE();
+  case NT_CONSTRAINT_A_GT: return new Constraint_A_GT();
+  case NT_CONSTRAINT_A_GE: return new Constraint_A_GE();
+  case NT_CONSTRAINT_A_LT: return new Constraint_A_LT();
+  case NT_CONSTRAINT_A_LE: return new Constraint_A_LE();
+  case NT_CONSTRAINT_L_AND: return new Constraint_L_And();
+  case NT_CONSTRAINT_L_OR: return new Constraint_L_Or();
+  case NT_CONSTRAINT_L_XOR: return new Constraint_L_Xor();
+  case NT_CONSTRAINT_L_IMPLY: return new Constraint_L_Imply();
+  case NT_CONSTRAINT_L_IFF: return new Constraint_L_Iff();
+  case NT_CONSTRAINT_L_NOT: return new Constraint_L_Not();
+  case NT_CONSTRAINT_L_CBOOL: return new Constraint_L_CBool();
+  case NT_CONSTRAINT_L_IVLD: return new Constraint_L_IVLD();
+  case NT_CONSTRAINT_L_PARAM: return new Constraint_L_Param();
+  case NT_CONSTRAINT_S_EQ: return new Constraint_S_EQ();
+  case NT_CONSTRAINT_S_NE: return new Constraint_S_NE();
+  case NT_EXP_A_ADD: return new Exp_A_Add();
+  case NT_EXP_A_SUB: return new Exp_A_Sub();
+  case NT_EXP_A_MULT: return new Exp_A_Mult();
+  case NT_EXP_A_DIV: return new Exp_A_Div();
+  case NT_EXP_A_MOD: return new Exp_A_Mod();
+  case NT_EXP_A_NEG: return new Exp_A_Neg();
+  case NT_EXP_A_CAST: return new Exp_A_Cast();
+  case NT_EXP_A_CONSTRAINTCAST: return new Exp_A_ConstraintCast();
+  case NT_EXP_A_CINT: return new Exp_A_CInt();
+  case NT_EXP_A_CDOUBLE: return new Exp_A_CDouble();
+  case NT_EXP_A_PARAM: return new Exp_A_Param();
+  case NT_EXP_S_CSTRING: return new Exp_S_CString();
+  case NT_EXP_S_PARAM: return new Exp_S_Param();
+  default:
+    CT_EXCEPTION("corrupted model cache: unknown tree node tag");
+    return 0;
+  }
+}
+
+/** Write the node-specific fields (operands are written before) */
+void write_node_fields(Writer &writer, const TreeNode *node, eNODE_TAG tag) {
+  if (TYPE_CHECK(node, const Exp_A*)) {
+    writer.put_u8(static_cast<boost::uint8_t>(dynamic_cast<const Exp_A *>(node)->get_type()));
+  }
+  switch (tag) {
+  case NT_CONSTRAINT_A_EQ:
+  case NT_CONSTRAINT_A_NE:
+  case NT_CONSTRAINT_A_GT:
+  case NT_CONSTRAINT_A_GE:
+  case NT_CONSTRAINT_A_LT:
+  case NT_CONSTRAINT_A_LE:
+    writer.put_f64(dynamic_cast<const Constraint_A_Binary *>(node)->get_precision());
+    break;
+  case NT_CONSTRAINT_L_CBOOL:
+    writer.put_u8(dynamic_cast<const Constraint_L_CBool *>(node)->get_value() ? 1 : 0);
+    break;
+  case NT_CONSTRAINT_L_IVLD:
+    writer.put_u32(static_cast<boost::uint32_t>(dynamic_cast<const Constraint_L_IVLD *>(node)->get_pid()));
+    break;
+  case NT_CONSTRAINT_L_PARAM:
+    writer.put_u32(static_cast<boost::uint32_t>(dynamic_cast<const Constraint_L_Param *>(node)->get_pid()));
+    break;
+  case NT_EXP_A_CINT:
+    writer.put_i32(dynamic_cast<const Exp_A_CInt *>(node)->get_value());
+    writer.put_str(node->get_str_value());
+    break;
+  case NT_EXP_A_CDOUBLE:
+    writer.put_f64(dynamic_cast<const Exp_A_CDouble *>(node)->get_value());
+    writer.put_str(node->get_str_value());
+    break;
+  case NT_EXP_A_PARAM:
+    writer.put_u32(static_cast<boost::uint32_t>(dynamic_cast<const Exp_A_Param *>(node)->get_pid()));
+    break;
+  case NT_EXP_S_CSTRING:
+    writer.put_str(dynamic_cast<const Exp_S_CString *>(node)->get_value());
+    break;
+  case NT_EXP_S_PARAM:
+    writer.put_u32(static_cast<boost::uint32_t>(dynamic_cast<const Exp_S_Param *>(node)->get_pid()));
+    break;
+  default:
+    break;
+  }
+}
+
+/** Read the node-specific fields and attach the operands */
+void read_node_fields(Reader &reader, TreeNode *node, boost::uint8_t tag,
+                      const std::vector<boost::shared_ptr<TreeNode> > &oprds) {
+  if (TYPE_CHECK(node, Exp_A*)) {
+    boost::uint8_t type = reader.get_u8();
+    if (type != EAT_INT && type != EAT_DOUBLE) {
+      CT_EXCEPTION("corrupted model cache: unknown expression type");
+    }
+    dynamic_cast<Exp_A *>(node)->set_type(static_cast<eEXP_A_TYPE>(type));
+  }
+  if (TYPE_CHECK(node, Constraint_A_Binary*)) {
+    Constraint_A_Binary *constr = dynamic_cast<Constraint_A_Binary *>(node);
+    constr->set_loprd(oprds[0]);
+    constr->set_roprd(oprds[1]);
+    constr->set_precision(reader.get_f64());
+  } else if (TYPE_CHECK(node, Constraint_L_Binary*)) {
+    Constraint_L_Binary *constr = dynamic_cast<Constraint_L_Binary *>(node);
+    constr->set_loprd(oprds[0]);
+    constr->set_roprd(oprds[1]);
+  } else if (TYPE_CHECK(node, Constraint_L_Unary*)) {
+    dynamic_cast<Constraint_L_Unary *>(node)->set_oprd(oprds[0]);
+  } else if (TYPE_CHECK(node, Constraint_S_Binary*)) {
+    Constraint_S_Binary *constr = dynamic_cast<Constraint_S_Binary *>(node);
+    constr->set_loprd(oprds[0]);
+    constr->set_roprd(oprds[1]);
+  } else if (TYPE_CHECK(node, Exp_A_Binary*)) {
+    Exp_A_Binary *exp = dynamic_cast<Exp_A_Binary *>(node);
+    exp->set_loprd(oprds[0]);
+    exp->set_roprd(oprds[1]);
+  } else if (TYPE_CHECK(node, Exp_A_Unary*)) {
+    dynamic_cast<Exp_A_Unary *>(node)->set_oprd(oprds[0]);
+  } else if (TYPE_CHECK(node, Exp_A_ConstraintCast*)) {
+    dynamic_cast<Exp_A_ConstraintCast *>(node)->set_oprd(oprds[0]);
+  }
+  switch (tag) {
+  case NT_CONSTRAINT_L_CBOOL:
+    dynamic_cast<Constraint_L_CBool *>(node)->set_value(reader.get_u8() != 0);
+    break;
+  case NT_CONSTRAINT_L_IVLD:
+    dynamic_cast<Constraint_L_IVLD *>(node)->set_pid(reader.get_u32());
+    break;
+  case NT_CONSTRAINT_L_PARAM:
+    dynamic_cast<Constraint_L_Param *>(node)->set_pid(reader.get_u32());
+    break;
+  case NT_EXP_A_CINT: {
+    Exp_A_CInt *exp = dynamic_cast<Exp_A_CInt *>(node);
+    exp->set_value(static_cast<int>(reader.get_i32()));
+    exp->set_str_value(reader.get_str());
+    break;
+  }
+  case NT_EXP_A_CDOUBLE: {
+    Exp_A_CDouble *exp = dynamic_cast<Exp_A_CDouble *>(node);
+    exp->set_value(reader.get_f64());
+    exp->set_str_value(reader.get_str());
+    break;
+  }
+  case NT_EXP_A_PARAM:
+    dynamic_cast<Exp_A_Param *>(node)->set_pid(reader.get_u32());
+    break;
+  case NT_EXP_S_CSTRING:
+    dynamic_cast<Exp_S_CString *>(node)->set_value(reader.get_str());
+    break;
+  case NT_EXP_S_PARAM:
+    dynamic_cast<Exp_S_Param *>(node)->set_pid(reader.get_u32());
+    break;
+  default:
+    break;
+  }
+}
+
+/**
+ * Write a tree in post-order without recursion, since trees such as long
+ * conjunctions can be deep. Nodes already written are referenced by their ids.
+ */
+void write_tree(Writer &writer, const TreeNode *root,
+                std::map<const TreeNode *, boost::uint32_t> &node_ids) {
+  if (root == 0) {
+    CT_EXCEPTION("cannot serialize empty tree nodes");
+  }
+  std::size_t count_pos = writer.pos();
+  boost::uint32_t count = 0;
+  writer.put_u32(0);
+  std::stack<std::pair<const TreeNode *, std::size_t> > s;
+  std::map<const TreeNode *, boost::uint32_t>::const_iterator iter = node_ids.find(root);
+  if (iter != node_ids.end()) {
+    writer.put_u8(NT_REF);
+    writer.put_u32(iter->second);
+    writer.patch_u32(count_pos, 1);
+    return;
+  }
+  s.push(std::pair<const TreeNode *, std::size_t>(root, 0));
+  while (!s.empty()) {
+    const TreeNode *node = s.top().first;
+    if (s.top().second < node->get_oprds().size()) {
+      const TreeNode *next = node->get_oprds()[s.top().second].get();
+      ++s.top().second;
+      if (next == 0) {
+        CT_EXCEPTION("cannot serialize empty tree nodes");
+      }
+      iter = node_ids.find(next);
+      if (iter != node_ids.end()) {
+        writer.put_u8(NT_REF);
+        writer.put_u32(iter->second);
+        ++count;
+        continue;
+      }
+      s.push(std::pair<const TreeNode *, std::size_t>(next, 0));
+      continue;
+    }
+    eNODE_TAG tag = tag_of(node);
+    writer.put_u8(static_cast<boost::uint8_t>(tag));
+    write_node_fields(writer, node, tag);
+    boost::uint32_t id = static_cast<boost::uint32_t>(node_ids.size());
+    node_ids[node] = id;
+    ++count;
+    s.pop();
+  }
+  writer.patch_u32(count_pos, count);
+}
+
+boost::shared_ptr<TreeNode> read_tree(Reader &reader,
+                                      std::vector<boost::shared_ptr<TreeNode> > &nodes) {
+  boost::uint32_t count = reader.get_u32();
+  std::vector<boost::shared_ptr<TreeNode> > values;
+  std::vector<boost::shared_ptr<TreeNode> > oprds;
+  for (boost::uint32_t i = 0; i < count; ++i) {
+    boost::uint8_t tag = reader.get_u8();
+    if (tag == NT_REF) {
+      boost::uint32_t id = reader.get_u32();
+      if (id >= nodes.size()) {
+        CT_EXCEPTION("corrupted model cache: bad node reference");
+      }
+      values.push_back(nodes[id]);
+      continue;
+    }
+    boost::shared_ptr<TreeNode> node(create_node(tag));
+    // the operands have been created with the node's constructor
+    std::size_t arity = node->get_oprds().size();
+    if (arity > values.size()) {
+      CT_EXCEPTION("corrupted model cache: missing operands");
+    }
+    oprds.assign(values.end() - arity, values.end());
+    values.resize(values.size() - arity);
+    read_node_fields(reader, node.get(), tag, oprds);
+    nodes.push_back(node);
+    values.push_back(node);
+  }
+  if (values.size() != 1) {
+    CT_EXCEPTION("corrupted model cache: malformed tree");
+  }
+  return values[0];
+}
+
+void write_param_spec(Writer &writer, const ParamSpec &param_spec,
+                      std::map<const TreeNode *, boost::uint32_t> &node_ids) {
+  if (TYPE_CHECK(&param_spec, const ParamSpec_Int*)) {
+    writer.put_u8(PK_INT);
+  } else if (TYPE_CHECK(&param_spec, const ParamSpec_Double*)) {
+    writer.put_u8(PK_DOUBLE);
+  } else if (TYPE_CHECK(&param_spec, const ParamSpec_String*)) {
+    writer.put_u8(PK_STRING);
+  } else if (TYPE_CHECK(&param_spec, const ParamSpec_Bool*)) {
+    writer.put_u8(PK_BOOL);
+  } else {
+    CT_EXCEPTION(std::string("cannot serialize parameter of type ") + param_spec.get_class_name());
+  }
+  const ParamSpec_Int *param_spec_int = dynamic_cast<const ParamSpec_Int *>(&param_spec);
+  bool is_range = (param_spec_int != 0 && param_spec_int->is_range());
+  writer.put_u8((param_spec.is_aux() ? 1 : 0) | (param_spec.is_auto() ? 2 : 0) | (is_range ? 4 : 0));
+  writer.put_str(param_spec.get_param_name());
+  if (is_range) {
+    writer.put_u32(static_cast<boost::uint32_t>(param_spec.get_num_values()));
+    writer.put_i32(param_spec_int->get_int_value(0));
+    writer.put_i32(param_spec.get_num_values() > 1 ? param_spec_int->get_int_value(1) - param_spec_int->get_int_value(0) : 1);
+  } else {
+    // the trailing invalid value is added back by set_values
+    writer.put_u32(static_cast<boost::uint32_t>(param_spec.get_num_values()));
+    for (std::size_t i = 0; i < param_spec.get_num_values(); ++i) {
+      writer.put_str(param_spec.get_string_values()[i]);
+    }
+  }
+  const std::vector<std::pair<boost::shared_ptr<TreeNode>, boost::shared_ptr<TreeNode> > > &specs =
+      param_spec.get_auto_value_specs();
+  writer.put_u32(static_cast<boost::uint32_t>(specs.size()));
+  for (std::size_t i = 0; i < specs.size(); ++i) {
+    write_tree(writer, specs[i].first.get(), node_ids);
+    write_tree(writer, specs[i].second.get(), node_ids);
+  }
+}
+
+boost::shared_ptr<ParamSpec> read_param_spec(Reader &reader,
+                                             std::vector<boost::shared_ptr<TreeNode> > &nodes) {
+  boost::shared_ptr<ParamSpec> tmp_return;
+  switch (reader.get_u8()) {
+  case PK_INT:
+    tmp_return.reset(new ParamSpec_Int());
+    break;
+  case PK_DOUBLE:
+    tmp_return.reset(new ParamSpec_Double());
+    break;
+  case PK_STRING:
+    tmp_return.reset(new ParamSpec_String());
+    break;
+  case PK_BOOL:
+    tmp_return.reset(new ParamSpec_Bool());
+    break;
+  default:
+    CT_EXCEPTION("corrupted model cache: unknown parameter type");
+  }
+  boost::uint8_t flags = reader.get_u8();
+  tmp_return->set_aux((flags & 1) != 0);
+  tmp_return->set_auto((flags & 2) != 0);
+  tmp_return->set_param_name(reader.get_str());
+  boost::uint32_t num_values = reader.get_u32();
+  if ((flags & 4) != 0) {
+    ParamSpec_Int *param_spec_int = dynamic_cast<ParamSpec_Int *>(tmp_return.get());
+    if (param_spec_int == 0) {
+      CT_EXCEPTION("corrupted model cache: range values for a non-integer parameter");
+    }
+    int val_begin = static_cast<int>(reader.get_i32());
+    int step = static_cast<int>(reader.get_i32());
+    param_spec_int->set_range(val_begin, step, num_values);
+  } else if (num_values > 0) {
+    std::vector<std::string> values;
+    values.reserve(num_values);
+    for (boost::uint32_t i = 0; i < num_values; ++i) {
+      values.push_back(reader.get_str());
+    }
+    tmp_return->set_values(values);
+  }
+  boost::uint32_t num_specs = reader.get_u32();
+  for (boost::uint32_t i = 0; i < num_specs; ++i) {
+    boost::shared_ptr<TreeNode> cond = read_tree(reader, nodes);
+    boost::shared_ptr<TreeNode> exp = read_tree(reader, nodes);
+    tmp_return->auto_value_specs().push_back(
+        std::pair<boost::shared_ptr<TreeNode>, boost::shared_ptr<TreeNode> >(cond, exp));
+  }
+  return tmp_return;
+}
+
+boost::shared_ptr<Constraint> to_constraint(const boost::shared_ptr<TreeNode> &node) {
+  boost::shared_ptr<Constraint> tmp_return = boost::dynamic_pointer_cast<Constraint>(node);
+  if (!tmp_return) {
+    CT_EXCEPTION("corrupted model cache: expecting a constraint");
+  }
+  return tmp_return;
+}
+}  // namespace
+
+boost::uint64_t ct::common::hash_model_source(const char *data, std::size_t size) {
+  boost::uint64_t hash = 14695981039346656037ULL;
+  for (std::size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<unsigned char>(data[i]);
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+void ct::common::serialize_model(const SUTModel &model, boost::uint64_t source_hash,
+                                 std::vector<char> &buffer) {
+  buffer.clear();
+  Writer writer(buffer);
+  writer.put_bytes(MAGIC, sizeof(MAGIC));
+  writer.put_u32(MODEL_CACHE_VERSION);
+  writer.put_u32(ENDIAN_MARK);
+  writer.put_u32(0);
+  writer.put_u64(source_hash);
+  writer.put_u64(0);  // the total size, patched at last
+
+  std::map<const TreeNode *, boost::uint32_t> node_ids;
+  writer.put_u32(static_cast<boost::uint32_t>(model.param_specs_.size()));
+  for (std::size_t i = 0; i < model.param_specs_.size(); ++i) {
+    write_param_spec(writer, *model.param_specs_[i], node_ids);
+  }
+  writer.put_u32(static_cast<boost::uint32_t>(model.strengths_.size()));
+  for (std::size_t i = 0; i < model.strengths_.size(); ++i) {
+    writer.put_u32(static_cast<boost::uint32_t>(model.strengths_[i].first.size()));
+    for (std::size_t j = 0; j < model.strengths_[i].first.size(); ++j) {
+      writer.put_u32(static_cast<boost::uint32_t>(model.strengths_[i].first[j]));
+    }
+    writer.put_u32(static_cast<boost::uint32_t>(model.strengths_[i].second));
+  }
+  writer.put_u32(static_cast<boost::uint32_t>(model.seeds_.size()));
+  for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+    const Seed *seed = model.seeds_[i].get();
+    if (TYPE_CHECK(seed, const Seed_Tuple*)) {
+      writer.put_u8(SK_TUPLE);
+    } else if (TYPE_CHECK(seed, const Seed_Constraint*)) {
+      writer.put_u8(SK_CONSTRAINT);
+    } else {
+      CT_EXCEPTION("cannot serialize seed of unknown type");
+    }
+    writer.put_u64(seed->get_id());
+    writer.put_u8(seed->get_is_starter() ? 1 : 0);
+    if (TYPE_CHECK(seed, const Seed_Tuple*)) {
+      const Tuple &tuple = dynamic_cast<const Seed_Tuple *>(seed)->get_tuple();
+      writer.put_u32(static_cast<boost::uint32_t>(tuple.size()));
+      for (std::size_t j = 0; j < tuple.size(); ++j) {
+        writer.put_u32(static_cast<boost::uint32_t>(tuple[j].pid_));
+        writer.put_u32(static_cast<boost::uint32_t>(tuple[j].vid_));
+      }
+    } else {
+      write_tree(writer, dynamic_cast<const Seed_Constraint *>(seed)->get_constraint().get(), node_ids);
+    }
+  }
+  writer.put_u32(static_cast<boost::uint32_t>(model.constraints_.size()));
+  for (std::size_t i = 0; i < model.constraints_.size(); ++i) {
+    write_tree(writer, model.constraints_[i].get(), node_ids);
+  }
+  const std::vector<double> &strength_weights = model.weights_.get_strength_weights();
+  writer.put_u32(static_cast<boost::uint32_t>(strength_weights.size()));
+  for (std::size_t i = 0; i < strength_weights.size(); ++i) {
+    writer.put_f64(strength_weights[i]);
+  }
+  const std::vector<std::vector<double> > &value_weights = model.weights_.get_value_weights();
+  writer.put_u32(static_cast<boost::uint32_t>(value_weights.size()));
+  for (std::size_t i = 0; i < value_weights.size(); ++i) {
+    writer.put_u32(static_cast<boost::uint32_t>(value_weights[i].size()));
+    for (std::size_t j = 0; j < value_weights[i].size(); ++j) {
+      writer.put_f64(value_weights[i][j]);
+    }
+  }
+  boost::uint64_t total_size = buffer.size();
+  std::memcpy(&buffer[HEADER_SIZE - sizeof(total_size)], &total_size, sizeof(total_size));
+}
+
+bool ct::common::deserialize_model(const char *data, std::size_t size,
+                                   boost::uint64_t source_hash, SUTModel &model) {
+  if (size < HEADER_SIZE || std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+    return false;
+  }
+  Reader reader(data, size);
+  reader.get_bytes(sizeof(MAGIC));
+  if (reader.get_u32() != MODEL_CACHE_VERSION ||
+      reader.get_u32() != ENDIAN_MARK) {
+    return false;
+  }
+  reader.get_u32();
+  if (reader.get_u64() != source_hash || reader.get_u64() != size) {
+    return false;
+  }
+
+  SUTModel tmp_model;
+  tmp_model.arena_ = NodeArena::Create();
+  NodeArena::Scope arena_scope(tmp_model.arena_.get());
+  std::vector<boost::shared_ptr<TreeNode> > nodes;
+  boost::uint32_t num_params = reader.get_u32();
+  for (boost::uint32_t i = 0; i < num_params; ++i) {
+    tmp_model.param_specs_.push_back(read_param_spec(reader, nodes));
+  }
+  boost::uint32_t num_strengths = reader.get_u32();
+  for (boost::uint32_t i = 0; i < num_strengths; ++i) {
+    Strength strength;
+    boost::uint32_t num_pids = reader.get_u32();
+    for (boost::uint32_t j = 0; j < num_pids; ++j) {
+      strength.first.push_back(reader.get_u32());
+    }
+    strength.second = reader.get_u32();
+    tmp_model.strengths_.push_back(strength);
+  }
+  boost::uint32_t num_seeds = reader.get_u32();
+  for (boost::uint32_t i = 0; i < num_seeds; ++i) {
+    boost::uint8_t kind = reader.get_u8();
+    boost::uint64_t id = reader.get_u64();
+    bool is_starter = (reader.get_u8() != 0);
+    boost::shared_ptr<Seed> seed;
+    if (kind == SK_TUPLE) {
+      Seed_Tuple *seed_tuple = new Seed_Tuple();
+      seed.reset(seed_tuple);
+      boost::uint32_t num_pvpairs = reader.get_u32();
+      for (boost::uint32_t j = 0; j < num_pvpairs; ++j) {
+        std::size_t pid = reader.get_u32();
+        std::size_t vid = reader.get_u32();
+        seed_tuple->the_tuple().push_back(PVPair(pid, vid));
+      }
+    } else if (kind == SK_CONSTRAINT) {
+      Seed_Constraint *seed_constraint = new Seed_Constraint();
+      seed.reset(seed_constraint);
+      seed_constraint->the_constraint() = to_constraint(read_tree(reader, nodes));
+    } else {
+      CT_EXCEPTION("corrupted model cache: unknown seed type");
+    }
+    seed->set_id(static_cast<std::size_t>(id));
+    seed->set_is_starter(is_starter);
+    tmp_model.seeds_.push_back(seed);
+  }
+  boost::uint32_t num_constraints = reader.get_u32();
+  for (boost::uint32_t i = 0; i < num_constraints; ++i) {
+    tmp_model.constraints_.push_back(to_constraint(read_tree(reader, nodes)));
+  }
+  boost::uint32_t num_strength_weights = reader.get_u32();
+  for (boost::uint32_t i = 0; i < num_strength_weights; ++i) {
+    tmp_model.weights_.set_strength_weight(i, reader.get_f64());
+  }
+  boost::uint32_t num_weighted_params = reader.get_u32();
+  for (boost::uint32_t i = 0; i < num_weighted_params; ++i) {
+    boost::uint32_t num_value_weights = reader.get_u32();
+    for (boost::uint32_t j = 0; j < num_value_weights; ++j) {
+      tmp_model.weights_.set_value_weight(i, j, reader.get_f64());
+    }
+  }
+  if (!reader.at_end()) {
+    CT_EXCEPTION("corrupted model cache: trailing data");
+  }
+  model = tmp_model;
+  return true;
+}
+
+bool ct::common::save_model_cache(const std::string &file_name, const SUTModel &model,
+                                  boost::uint64_t source_hash) {
+  std::vector<char> buffer;
+  serialize_model(model, source_hash, buffer);
+  std::ofstream outfile(file_name.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  if (!outfile.is_open()) {
+    return false;
+  }
+  outfile.write(&buffer[0], buffer.size());
+  return outfile.good();
+}
+
+bool ct::common::load_model_cache(const std::string &file_name, boost::uint64_t source_hash,
+                                  SUTModel &model) {
+  MappedFile file;
+  if (!file.Open(file_name)) {
+    return false;
+  }
+  return deserialize_model(file.get_data(), file.get_size(), source_hash, model);
+}
@@ -0,0 +1,61 @@
+//===----- ct_common/common/model_cache.h -----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the functions for the binary precompiled format
+// of SUT models, which can be loaded without running the parser
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_MODEL_CACHE_H_
+#define CT_COMMON_MODEL_CACHE_H_
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+
+namespace ct {
+namespace common {
+/**
+ * The version of the binary model format. Caches of other versions are
+ * treated as out-dated.
+ */
+const boost::uint32_t MODEL_CACHE_VERSION = 3;
+
+/** Compute the hash (64-bit FNV-1a) of the source text of a model */
+boost::uint64_t hash_model_source(const char *data, std::size_t size);
+
+/**
+ * Serialize a model into the binary format.
+ * Shared sub-trees of constraints and auto value specifications are stored only once.
+ */
+void serialize_model(const SUTModel &model, boost::uint64_t source_hash,
+                     std::vector<char> &buffer);
+/**
+ * Deserialize a model from the binary format.
+ * Returns false if the data is of another version or does not match source_hash,
+ * throws if the data is corrupted.
+ */
+bool deserialize_model(const char *data, std::size_t size,
+                       boost::uint64_t source_hash, SUTModel &model);
+
+/** Save a model into a cache file, returns false if the file cannot be written */
+bool save_model_cache(const std::string &file_name, const SUTModel &model,
+                      boost::uint64_t source_hash);
+/**
+ * Load a model from a memory-mapped cache file.
+ * Returns false if the file is absent, of another version or out-dated,
+ * throws if the file is corrupted.
+ */
+bool load_model_cache(const std::string &file_name, boost::uint64_t source_hash,
+                      SUTModel &model);
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_MODEL_CACHE_H_
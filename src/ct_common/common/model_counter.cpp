@@ -0,0 +1,99 @@
+//===----- ct_common/common/model_counter.cpp -------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class ModelCounter
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <ct_common/common/model_counter.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/feasibility_oracle.h>
+
+using namespace ct::common;
+
+ModelCounter::ModelCounter(void)
+    : heuristic_(ELIMINATION_MIN_FILL), max_table_size_(1 << 24), count_combinations_(true),
+      num_configurations_(0), num_combinations_(0), num_feasible_combinations_(0), treewidth_(0), num_bags_(0) {
+}
+
+ModelCounter::ModelCounter(const ModelCounter &from)
+    : heuristic_(from.heuristic_), max_table_size_(from.max_table_size_),
+      count_combinations_(from.count_combinations_), num_configurations_(from.num_configurations_),
+      num_combinations_(from.num_combinations_), num_feasible_combinations_(from.num_feasible_combinations_),
+      treewidth_(from.treewidth_), num_bags_(from.num_bags_) {
+}
+
+ModelCounter &ModelCounter::operator = (const ModelCounter &right) {
+  this->heuristic_ = right.heuristic_;
+  this->max_table_size_ = right.max_table_size_;
+  this->count_combinations_ = right.count_combinations_;
+  this->num_configurations_ = right.num_configurations_;
+  this->num_combinations_ = right.num_combinations_;
+  this->num_feasible_combinations_ = right.num_feasible_combinations_;
+  this->treewidth_ = right.treewidth_;
+  this->num_bags_ = right.num_bags_;
+  return *this;
+}
+
+ModelCounter::~ModelCounter(void) {
+}
+
+void ModelCounter::Count(const SUTModel &model) {
+  std::size_t num_params = model.param_specs_.size();
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  TestCase test = checker.MakeEmptyTest();
+  this->num_configurations_ = checker.IsValid(test) ? 1 : 0;
+  this->num_combinations_ = 0;
+  this->num_feasible_combinations_ = 0;
+  this->treewidth_ = 0;
+  this->num_bags_ = 0;
+
+  // decompose the components, the unconstrained parameters multiply by their levels
+  std::vector<std::vector<std::size_t> > domains(num_params);
+  std::vector<std::size_t> positions(num_params, 0);
+  std::vector<bool> is_decomposed(num_params, false);
+  std::vector<TreeDecomposition> decompositions;
+  for (std::size_t i = 0; i < num_params; ++i) {
+    if (model.param_specs_[i]->is_auto()) {
+      continue;
+    }
+    std::size_t level = model.param_specs_[i]->get_level();
+    for (std::size_t vid = 0; vid < level; ++vid) {
+      domains[i].push_back(vid);
+    }
+    if (checker.get_param_constraints(i).empty()) {
+      this->num_configurations_ *= level;
+    } else if (!is_decomposed[i]) {
+      const std::vector<std::size_t> &component = checker.get_component(i);
+      for (std::size_t j = 0; j < component.size(); ++j) {
+        is_decomposed[component[j]] = true;
+      }
+      decompositions.push_back(TreeDecomposition());
+      decompose_component(checker, component, this->heuristic_, positions, decompositions.back());
+      this->treewidth_ = std::max(this->treewidth_, decompositions.back().width_);
+      this->num_bags_ += component.size();
+    }
+  }
+  for (std::size_t i = 0; i < decompositions.size() && this->num_configurations_ != 0; ++i) {
+    this->num_configurations_ *= eliminate_component<boost::multiprecision::cpp_int>(
+        model, checker, decompositions[i], positions, domains, this->max_table_size_, test);
+  }
+
+  if (!this->count_combinations_) {
+    return;
+  }
+  FeasibilityOracle oracle;
+  oracle.set_max_table_size(this->max_table_size_);
+  oracle.Compute(model);
+  this->num_combinations_ = oracle.get_num_combinations();
+  // the oracle decides the components of the combinations only
+  if (this->num_configurations_ != 0) {
+    this->num_feasible_combinations_ = oracle.get_num_feasible();
+  }
+}
@@ -0,0 +1,86 @@
+//===----- ct_common/common/model_counter.h ---------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for counting the valid configurations
+// of SUT models
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_MODEL_COUNTER_H_
+#define CT_COMMON_MODEL_COUNTER_H_
+
+#include <vector>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/tree_decomposition.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for counting exactly the valid configurations of a model, i.e.
+ * the assignments of valid values to all parameters but the auto ones
+ * satisfying all constraints, and the feasible target combinations, those
+ * the ConstraintChecker can extend, where the other parameters of their
+ * components may also take the invalid value.
+ *
+ * Each constraint component is ordered by the elimination heuristic, which
+ * induces a tree decomposition, and counted by dynamic programming over its
+ * bags (see eliminate_component). The counts of the components and the
+ * levels of the unconstrained parameters multiply. The feasible
+ * combinations are those of a FeasibilityOracle, none if there is no valid
+ * configuration.
+ */
+class DLL_EXPORT ModelCounter {
+public:
+  ModelCounter(void);
+  ModelCounter(const ModelCounter &from);
+  ModelCounter &operator = (const ModelCounter &right);
+  ~ModelCounter(void);
+
+  /** Count the valid configurations and the feasible combinations of a model */
+  void Count(const SUTModel &model);
+
+  /** Set the heuristic for the elimination orders */
+  void set_heuristic(EliminationHeuristic heuristic) { this->heuristic_ = heuristic; }
+  /** Get the heuristic for the elimination orders */
+  EliminationHeuristic get_heuristic(void) const { return this->heuristic_; }
+  /** Set the largest number of entries of a table, beyond which counting fails */
+  void set_max_table_size(std::size_t max_table_size) { this->max_table_size_ = max_table_size; }
+  /** Get the largest number of entries of a table */
+  std::size_t get_max_table_size(void) const { return this->max_table_size_; }
+  /** Set whether the feasible combinations are counted */
+  void set_count_combinations(bool count_combinations) { this->count_combinations_ = count_combinations; }
+  /** Get whether the feasible combinations are counted */
+  bool get_count_combinations(void) const { return this->count_combinations_; }
+
+  /** Get the number of valid configurations */
+  const boost::multiprecision::cpp_int &get_num_configurations(void) const { return this->num_configurations_; }
+  /** Get the number of target combinations */
+  std::size_t get_num_combinations(void) const { return this->num_combinations_; }
+  /** Get the number of feasible target combinations */
+  std::size_t get_num_feasible_combinations(void) const { return this->num_feasible_combinations_; }
+  /** Get the width of the tree decomposition, i.e. the largest bag size minus one */
+  std::size_t get_treewidth(void) const { return this->treewidth_; }
+  /** Get the number of bags, one for each constrained parameter */
+  std::size_t get_num_bags(void) const { return this->num_bags_; }
+
+private:
+  EliminationHeuristic heuristic_;  /**< The heuristic for the elimination orders */
+  std::size_t max_table_size_;  /**< The largest number of entries of a table */
+  bool count_combinations_;  /**< Whether the feasible combinations are counted */
+  boost::multiprecision::cpp_int num_configurations_;  /**< The number of valid configurations */
+  std::size_t num_combinations_;  /**< The number of target combinations */
+  std::size_t num_feasible_combinations_;  /**< The number of feasible target combinations */
+  std::size_t treewidth_;  /**< The width of the tree decomposition */
+  std::size_t num_bags_;  /**< The number of bags */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_MODEL_COUNTER_H_
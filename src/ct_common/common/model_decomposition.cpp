@@ -0,0 +1,151 @@
+//===----- ct_common/common/model_decomposition.cpp -------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the decomposition of SUT models into independent
+// components
+//
+//===----------------------------------------------------------------------===//
+
+#include <set>
+#include <ct_common/common/model_decomposition.h>
+#include <ct_common/common/seed_tuple.h>
+#include <ct_common/common/seed_constraint.h>
+
+using namespace ct::common;
+
+namespace {
+std::size_t find_root(std::vector<std::size_t> &parents, std::size_t pid) {
+  while (parents[pid] != pid) {
+    parents[pid] = parents[parents[pid]];
+    pid = parents[pid];
+  }
+  return pid;
+}
+
+/** Get the parameters a seed touches */
+void touch_seed_pids(const SUTModel &model, const Seed &seed, std::set<std::size_t> &pids) {
+  const Seed_Tuple *seed_tuple = dynamic_cast<const Seed_Tuple *>(&seed);
+  if (seed_tuple) {
+    for (std::size_t i = 0; i < seed_tuple->get_tuple().size(); ++i) {
+      if (seed_tuple->get_tuple()[i].pid_ < model.param_specs_.size()) {
+        pids.insert(seed_tuple->get_tuple()[i].pid_);
+      }
+    }
+  }
+  const Seed_Constraint *seed_constraint = dynamic_cast<const Seed_Constraint *>(&seed);
+  if (seed_constraint && seed_constraint->get_constraint()) {
+    seed_constraint->get_constraint()->touch_pids(model.param_specs_, pids);
+  }
+}
+
+/** Whether all pids of a set (if any) are in a component, given the component id of each parameter */
+bool is_in_component(const std::set<std::size_t> &pids, const std::vector<std::size_t> &component_ids,
+                     std::size_t component_id) {
+  for (std::set<std::size_t>::const_iterator iter = pids.begin(); iter != pids.end(); ++iter) {
+    if (component_ids[*iter] != component_id) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+void ct::common::find_model_components(const SUTModel &model, std::vector<std::vector<std::size_t> > &components) {
+  std::vector<std::size_t> parents(model.param_specs_.size());
+  for (std::size_t i = 0; i < parents.size(); ++i) {
+    parents[i] = i;
+  }
+  std::vector<std::set<std::size_t> > links;
+  for (std::size_t i = 0; i < model.strengths_.size(); ++i) {
+    // a strength of 1 has no interactions
+    if (model.strengths_[i].second >= 2) {
+      links.push_back(std::set<std::size_t>(model.strengths_[i].first.begin(), model.strengths_[i].first.end()));
+    }
+  }
+  for (std::size_t i = 0; i < model.constraints_.size(); ++i) {
+    links.push_back(std::set<std::size_t>());
+    model.constraints_[i]->touch_pids(model.param_specs_, links.back());
+  }
+  for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+    links.push_back(std::set<std::size_t>());
+    touch_seed_pids(model, *model.seeds_[i], links.back());
+  }
+  for (std::size_t i = 0; i < links.size(); ++i) {
+    for (std::set<std::size_t>::const_iterator iter = links[i].begin(); iter != links[i].end(); ++iter) {
+      if (*iter >= parents.size()) {
+        CT_EXCEPTION("the model refers to an unknown parameter");
+      }
+      parents[find_root(parents, *iter)] = find_root(parents, *links[i].begin());
+    }
+  }
+
+  components.clear();
+  std::vector<std::size_t> root_component_ids(parents.size(), PID_BOUND);
+  for (std::size_t i = 0; i < parents.size(); ++i) {
+    std::size_t root = find_root(parents, i);
+    if (root_component_ids[root] == PID_BOUND) {
+      root_component_ids[root] = components.size();
+      components.push_back(std::vector<std::size_t>());
+    }
+    components[root_component_ids[root]].push_back(i);
+  }
+}
+
+void ct::common::make_component_model(const SUTModel &model, const std::vector<std::size_t> &component,
+                                      SUTModel &component_model) {
+  std::vector<std::size_t> component_ids(model.param_specs_.size(), 1);
+  for (std::size_t i = 0; i < component.size(); ++i) {
+    component_ids[component[i]] = 0;
+  }
+  component_model.param_specs_ = model.param_specs_;
+  component_model.arena_ = model.arena_;
+  component_model.strengths_.clear();
+  component_model.constraints_.clear();
+  component_model.seeds_.clear();
+  std::vector<double> strength_weights;
+  for (std::size_t i = 0; i < model.strengths_.size(); ++i) {
+    std::vector<std::size_t> pids;
+    for (std::size_t j = 0; j < model.strengths_[i].first.size(); ++j) {
+      if (component_ids[model.strengths_[i].first[j]] == 0) {
+        pids.push_back(model.strengths_[i].first[j]);
+      }
+    }
+    // only strengths of 1 may span several components
+    if (!pids.empty()) {
+      component_model.strengths_.push_back(Strength(pids, model.strengths_[i].second));
+      strength_weights.push_back(model.weights_.get_strength_weight(i));
+    }
+  }
+  // the value weights keep the pids, the strength weights follow the strengths kept
+  const std::vector<std::vector<double> > &value_weights = model.weights_.get_value_weights();
+  component_model.weights_.Clear();
+  for (std::size_t i = 0; i < strength_weights.size(); ++i) {
+    component_model.weights_.set_strength_weight(i, strength_weights[i]);
+  }
+  for (std::size_t i = 0; i < value_weights.size(); ++i) {
+    for (std::size_t vid = 0; vid < value_weights[i].size(); ++vid) {
+      component_model.weights_.set_value_weight(i, vid, value_weights[i][vid]);
+    }
+  }
+  for (std::size_t i = 0; i < model.constraints_.size(); ++i) {
+    std::set<std::size_t> pids;
+    model.constraints_[i]->touch_pids(model.param_specs_, pids);
+    // constant constraints go to every component
+    if (is_in_component(pids, component_ids, 0)) {
+      component_model.constraints_.push_back(model.constraints_[i]);
+    }
+  }
+  for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+    std::set<std::size_t> pids;
+    touch_seed_pids(model, *model.seeds_[i], pids);
+    // seeds on no parameters go to the first component
+    if (pids.empty() ? (!component.empty() && component[0] == 0) : is_in_component(pids, component_ids, 0)) {
+      component_model.seeds_.push_back(model.seeds_[i]);
+    }
+  }
+}
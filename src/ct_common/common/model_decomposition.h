@@ -0,0 +1,45 @@
+//===----- ct_common/common/model_decomposition.h ---------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the decomposition of SUT models into independent
+// components
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_MODEL_DECOMPOSITION_H_
+#define CT_COMMON_MODEL_DECOMPOSITION_H_
+
+#include <vector>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+
+namespace ct {
+namespace common {
+/**
+ * Find the independent components of a model. Parameters are linked when they
+ * share a strength, a constraint or a seed (by TreeNode::touch_pids), and the
+ * components are the connected parts of this interaction graph, each with
+ * its pids sorted, ordered by their smallest pids. Components of a single
+ * parameter are included.
+ */
+void find_model_components(const SUTModel &model, std::vector<std::vector<std::size_t> > &components);
+
+/**
+ * Make the model of a component found by find_model_components, with the
+ * strengths, constraints and seeds on its parameters. Constraints on no
+ * parameters go to every component, seeds on no parameters to the one of
+ * pid 0. The model keeps all parameters with their pids, so that constraints
+ * and seeds are shared, but the parameters out of the component are in no
+ * strength.
+ */
+void make_component_model(const SUTModel &model, const std::vector<std::size_t> &component,
+                          SUTModel &component_model);
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_MODEL_DECOMPOSITION_H_
@@ -0,0 +1,354 @@
+//===----- ct_common/common/model_symmetry.cpp ------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class ModelSymmetry
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <iterator>
+#include <set>
+#include <sstream>
+#include <ct_common/common/model_symmetry.h>
+#include <ct_common/common/seed_tuple.h>
+#include <ct_common/common/seed_constraint.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+
+using namespace ct::common;
+
+namespace {
+/** Tests whether swapping two parameters maps a model onto itself */
+class SwapTester {
+public:
+  explicit SwapTester(const SUTModel &model)
+      : model_(model), param_strengths_(model.param_specs_.size()), param_constraints_(model.param_specs_.size()),
+        param_seeds_(model.param_specs_.size()) {
+    for (std::size_t i = 0; i < model.strengths_.size(); ++i) {
+      for (std::size_t j = 0; j < model.strengths_[i].first.size(); ++j) {
+        this->param_strengths_[model.strengths_[i].first[j]].push_back(i);
+      }
+    }
+    for (std::size_t i = 0; i < model.constraints_.size(); ++i) {
+      std::set<std::size_t> pids;
+      model.constraints_[i]->touch_pids(model.param_specs_, pids);
+      for (std::set<std::size_t>::const_iterator iter = pids.begin(); iter != pids.end(); ++iter) {
+        this->param_constraints_[*iter].push_back(i);
+      }
+    }
+    for (std::size_t i = 0; i < model.seeds_.size(); ++i) {
+      std::set<std::size_t> pids;
+      const Seed_Tuple *seed_tuple = dynamic_cast<const Seed_Tuple *>(model.seeds_[i].get());
+      if (seed_tuple) {
+        for (std::size_t j = 0; j < seed_tuple->get_tuple().size(); ++j) {
+          pids.insert(seed_tuple->get_tuple()[j].pid_);
+        }
+      }
+      const Seed_Constraint *seed_constraint = dynamic_cast<const Seed_Constraint *>(model.seeds_[i].get());
+      if (seed_constraint && seed_constraint->get_constraint()) {
+        seed_constraint->get_constraint()->touch_pids(model.param_specs_, pids);
+      }
+      for (std::set<std::size_t>::const_iterator iter = pids.begin(); iter != pids.end(); ++iter) {
+        if (*iter < this->param_seeds_.size()) {
+          this->param_seeds_[*iter].push_back(i);
+        }
+      }
+    }
+  }
+
+  /** Get the strengths, constraints and seeds touching a parameter */
+  const std::vector<std::size_t> &get_param_strengths(std::size_t pid) const { return this->param_strengths_[pid]; }
+  const std::vector<std::size_t> &get_param_constraints(std::size_t pid) const { return this->param_constraints_[pid]; }
+  const std::vector<std::size_t> &get_param_seeds(std::size_t pid) const { return this->param_seeds_[pid]; }
+
+  /** Whether swapping p and q maps the model onto itself */
+  bool IsSwappable(std::size_t p, std::size_t q) const {
+    // compared value by value, so that ranges are not materialized
+    const ParamSpec &param_spec_p = *this->model_.param_specs_[p], &param_spec_q = *this->model_.param_specs_[q];
+    if (param_spec_p.get_num_values() != param_spec_q.get_num_values()) {
+      return false;
+    }
+    for (std::size_t vid = 0; vid < param_spec_p.get_num_values(); ++vid) {
+      if (param_spec_p.get_string_value(vid) != param_spec_q.get_string_value(vid)) {
+        return false;
+      }
+    }
+    std::vector<std::size_t> ids;
+    std::vector<std::string> keys, swapped_keys;
+    merge_ids(this->param_strengths_[p], this->param_strengths_[q], ids);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      keys.push_back(this->strength_key(ids[i], p, p));
+      swapped_keys.push_back(this->strength_key(ids[i], p, q));
+    }
+    if (!is_same_keys(keys, swapped_keys)) {
+      return false;
+    }
+    merge_ids(this->param_constraints_[p], this->param_constraints_[q], ids);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      keys.push_back(this->tree_key(*this->model_.constraints_[ids[i]], p, p));
+      swapped_keys.push_back(this->tree_key(*this->model_.constraints_[ids[i]], p, q));
+    }
+    if (!is_same_keys(keys, swapped_keys)) {
+      return false;
+    }
+    merge_ids(this->param_seeds_[p], this->param_seeds_[q], ids);
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+      keys.push_back(this->seed_key(ids[i], p, p));
+      swapped_keys.push_back(this->seed_key(ids[i], p, q));
+    }
+    return is_same_keys(keys, swapped_keys);
+  }
+
+private:
+  static void merge_ids(const std::vector<std::size_t> &left, const std::vector<std::size_t> &right,
+                        std::vector<std::size_t> &ids) {
+    ids.clear();
+    std::set_union(left.begin(), left.end(), right.begin(), right.end(), std::back_inserter(ids));
+  }
+
+  /** Whether two lists hold the same keys in any order, the lists are cleared */
+  static bool is_same_keys(std::vector<std::string> &keys, std::vector<std::string> &swapped_keys) {
+    std::sort(keys.begin(), keys.end());
+    std::sort(swapped_keys.begin(), swapped_keys.end());
+    bool tmp_return = keys == swapped_keys;
+    keys.clear();
+    swapped_keys.clear();
+    return tmp_return;
+  }
+
+  static std::size_t swap_pid(std::size_t pid, std::size_t p, std::size_t q) {
+    return pid == p ? q : (pid == q ? p : pid);
+  }
+
+  std::string strength_key(std::size_t sid, std::size_t p, std::size_t q) const {
+    std::vector<std::size_t> pids = this->model_.strengths_[sid].first;
+    for (std::size_t i = 0; i < pids.size(); ++i) {
+      pids[i] = swap_pid(pids[i], p, q);
+    }
+    std::sort(pids.begin(), pids.end());
+    std::ostringstream ss;
+    ss << this->model_.strengths_[sid].second;
+    for (std::size_t i = 0; i < pids.size(); ++i) {
+      ss << ',' << pids[i];
+    }
+    return ss.str();
+  }
+
+  /**
+   * Get the key of a tree with the parameters p and q swapped, the operands
+   * of commutative operators being sorted by their keys
+   */
+  static std::string tree_key(const TreeNode &node, std::size_t p, std::size_t q) {
+    std::ostringstream ss;
+    ss.precision(17);
+    ss << node.get_class_name();
+    const Exp_A *exp_a = dynamic_cast<const Exp_A *>(&node);
+    if (exp_a) {
+      ss << ':' << exp_a->get_type();
+    }
+    const Constraint_A_Binary *comparison = dynamic_cast<const Constraint_A_Binary *>(&node);
+    if (comparison) {
+      ss << ':' << comparison->get_precision();
+    }
+    if (const Exp_A_Param *leaf = dynamic_cast<const Exp_A_Param *>(&node)) {
+      ss << ':' << swap_pid(leaf->get_pid(), p, q);
+    } else if (const Exp_S_Param *leaf = dynamic_cast<const Exp_S_Param *>(&node)) {
+      ss << ':' << swap_pid(leaf->get_pid(), p, q);
+    } else if (const Constraint_L_Param *leaf = dynamic_cast<const Constraint_L_Param *>(&node)) {
+      ss << ':' << swap_pid(leaf->get_pid(), p, q);
+    } else if (const Constraint_L_IVLD *leaf = dynamic_cast<const Constraint_L_IVLD *>(&node)) {
+      ss << ':' << swap_pid(leaf->get_pid(), p, q);
+    } else if (const Exp_A_CInt *leaf = dynamic_cast<const Exp_A_CInt *>(&node)) {
+      ss << ':' << leaf->get_value();
+    } else if (const Exp_A_CDouble *leaf = dynamic_cast<const Exp_A_CDouble *>(&node)) {
+      ss << ':' << leaf->get_value();
+    } else if (const Exp_S_CString *leaf = dynamic_cast<const Exp_S_CString *>(&node)) {
+      ss << ':' << leaf->get_value().size() << ':' << leaf->get_value();
+    } else if (const Exp_A_CIntRange *leaf = dynamic_cast<const Exp_A_CIntRange *>(&node)) {
+      ss << ':' << leaf->get_begin() << ':' << leaf->get_step() << ':' << leaf->get_num_values();
+    } else if (const Constraint_L_CBool *leaf = dynamic_cast<const Constraint_L_CBool *>(&node)) {
+      ss << ':' << leaf->get_value();
+    } else if (node.is_leaf()) {
+      // unknown leaves only match themselves
+      ss << ':' << &node;
+    }
+    std::vector<std::string> keys;
+    for (std::size_t i = 0; i < node.get_oprds().size(); ++i) {
+      keys.push_back(node.get_oprds()[i] ? tree_key(*node.get_oprds()[i], p, q) : std::string());
+    }
+    if (is_commutative(node)) {
+      std::sort(keys.begin(), keys.end());
+    }
+    ss << '(';
+    for (std::size_t i = 0; i < keys.size(); ++i) {
+      ss << keys[i] << ',';
+    }
+    ss << ')';
+    return ss.str();
+  }
+
+  static bool is_commutative(const TreeNode &node) {
+    return dynamic_cast<const Constraint_L_And *>(&node) || dynamic_cast<const Constraint_L_Or *>(&node) ||
+        dynamic_cast<const Constraint_L_Xor *>(&node) || dynamic_cast<const Constraint_L_Iff *>(&node) ||
+        dynamic_cast<const Constraint_A_EQ *>(&node) || dynamic_cast<const Constraint_A_NE *>(&node) ||
+        dynamic_cast<const Constraint_S_EQ *>(&node) || dynamic_cast<const Constraint_S_NE *>(&node) ||
+        dynamic_cast<const Exp_A_Add *>(&node) || dynamic_cast<const Exp_A_Mult *>(&node);
+  }
+
+  std::string seed_key(std::size_t seed_id, std::size_t p, std::size_t q) const {
+    const Seed *seed = this->model_.seeds_[seed_id].get();
+    const Seed_Tuple *seed_tuple = dynamic_cast<const Seed_Tuple *>(seed);
+    if (seed_tuple) {
+      Tuple tuple = seed_tuple->get_tuple();
+      for (std::size_t i = 0; i < tuple.size(); ++i) {
+        tuple[i].pid_ = swap_pid(tuple[i].pid_, p, q);
+      }
+      tuple.Sort();
+      std::ostringstream ss;
+      ss << "tuple";
+      for (std::size_t i = 0; i < tuple.size(); ++i) {
+        ss << ',' << tuple[i].pid_ << '=' << tuple[i].vid_;
+      }
+      return ss.str();
+    }
+    const Seed_Constraint *seed_constraint = dynamic_cast<const Seed_Constraint *>(seed);
+    if (seed_constraint && seed_constraint->get_constraint()) {
+      return "constraint," + this->tree_key(*seed_constraint->get_constraint(), p, q);
+    }
+    // unknown seeds only match themselves
+    std::ostringstream ss;
+    ss << "seed," << seed_id;
+    return ss.str();
+  }
+
+private:
+  const SUTModel &model_;
+  std::vector<std::vector<std::size_t> > param_strengths_;
+  std::vector<std::vector<std::size_t> > param_constraints_;
+  std::vector<std::vector<std::size_t> > param_seeds_;
+};
+}  // namespace
+
+ModelSymmetry::ModelSymmetry(void)
+    : is_trivial_(true) {
+}
+
+ModelSymmetry::ModelSymmetry(const ModelSymmetry &from)
+    : class_ids_(from.class_ids_), classes_(from.classes_), is_value_symmetric_(from.is_value_symmetric_),
+      levels_(from.levels_), is_trivial_(from.is_trivial_) {
+}
+
+ModelSymmetry &ModelSymmetry::operator = (const ModelSymmetry &right) {
+  this->class_ids_ = right.class_ids_;
+  this->classes_ = right.classes_;
+  this->is_value_symmetric_ = right.is_value_symmetric_;
+  this->levels_ = right.levels_;
+  this->is_trivial_ = right.is_trivial_;
+  return *this;
+}
+
+ModelSymmetry::~ModelSymmetry(void) {
+}
+
+void ModelSymmetry::Detect(const SUTModel &model) {
+  std::size_t num_params = model.param_specs_.size();
+  this->class_ids_.assign(num_params, 0);
+  this->classes_.clear();
+  this->is_value_symmetric_.assign(num_params, false);
+  this->levels_.resize(num_params);
+  this->is_trivial_ = true;
+
+  // auto parameters and the parameters they depend on stay alone
+  std::vector<bool> is_excluded(num_params, false);
+  for (std::size_t i = 0; i < num_params; ++i) {
+    this->levels_[i] = model.param_specs_[i]->get_level();
+    if (!model.param_specs_[i]->is_auto()) {
+      continue;
+    }
+    is_excluded[i] = true;
+    std::set<std::size_t> pids;
+    const std::vector<std::pair<boost::shared_ptr<TreeNode>, boost::shared_ptr<TreeNode> > > &specs =
+        model.param_specs_[i]->get_auto_value_specs();
+    for (std::size_t j = 0; j < specs.size(); ++j) {
+      if (specs[j].first) {
+        specs[j].first->touch_pids(model.param_specs_, pids);
+      }
+      if (specs[j].second) {
+        specs[j].second->touch_pids(model.param_specs_, pids);
+      }
+    }
+    for (std::set<std::size_t>::const_iterator iter = pids.begin(); iter != pids.end(); ++iter) {
+      is_excluded[*iter] = true;
+    }
+  }
+
+  SwapTester tester(model);
+  for (std::size_t i = 0; i < num_params; ++i) {
+    const ParamSpec &param_spec = *model.param_specs_[i];
+    this->is_value_symmetric_[i] = !is_excluded[i] && tester.get_param_constraints(i).empty() &&
+        tester.get_param_seeds(i).empty() && this->levels_[i] > 1;
+    this->is_trivial_ = this->is_trivial_ && !this->is_value_symmetric_[i];
+    std::size_t class_id = this->classes_.size();
+    for (std::size_t c = 0; c < this->classes_.size() && class_id == this->classes_.size() && !is_excluded[i]; ++c) {
+      // cheap checks on the representative first
+      std::size_t pid = this->classes_[c][0];
+      const ParamSpec &other = *model.param_specs_[pid];
+      if (is_excluded[pid] || other.get_class_name() != param_spec.get_class_name() ||
+          other.get_level() != param_spec.get_level() || other.is_aux() != param_spec.is_aux() ||
+          tester.get_param_strengths(pid).size() != tester.get_param_strengths(i).size() ||
+          tester.get_param_constraints(pid).size() != tester.get_param_constraints(i).size() ||
+          tester.get_param_seeds(pid).size() != tester.get_param_seeds(i).size()) {
+        continue;
+      }
+      if (tester.IsSwappable(pid, i)) {
+        class_id = c;
+      }
+    }
+    if (class_id == this->classes_.size()) {
+      this->classes_.push_back(std::vector<std::size_t>());
+    } else {
+      this->is_trivial_ = false;
+    }
+    this->classes_[class_id].push_back(i);
+    this->class_ids_[i] = class_id;
+  }
+}
+
+void ModelSymmetry::Canonicalize(Tuple &tuple) const {
+  std::vector<std::pair<std::size_t, std::size_t> > entries(tuple.size());
+  for (std::size_t i = 0; i < tuple.size(); ++i) {
+    std::size_t pid = tuple[i].pid_, vid = tuple[i].vid_;
+    if (this->is_value_symmetric_[pid] && vid < this->levels_[pid]) {
+      vid = 0;
+    }
+    entries[i] = std::pair<std::size_t, std::size_t>(this->class_ids_[pid], vid);
+  }
+  std::sort(entries.begin(), entries.end());
+  for (std::size_t i = 0, k = 0; i < entries.size(); ++i) {
+    // k counts the entries of the same class before
+    k = (i > 0 && entries[i].first == entries[i - 1].first) ? k + 1 : 0;
+    tuple[i].pid_ = this->classes_[entries[i].first][k];
+    tuple[i].vid_ = entries[i].second;
+  }
+  tuple.Sort();
+}
+
+double ModelSymmetry::get_group_order(void) const {
+  double tmp_return = 1;
+  for (std::size_t i = 0; i < this->classes_.size(); ++i) {
+    for (std::size_t k = 2; k <= this->classes_[i].size(); ++k) {
+      tmp_return *= k;
+    }
+  }
+  for (std::size_t i = 0; i < this->is_value_symmetric_.size(); ++i) {
+    for (std::size_t k = 2; k <= this->levels_[i] && this->is_value_symmetric_[i]; ++k) {
+      tmp_return *= k;
+    }
+  }
+  return tmp_return;
+}
@@ -0,0 +1,74 @@
+//===----- ct_common/common/model_symmetry.h --------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for the symmetries of SUT models
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_MODEL_SYMMETRY_H_
+#define CT_COMMON_MODEL_SYMMETRY_H_
+
+#include <vector>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/tuple.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for the symmetries of a model. Two parameters are
+ * interchangeable if swapping them maps the strengths, the constraints and
+ * the seeds onto themselves, which needs the same kind and values, and
+ * compares the constraint trees node by node with the pids swapped. Being
+ * interchangeable is an equivalence, so the parameters fall into classes
+ * whose members may be permuted freely. The values of a parameter touched by
+ * no constraint or seed are interchangeable as well. Auto parameters and the
+ * parameters their values depend on are left out.
+ *
+ * Tuples related by these permutations share the same canonical form, and so
+ * whether they can be extended to valid test cases (see FeasibilityCache).
+ */
+class DLL_EXPORT ModelSymmetry {
+public:
+  ModelSymmetry(void);
+  ModelSymmetry(const ModelSymmetry &from);
+  ModelSymmetry &operator = (const ModelSymmetry &right);
+  ~ModelSymmetry(void);
+
+  /** Detect the symmetries of a model */
+  void Detect(const SUTModel &model);
+  /**
+   * Map a tuple to its canonical form: the parameters with interchangeable
+   * values take vid 0, then the values of each class of parameters are sorted onto
+   * the first members of the class. The result is sorted by pids. The
+   * symmetries must have been detected.
+   */
+  void Canonicalize(Tuple &tuple) const;
+
+  /** Whether the model has no symmetries at all */
+  bool is_trivial(void) const { return this->is_trivial_; }
+  /** Get the class of a parameter */
+  std::size_t get_class_id(std::size_t pid) const { return this->class_ids_[pid]; }
+  /** Get the classes of interchangeable parameters, each with its pids sorted */
+  const std::vector<std::vector<std::size_t> > &get_classes(void) const { return this->classes_; }
+  /** Whether the values of a parameter are interchangeable */
+  bool is_value_symmetric(std::size_t pid) const { return this->is_value_symmetric_[pid]; }
+  /** Get the order of the symmetry group, which may be infinite as a double */
+  double get_group_order(void) const;
+
+private:
+  std::vector<std::size_t> class_ids_;  /**< The class of each parameter */
+  std::vector<std::vector<std::size_t> > classes_;  /**< The classes of interchangeable parameters */
+  std::vector<bool> is_value_symmetric_;  /**< Whether the values of each parameter are interchangeable */
+  std::vector<std::size_t> levels_;  /**< The level of each parameter */
+  bool is_trivial_;  /**< Whether there are no symmetries */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_MODEL_SYMMETRY_H_
@@ -0,0 +1,113 @@
+//===----- ct_common/common/node_arena.cpp ----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class NodeArena
+//
+//===----------------------------------------------------------------------===//
+
+#include <new>
+#include <ct_common/common/node_arena.h>
+
+using namespace ct::common;
+
+namespace {
+/** Every allocation is preceded by a header recording its arena (0 for the heap) */
+union AllocHeader {
+  NodeArena *arena_;
+  double align_d_;
+  long double align_ld_;
+  void *align_p_;
+};
+const std::size_t HEADER_SIZE = (sizeof(AllocHeader) + 15) / 16 * 16;
+
+CT_THREAD_LOCAL NodeArena *current_arena = 0;
+
+std::size_t align_size(std::size_t size) {
+  return (size + 15) / 16 * 16;
+}
+}  // namespace
+
+const std::size_t NodeArena::DEFAULT_BLOCK_SIZE;
+
+NodeArena::NodeArena(std::size_t block_size)
+    : block_size_(block_size), cur_(0), end_(0),
+      num_refs_(1), num_bytes_(0), is_released_(false) {
+}
+
+NodeArena::~NodeArena(void) {
+  for (std::size_t i = 0; i < this->blocks_.size(); ++i) {
+    ::operator delete(this->blocks_[i]);
+  }
+}
+
+boost::shared_ptr<NodeArena> NodeArena::Create(std::size_t block_size) {
+  return boost::shared_ptr<NodeArena>(new NodeArena(block_size), &NodeArena::release);
+}
+
+void NodeArena::release(NodeArena *arena) {
+  arena->is_released_ = true;
+  arena->unref();
+}
+
+void NodeArena::unref(void) {
+  // whoever drops the last reference deletes the arena, after seeing all earlier writes
+  if (this->num_refs_.fetch_sub(1, boost::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+
+void *NodeArena::allocate(std::size_t size) {
+  size = align_size(size);
+  if (this->cur_ == 0 || std::size_t(this->end_ - this->cur_) < size) {
+    std::size_t block_size = (size > this->block_size_) ? size : this->block_size_;
+    char *block = static_cast<char *>(::operator new(block_size));
+    this->blocks_.push_back(block);
+    this->num_bytes_ += block_size;
+    this->cur_ = block;
+    this->end_ = block + block_size;
+  }
+  void *tmp_return = this->cur_;
+  this->cur_ += size;
+  this->num_refs_.fetch_add(1, boost::memory_order_relaxed);
+  return tmp_return;
+}
+
+void *NodeArena::Allocate(std::size_t size) {
+  NodeArena *arena = current_arena;
+  char *mem = (arena != 0) ? static_cast<char *>(arena->allocate(HEADER_SIZE + size)) :
+                             static_cast<char *>(::operator new(HEADER_SIZE + size));
+  reinterpret_cast<AllocHeader *>(mem)->arena_ = arena;
+  return mem + HEADER_SIZE;
+}
+
+void NodeArena::Deallocate(void *ptr) {
+  if (ptr == 0) {
+    return;
+  }
+  char *mem = static_cast<char *>(ptr) - HEADER_SIZE;
+  NodeArena *arena = reinterpret_cast<AllocHeader *>(mem)->arena_;
+  if (arena == 0) {
+    ::operator delete(mem);
+    return;
+  }
+  // the memory itself is returned in bulk
+  arena->unref();
+}
+
+NodeArena *NodeArena::current(void) {
+  return current_arena;
+}
+
+NodeArena::Scope::Scope(NodeArena *arena)
+    : prev_(current_arena) {
+  current_arena = arena;
+}
+
+NodeArena::Scope::~Scope(void) {
+  current_arena = this->prev_;
+}
@@ -0,0 +1,107 @@
+//===----- ct_common/common/node_arena.h ------------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the region allocator for tree nodes
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_NODE_ARENA_H_
+#define CT_COMMON_NODE_ARENA_H_
+
+#include <cstddef>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <ct_common/common/utils.h>
+
+// thread-local storage for plain pointers
+#ifndef CT_THREAD_LOCAL
+#ifdef _MSC_VER
+#define CT_THREAD_LOCAL __declspec(thread)
+#else  // _MSC_VER
+#define CT_THREAD_LOCAL __thread
+#endif  // _MSC_VER
+#endif  // CT_THREAD_LOCAL
+
+namespace ct {
+namespace common {
+/**
+ * The region allocator for tree nodes.
+ * While a NodeArena::Scope is active, all tree nodes created by the current
+ * thread are placed contiguously in the arena. Nodes are still owned by
+ * shared pointers and may be destroyed individually, but the memory is only
+ * returned in bulk, when the arena is released by its owner and no node of
+ * it is alive any more.
+ * Nodes of one arena are created by one thread at a time, but they may be
+ * destroyed by any thread, e.g. when models are shared by worker threads.
+ */
+class DLL_EXPORT NodeArena {
+public:
+  /** The default size of memory blocks */
+  static const std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  /** Create an arena, which is released when the last returned handle is gone */
+  static boost::shared_ptr<NodeArena> Create(std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+  /** Allocate memory for a node, from the current arena if any, otherwise from the heap */
+  static void *Allocate(std::size_t size);
+  /** Deallocate memory returned by Allocate */
+  static void Deallocate(void *ptr);
+  /** Get the arena of the current thread, 0 if nodes are allocated from the heap */
+  static NodeArena *current(void);
+
+  /** Get the number of nodes alive in the arena */
+  std::size_t get_num_nodes(void) const { return this->num_refs_ - (this->is_released_ ? 0 : 1); }
+  /** Get the number of bytes reserved by the arena */
+  std::size_t get_num_bytes(void) const { return this->num_bytes_; }
+
+  /**
+   * RAII helper for placing nodes created by the current thread in an arena.
+   * Scopes can be nested.
+   */
+  class DLL_EXPORT Scope {
+  public:
+    explicit Scope(NodeArena *arena);
+    ~Scope(void);
+
+  private:
+    // This class is not supposed to be copied
+    Scope(const Scope &from);
+    Scope &operator = (const Scope &right);
+
+  private:
+    NodeArena *prev_;  /**< The arena of the enclosing scope */
+  };
+
+private:
+  explicit NodeArena(std::size_t block_size);
+  ~NodeArena(void);
+  // This class is not supposed to be copied
+  NodeArena(const NodeArena &from);
+  NodeArena &operator = (const NodeArena &right);
+
+  /** Allocate memory in the arena */
+  void *allocate(std::size_t size);
+  /** Called when the owner gives up the arena */
+  static void release(NodeArena *arena);
+  /** Drop a node or the owner, deleting the arena with the last one */
+  void unref(void);
+
+private:
+  std::size_t block_size_;  /**< The size of memory blocks */
+  std::vector<char *> blocks_;  /**< The memory blocks */
+  char *cur_;  /**< The next free byte in the current block */
+  char *end_;  /**< The end of the current block */
+  boost::atomic<std::size_t> num_refs_;  /**< The number of nodes alive, plus one until the owner gives up the arena */
+  std::size_t num_bytes_;  /**< The number of bytes reserved */
+  boost::atomic<bool> is_released_;  /**< Whether the owner has given up the arena */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_NODE_ARENA_H_
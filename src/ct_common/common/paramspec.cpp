@@ -16,10 +16,11 @@
 using namespace ct::common;
 
 ParamSpec::ParamSpec(void)
-    : is_aux_(false), is_auto_(false) {
+    : num_values_(0), is_materialized_(true), is_mapped_(false), is_aux_(false), is_auto_(false) {
 }
 
-ParamSpec::ParamSpec(const ParamSpec &from) {
+ParamSpec::ParamSpec(const ParamSpec &from)
+    : is_materialized_(false), is_mapped_(false) {
   this->init(from);
 }
 
@@ -29,9 +30,19 @@ ParamSpec &ParamSpec::operator = (const ParamSpec &right) {
 }
 
 void ParamSpec::init(const ParamSpec &from) {
+  if (this == &from) {
+    return;
+  }
   this->param_name_ = from.param_name_;
-  this->string_values_ = from.string_values_;
-  this->map_string_values_2_vid_ = from.map_string_values_2_vid_;
+  this->num_values_ = from.num_values_;
+  {
+    boost::mutex::scoped_lock lock(from.cache_mutex_);
+    this->string_values_ = from.string_values_;
+    this->value_index_ = from.value_index_;
+    this->map_string_values_2_vid_ = from.map_string_values_2_vid_;
+    this->is_materialized_.store(from.is_materialized_.load(boost::memory_order_relaxed));
+    this->is_mapped_.store(from.is_mapped_.load(boost::memory_order_relaxed));
+  }
   this->is_aux_ = from.is_aux_;
   this->is_auto_ = from.is_auto_;
 }
@@ -44,17 +55,19 @@ void ParamSpec::set_values(const std::vector<std::string> &values) {
     CT_EXCEPTION(std::string("no values for ") + this->get_param_name());
   }
   this->map_string_values_2_vid_.clear();
+  this->is_mapped_.store(false);
+  this->is_materialized_.store(true);
+  this->num_values_ = values.size();
   this->string_values_ = values;
   this->string_values_.push_back("#");
+  this->value_index_.Clear(values.size());
   for (std::size_t i = 0; i < values.size(); i++) {
     if (values[i].size() <= 0) {
       CT_EXCEPTION("empty value found");
     }
-    if (this->map_string_values_2_vid_.find(values[i]) !=
-        this->map_string_values_2_vid_.end()) {
+    if (this->value_index_.Insert(this->string_values_, i) != VID_BOUND) {
       CT_EXCEPTION(std::string("value ") + values[i] + " is already registered for " + this->get_param_name());
     }
-    map_string_values_2_vid_.insert(std::pair<std::string, std::size_t>(values[i], i));
   }
 }
 
@@ -67,19 +80,68 @@ std::string ParamSpec::class_name(void) {
 }
 
 std::size_t ParamSpec::query_value_id(const std::string &str) const {
-  std::map<std::string, std::size_t>::const_iterator iter =
-      this->map_string_values_2_vid_.find(str);
-  if (iter != this->map_string_values_2_vid_.end()) {
-    return iter->second;
+  const std::vector<std::string> &string_values = this->get_string_values();
+  return this->value_index_.Find(string_values, str);
+}
+
+const std::vector<std::string> &ParamSpec::get_string_values(void) const {
+  // the flag is only set after the values are filled, readers seeing it need no lock
+  if (!this->is_materialized_.load(boost::memory_order_acquire)) {
+    boost::mutex::scoped_lock lock(this->cache_mutex_);
+    if (!this->is_materialized_.load(boost::memory_order_relaxed)) {
+      this->materialize_values();
+      this->is_materialized_.store(true, boost::memory_order_release);
+    }
+  }
+  return this->string_values_;
+}
+
+std::string ParamSpec::get_string_value(std::size_t vid) const {
+  return this->get_string_values()[vid];
+}
+
+const std::map<std::string, std::size_t> &ParamSpec::get_map_string_values_2_vid(void) const {
+  if (!this->is_mapped_.load(boost::memory_order_acquire)) {
+    const std::vector<std::string> &string_values = this->get_string_values();
+    boost::mutex::scoped_lock lock(this->cache_mutex_);
+    if (!this->is_mapped_.load(boost::memory_order_relaxed)) {
+      this->map_string_values_2_vid_.clear();
+      for (std::size_t i = 0; i < this->num_values_; ++i) {
+        this->map_string_values_2_vid_.insert(std::pair<std::string, std::size_t>(string_values[i], i));
+      }
+      this->is_mapped_.store(true, boost::memory_order_release);
+    }
+  }
+  return this->map_string_values_2_vid_;
+}
+
+void ParamSpec::set_compact_values(std::size_t num_values) {
+  this->num_values_ = num_values;
+  this->string_values_.clear();
+  this->value_index_.Clear();
+  this->map_string_values_2_vid_.clear();
+  this->is_materialized_.store(false);
+  this->is_mapped_.store(false);
+}
+
+void ParamSpec::materialize_values(void) const {
+}
+
+void ParamSpec::store_materialized_values(const std::vector<std::string> &values) const {
+  this->string_values_ = values;
+  this->string_values_.push_back("#");
+  this->value_index_.Clear(values.size());
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    this->value_index_.Insert(this->string_values_, i);
   }
-  return VID_BOUND;
 }
 
 std::size_t ParamSpec::get_width(void) const {
   std::size_t width = this->param_name_.size();
-  for (std::size_t i = 0; i < this->string_values_.size(); ++i) {
-    if (width < this->string_values_[i].size()) {
-      width = this->string_values_[i].size();
+  for (std::size_t i = 0; i < this->num_values_; ++i) {
+    std::size_t value_width = this->get_string_value(i).size();
+    if (width < value_width) {
+      width = value_width;
     }
   }
   return std::max(width + 2, std::size_t(5));
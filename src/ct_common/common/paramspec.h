@@ -18,8 +18,11 @@
 #include <set>
 #include <map>
 #include <ct_common/common/utils.h>
+#include <ct_common/common/value_index.h>
 #include <ct_common/common/tree_node.h>
 #include <boost/shared_ptr.hpp>
+#include <boost/atomic.hpp>
+#include <boost/thread/mutex.hpp>
 
 namespace ct {
 namespace common {
@@ -47,22 +50,27 @@ public:
   virtual void set_values(const std::vector<std::string> &string_values);
 
   /**
-   * Get the preserved string values
+   * Get the preserved string values, including the trailing invalid value.
+   * Compactly stored values are materialized once, at the first call of any
+   * thread; get_string_value and query_value_id do not need them.
    */
-  const std::vector<std::string> &get_string_values(void) const { return this->string_values_; }
+  const std::vector<std::string> &get_string_values(void) const;
+  /** Get the string representation of a value, without materializing all values */
+  virtual std::string get_string_value(std::size_t vid) const;
   /**
    * Get the level (number of values) of the parameter
    */
   std::size_t get_level(void) const { return this->get_num_values(); }
   /**
-   * Get the map from strings to their ids by looking up the preserved string copies
+   * Get the map from strings to their ids, built once at the first call of
+   * any thread. Lookups should use query_value_id instead.
    */
-  const std::map<std::string, std::size_t> &get_map_string_values_2_vid(void) const { return this->map_string_values_2_vid_; }
+  const std::map<std::string, std::size_t> &get_map_string_values_2_vid(void) const;
   /**
    * Query the value id by looking up the preserved string copies.
    * Value ids start from zero.
    */
-  std::size_t query_value_id(const std::string &str) const;
+  virtual std::size_t query_value_id(const std::string &str) const;
 
   /** TODO: to be replaced by typeid */
   virtual std::string get_class_name(void) const;
@@ -90,19 +98,31 @@ public:
   /** Get the vid for invalid values, which is level */
   std::size_t get_invalid_vid(void) const { return this->get_num_values(); }
   /** Get the width of the values (for output padding) */
-  std::size_t get_width(void) const;
+  virtual std::size_t get_width(void) const;
   /** Get the number of values (same with get_level) */
-  std::size_t get_num_values(void) const { return this->map_string_values_2_vid_.size(); }
+  std::size_t get_num_values(void) const { return this->num_values_; }
   /** Check whether the given vid is invalid (>=level) */
   bool is_vid_invalid(std::size_t vid) const {   return (vid >= this->get_num_values()); }
 
 private:
   /** Inner init function, for copying */
   void init(const ParamSpec &from);
+protected:
+  /** Drop the preserved strings, for subclasses storing their values compactly */
+  void set_compact_values(std::size_t num_values);
+  /** Fill in the preserved strings of compactly stored values, called once under the cache lock */
+  virtual void materialize_values(void) const;
+  /** Store the materialized strings */
+  void store_materialized_values(const std::vector<std::string> &values) const;
 private:
   std::string param_name_;  /**< The parameter name */
-  std::vector<std::string> string_values_;  /**< The preserved string values */
-  std::map<std::string, std::size_t> map_string_values_2_vid_;  /** The map from string values to vids */
+  std::size_t num_values_;  /**< The number of values */
+  mutable std::vector<std::string> string_values_;  /**< The preserved string values, lazily filled for compact values */
+  mutable ValueIndex value_index_;  /**< The index from string values to vids, lazily filled with string_values_ */
+  mutable std::map<std::string, std::size_t> map_string_values_2_vid_;  /**< The map from string values to vids, built on request */
+  mutable boost::atomic<bool> is_materialized_;  /**< Whether string_values_ and value_index_ are filled */
+  mutable boost::atomic<bool> is_mapped_;  /**< Whether map_string_values_2_vid_ is built */
+  mutable boost::mutex cache_mutex_;  /**< The lock for filling the caches */
   std::vector<std::pair<boost::shared_ptr<TreeNode>, boost::shared_ptr<TreeNode> > > auto_value_specs_;  /**< each element contain a condition and an expression,
                                                                                                             when some condition is true,
                                                                                                             the value takes the expresion value */
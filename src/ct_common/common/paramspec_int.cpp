@@ -11,24 +11,45 @@
 //===----------------------------------------------------------------------===//
 
 #include <cstdlib>
+#include <algorithm>
+#include <sstream>
 #include <ct_common/common/paramspec_int.h>
+#include <ct_common/common/defs.h>
 
 using namespace ct::common;
 
 ParamSpec_Int::ParamSpec_Int(void)
-  : ParamSpec() {
+  : ParamSpec(), is_range_(false), range_begin_(0), range_step_(1) {
 }
 
 ParamSpec_Int::ParamSpec_Int(const ParamSpec_Int &from)
-  : ParamSpec(from), int_values_(from.int_values_) {
+  : ParamSpec(from), is_range_(from.is_range_),
+    range_begin_(from.range_begin_), range_step_(from.range_step_) {
+  this->copy_values(from);
 }
 
 ParamSpec_Int &ParamSpec_Int::operator = (const ParamSpec_Int &right) {
+  if (this == &right) {
+    return (*this);
+  }
   ParamSpec::operator=(right);
-  this->int_values_ = right.int_values_;
+  this->is_range_ = right.is_range_;
+  this->range_begin_ = right.range_begin_;
+  this->range_step_ = right.range_step_;
+  this->copy_values(right);
   return (*this);
 }
 
+void ParamSpec_Int::copy_values(const ParamSpec_Int &from) {
+  if (this->is_range_) {
+    // the values of ranges may be materialized concurrently, the copy materializes its own
+    this->set_compact_values(from.get_num_values());
+    this->int_values_.clear();
+  } else {
+    this->int_values_ = from.int_values_;
+  }
+}
+
 ParamSpec_Int::~ParamSpec_Int(void) {
 }
 
@@ -42,9 +63,102 @@ std::string ParamSpec_Int::class_name(void) {
 
 void ParamSpec_Int::set_values(const std::vector<std::string> &string_values){
   ParamSpec::set_values(string_values);
+  this->is_range_ = false;
+  this->int_values_.clear();
   for (std::size_t i = 0; i < string_values.size(); ++i) {
     this->int_values_.push_back(atoi(string_values[i].c_str()));
   }
   // now push back the invalid value
   this->int_values_.push_back(0);
 }
+
+void ParamSpec_Int::set_range(int val_begin, int step, std::size_t num_values) {
+  if (num_values == 0) {
+    CT_EXCEPTION(std::string("no values for ") + this->get_param_name());
+  }
+  if (step == 0) {
+    CT_EXCEPTION(std::string("zero step in the values of ") + this->get_param_name());
+  }
+  this->set_compact_values(num_values);
+  this->int_values_.clear();
+  this->is_range_ = true;
+  this->range_begin_ = val_begin;
+  this->range_step_ = step;
+}
+
+const std::vector<int> &ParamSpec_Int::get_int_values(void) const {
+  if (this->is_range_) {
+    this->get_string_values();
+  }
+  return this->int_values_;
+}
+
+std::string ParamSpec_Int::get_string_value(std::size_t vid) const {
+  if (!this->is_range_) {
+    return ParamSpec::get_string_value(vid);
+  }
+  if (this->is_vid_invalid(vid)) {
+    return "#";
+  }
+  std::ostringstream ss;
+  ss << this->get_int_value(vid);
+  return ss.str();
+}
+
+std::size_t ParamSpec_Int::query_value_id(const std::string &str) const {
+  if (!this->is_range_) {
+    return ParamSpec::query_value_id(str);
+  }
+  // only the canonical representations (as printed by get_string_value) match
+  std::size_t pos = (!str.empty() && str[0] == '-') ? 1 : 0;
+  if (pos >= str.size() || str.size() - pos > 10 ||
+      (str[pos] == '0' && (str.size() > pos + 1 || pos > 0))) {
+    return VID_BOUND;
+  }
+  long long val = 0;
+  for (std::size_t i = pos; i < str.size(); ++i) {
+    if (str[i] < '0' || str[i] > '9') {
+      return VID_BOUND;
+    }
+    val = val * 10 + (str[i] - '0');
+  }
+  if (pos > 0) {
+    val = -val;
+  }
+  long long diff = val - this->range_begin_;
+  if (diff % this->range_step_ != 0) {
+    return VID_BOUND;
+  }
+  long long vid = diff / this->range_step_;
+  if (vid < 0 || vid >= (long long)this->get_num_values()) {
+    return VID_BOUND;
+  }
+  return (std::size_t)vid;
+}
+
+std::size_t ParamSpec_Int::get_width(void) const {
+  if (!this->is_range_) {
+    return ParamSpec::get_width();
+  }
+  // the widest values are at the ends of the progression
+  std::size_t width = this->get_param_name().size();
+  width = std::max(width, this->get_string_value(0).size());
+  width = std::max(width, this->get_string_value(this->get_num_values() - 1).size());
+  return std::max(width + 2, std::size_t(5));
+}
+
+void ParamSpec_Int::materialize_values(void) const {
+  if (!this->is_range_) {
+    return;
+  }
+  std::vector<std::string> values;
+  values.reserve(this->get_num_values());
+  this->int_values_.clear();
+  this->int_values_.reserve(this->get_num_values() + 1);
+  for (std::size_t i = 0; i < this->get_num_values(); ++i) {
+    values.push_back(this->get_string_value(i));
+    this->int_values_.push_back(this->get_int_value(i));
+  }
+  this->int_values_.push_back(0);
+  this->store_materialized_values(values);
+}
@@ -30,14 +30,42 @@ public:
   virtual ~ParamSpec_Int(void);
 
   virtual void set_values(const std::vector<std::string> &string_values);
-  const std::vector<int> &get_int_values(void) const { return this->int_values_; }
+  /**
+   * Setting the values as an arithmetic progression, without storing them.
+   * The step should not be zero.
+   */
+  void set_range(int val_begin, int step, std::size_t num_values);
+  /** Whether the values are stored as an arithmetic progression */
+  bool is_range(void) const { return this->is_range_; }
+  /** Get the integer values (including the invalid one), ranges are materialized once with the string values */
+  const std::vector<int> &get_int_values(void) const;
+  /** Get the integer value of a vid, 0 for the invalid value */
+  int get_int_value(std::size_t vid) const {
+    if (!this->is_range_) {
+      return this->int_values_[vid];
+    }
+    return this->is_vid_invalid(vid) ? 0 : this->range_begin_ + this->range_step_ * (int)vid;
+  }
+
+  virtual std::string get_string_value(std::size_t vid) const;
+  virtual std::size_t query_value_id(const std::string &str) const;
+  virtual std::size_t get_width(void) const;
 
   virtual std::string get_class_name(void) const;
   static std::string class_name(void);
 
 private:
-  std::vector<int> int_values_;   /**< The integer values of the parameter.
-                                   * Should be consistent with string values */
+  virtual void materialize_values(void) const;
+  /** Copy the integer values, or drop the materialized values of a range */
+  void copy_values(const ParamSpec_Int &from);
+
+private:
+  mutable std::vector<int> int_values_;   /**< The integer values of the parameter.
+                                           * Should be consistent with string values,
+                                           * filled by materialize_values for ranges */
+  bool is_range_;  /**< Whether the values are an arithmetic progression */
+  int range_begin_;  /**< The first value of the progression */
+  int range_step_;  /**< The step of the progression */
 };
 }  // namespace common
 }  // namespace ct
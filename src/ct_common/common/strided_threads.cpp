@@ -0,0 +1,97 @@
+//===----- ct_common/common/strided_threads.cpp -----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class StridedThreads and
+// the strided helpers
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <boost/bind/bind.hpp>
+#include <ct_common/common/strided_threads.h>
+
+using namespace ct::common;
+
+StridedThreads::StridedThreads(std::size_t num_threads)
+    : num_threads_(std::max(num_threads, std::size_t(1))), num_runs_(0), num_running_(0), is_stopped_(false) {
+  for (std::size_t first = 1; first < this->num_threads_; ++first) {
+    this->threads_.create_thread(boost::bind(&StridedThreads::loop, this, first));
+  }
+}
+
+StridedThreads::~StridedThreads(void) {
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    this->is_stopped_ = true;
+  }
+  this->started_.notify_all();
+  this->threads_.join_all();
+}
+
+void StridedThreads::Run(const StridedWorker &worker) {
+  if (this->num_threads_ == 1) {
+    worker(0);
+    return;
+  }
+  {
+    boost::mutex::scoped_lock lock(this->mutex_);
+    this->worker_ = worker;
+    this->num_running_ = this->num_threads_ - 1;
+    ++this->num_runs_;
+  }
+  this->started_.notify_all();
+  // the other threads may still use what the worker refers to
+  try {
+    worker(0);
+  } catch (...) {
+    this->wait();
+    throw;
+  }
+  this->wait();
+}
+
+void StridedThreads::loop(std::size_t first) {
+  std::size_t num_runs = 0;
+  while (true) {
+    {
+      boost::mutex::scoped_lock lock(this->mutex_);
+      while (this->num_runs_ == num_runs && !this->is_stopped_) {
+        this->started_.wait(lock);
+      }
+      if (this->is_stopped_) {
+        return;
+      }
+      num_runs = this->num_runs_;
+    }
+    // the worker is not replaced before every thread has finished it
+    this->worker_(first);
+    boost::mutex::scoped_lock lock(this->mutex_);
+    if (--this->num_running_ == 0) {
+      this->finished_.notify_one();
+    }
+  }
+}
+
+void StridedThreads::wait(void) {
+  boost::mutex::scoped_lock lock(this->mutex_);
+  while (this->num_running_ != 0) {
+    this->finished_.wait(lock);
+  }
+}
+
+std::size_t ct::common::resolve_num_threads(std::size_t num_threads, std::size_t num_tasks) {
+  if (num_threads == 0) {
+    num_threads = boost::thread::hardware_concurrency();
+  }
+  return std::max(std::min(num_threads, num_tasks), std::size_t(1));
+}
+
+void ct::common::run_strided(std::size_t num_threads, const StridedWorker &worker) {
+  StridedThreads threads(num_threads);
+  threads.Run(worker);
+}
@@ -0,0 +1,83 @@
+//===----- ct_common/common/strided_threads.h -------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the helpers for running strided workers on
+// several threads
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_STRIDED_THREADS_H_
+#define CT_COMMON_STRIDED_THREADS_H_
+
+#include <cstddef>
+#include <boost/function.hpp>
+#include <boost/thread/condition_variable.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/thread.hpp>
+#include <ct_common/common/utils.h>
+
+namespace ct {
+namespace common {
+/**
+ * A strided worker takes the items first, first + num_threads, ... of a task,
+ * where first is the argument it is called with. It is called from several
+ * threads at once, so it should only write to the items it takes.
+ */
+typedef boost::function<void (std::size_t)> StridedWorker;
+
+/**
+ * The class for running strided workers on threads which are kept alive
+ * between the runs, so that a task split into many short runs does not
+ * create threads for each of them. The calling thread takes first = 0.
+ */
+class DLL_EXPORT StridedThreads {
+public:
+  /** Start num_threads - 1 threads, at least one thread runs */
+  explicit StridedThreads(std::size_t num_threads);
+  /** Stop and join the threads */
+  ~StridedThreads(void);
+
+  /** Get the number of threads running a worker, including the calling one */
+  std::size_t get_num_threads(void) const { return this->num_threads_; }
+
+  /** Call worker(first) for first = 0 to num_threads - 1, each on its own thread, and wait for all */
+  void Run(const StridedWorker &worker);
+
+private:
+  StridedThreads(const StridedThreads &from);
+  StridedThreads &operator = (const StridedThreads &right);
+
+  /** The loop of the thread taking first */
+  void loop(std::size_t first);
+  /** Wait for the other threads to finish the current run */
+  void wait(void);
+
+private:
+  std::size_t num_threads_;  /**< The number of threads running a worker */
+  boost::thread_group threads_;  /**< The threads other than the calling one */
+  boost::mutex mutex_;  /**< Guards the members below */
+  boost::condition_variable started_;  /**< Signals a new run or the stop */
+  boost::condition_variable finished_;  /**< Signals the end of a run */
+  StridedWorker worker_;  /**< The worker of the current run */
+  std::size_t num_runs_;  /**< The number of runs started */
+  std::size_t num_running_;  /**< The number of other threads still in the current run */
+  bool is_stopped_;  /**< Whether the threads should exit */
+};
+
+/**
+ * Get the number of threads to run num_tasks strided items on, the hardware
+ * concurrency if num_threads is 0, at most num_tasks and at least 1
+ */
+std::size_t resolve_num_threads(std::size_t num_threads, std::size_t num_tasks);
+
+/** Call worker(first) for first = 0 to num_threads - 1, each on its own thread, and wait for all */
+void run_strided(std::size_t num_threads, const StridedWorker &worker);
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_STRIDED_THREADS_H_
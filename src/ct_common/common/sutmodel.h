@@ -19,6 +19,8 @@
 #include <ct_common/common/seed.h>
 #include <ct_common/common/constraint.h>
 #include <ct_common/common/strength.h>
+#include <ct_common/common/coverage_weights.h>
+#include <ct_common/common/node_arena.h>
 #include <boost/shared_ptr.hpp>
 
 namespace ct {
@@ -31,6 +33,8 @@ struct SUTModel {
   std::vector<Strength> strengths_;  /**< The strengths */
   std::vector<boost::shared_ptr<Seed> > seeds_;  /**< The seeds */
   std::vector<boost::shared_ptr<Constraint> > constraints_;  /**< The constraints */
+  CoverageWeights weights_;  /**< The weights of the strengths and values, uniform by default */
+  boost::shared_ptr<NodeArena> arena_;  /**< The arena holding the tree nodes of the model, empty if they are on the heap */
 };
 }  // namespace common
 }  // namespace ct
@@ -0,0 +1,123 @@
+//===----- ct_common/common/test_prioritizer.cpp ----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class TestPrioritizer
+//
+//===----------------------------------------------------------------------===//
+
+#include <queue>
+#include <ct_common/common/test_prioritizer.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/coverage_weights.h>
+#include <ct_common/common/constraint_checker.h>
+
+using namespace ct::common;
+
+namespace {
+/** A test case with bounds of its gain, the weight and the number of the combinations newly covered */
+struct GainEntry {
+  GainEntry(double weight, std::size_t count, std::size_t row) : weight_(weight), count_(count), row_(row) {}
+  double weight_;
+  std::size_t count_;
+  std::size_t row_;
+};
+
+/** Orders the heap by larger weights first, then by larger counts, then by earlier rows */
+struct GainLess {
+  bool operator () (const GainEntry &left, const GainEntry &right) const {
+    if (left.weight_ != right.weight_) {
+      return left.weight_ < right.weight_;
+    }
+    if (left.count_ != right.count_) {
+      return left.count_ < right.count_;
+    }
+    return left.row_ > right.row_;
+  }
+};
+}  // namespace
+
+TestPrioritizer::TestPrioritizer(void)
+    : num_combinations_(0), num_evaluations_(0) {
+}
+
+TestPrioritizer::TestPrioritizer(const TestPrioritizer &from)
+    : order_(from.order_), cumulative_coverage_(from.cumulative_coverage_),
+      cumulative_weights_(from.cumulative_weights_), num_combinations_(from.num_combinations_), num_evaluations_(from.num_evaluations_) {
+}
+
+TestPrioritizer &TestPrioritizer::operator = (const TestPrioritizer &right) {
+  this->order_ = right.order_;
+  this->cumulative_coverage_ = right.cumulative_coverage_;
+  this->cumulative_weights_ = right.cumulative_weights_;
+  this->num_combinations_ = right.num_combinations_;
+  this->num_evaluations_ = right.num_evaluations_;
+  return *this;
+}
+
+TestPrioritizer::~TestPrioritizer(void) {
+}
+
+void TestPrioritizer::Prioritize(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->order_.clear();
+  this->cumulative_coverage_.clear();
+  this->cumulative_weights_.clear();
+  this->num_evaluations_ = 0;
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  this->num_combinations_ = coverage.get_num_combinations();
+  CoverageWeightTable weights;
+  weights.Init(model.strengths_, model.weights_, coverage);
+
+  // no test case covers more than one combination per raw strength, nor more than the largest weight
+  std::priority_queue<GainEntry, std::vector<GainEntry>, GainLess> heap;
+  std::vector<bool> is_taken(tests.size(), false);
+  double covered_weight = 0;
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (tests[i].size() == model.param_specs_.size() && checker.IsValid(tests[i])) {
+      heap.push(GainEntry(weights.get_max_test_weight(), coverage.get_num_raw_strengths(), i));
+    }
+  }
+  while (!heap.empty() && coverage.get_num_uncovered() > 0) {
+    GainEntry entry = heap.top();
+    heap.pop();
+    if (entry.count_ == 0) {
+      break;
+    }
+    entry.weight_ = weights.WeighUncovered(coverage, tests[entry.row_], &entry.count_);
+    ++this->num_evaluations_;
+    // the other bounds are not below the real gains, so the top stays the best
+    if (!heap.empty() && GainLess()(entry, heap.top())) {
+      if (entry.count_ > 0) {
+        heap.push(entry);
+      }
+      continue;
+    }
+    if (entry.count_ == 0) {
+      break;
+    }
+    coverage.Cover(tests[entry.row_]);
+    is_taken[entry.row_] = true;
+    covered_weight += entry.weight_;
+    this->order_.push_back(entry.row_);
+    this->cumulative_coverage_.push_back(coverage.get_num_covered());
+    this->cumulative_weights_.push_back(covered_weight);
+  }
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (!is_taken[i]) {
+      this->order_.push_back(i);
+      this->cumulative_coverage_.push_back(coverage.get_num_covered());
+      this->cumulative_weights_.push_back(covered_weight);
+    }
+  }
+
+  std::vector<TestCase> ordered(tests.size());
+  for (std::size_t i = 0; i < this->order_.size(); ++i) {
+    ordered[i] = tests[this->order_[i]];
+  }
+  tests.swap(ordered);
+}
@@ -0,0 +1,67 @@
+//===----- ct_common/common/test_prioritizer.h ------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the prioritizer ordering test suites by coverage
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_TEST_PRIORITIZER_H_
+#define CT_COMMON_TEST_PRIORITIZER_H_
+
+#include <vector>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+/**
+ * The prioritizer ordering test suites so that the cumulative coverage of
+ * the strengths rises as fast as possible. Each step takes the test case
+ * covering the largest weight of combinations not yet covered by the taken
+ * ones (see CoverageWeightTable), then the most of them, the earliest one on
+ * ties; with the default uniform weights, the weight is the number. The
+ * gains are evaluated lazily: as they only drop, a max-heap keeps each test
+ * case under its last evaluated gain, and only the top is re-evaluated until
+ * it stays on top. The order is the one of
+ * the naive greedy scan. Test cases violating the constraints cover
+ * nothing, and test cases covering nothing new keep their relative order
+ * at the end.
+ */
+class DLL_EXPORT TestPrioritizer {
+public:
+  TestPrioritizer(void);
+  TestPrioritizer(const TestPrioritizer &from);
+  TestPrioritizer &operator = (const TestPrioritizer &right);
+  ~TestPrioritizer(void);
+
+  /** Reorder a suite of test cases of the model */
+  void Prioritize(const SUTModel &model, std::vector<TestCase> &tests);
+
+  /** Get the original indices of the test cases in the last order */
+  const std::vector<std::size_t> &get_order(void) const { return this->order_; }
+  /** Get the numbers of combinations covered by the first 1, 2, ... test cases of the last order */
+  const std::vector<std::size_t> &get_cumulative_coverage(void) const { return this->cumulative_coverage_; }
+  /** Get the weights of the combinations covered by the first 1, 2, ... test cases of the last order */
+  const std::vector<double> &get_cumulative_weights(void) const { return this->cumulative_weights_; }
+  /** Get the number of target combinations of the last prioritization */
+  std::size_t get_num_combinations(void) const { return this->num_combinations_; }
+  /** Get the number of gain evaluations of the last prioritization */
+  std::size_t get_num_evaluations(void) const { return this->num_evaluations_; }
+
+private:
+  std::vector<std::size_t> order_;  /**< The original indices of the ordered test cases */
+  std::vector<std::size_t> cumulative_coverage_;  /**< The coverage of the prefixes */
+  std::vector<double> cumulative_weights_;  /**< The covered weights of the prefixes */
+  std::size_t num_combinations_;  /**< The number of target combinations */
+  std::size_t num_evaluations_;  /**< The number of gain evaluations */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_TEST_PRIORITIZER_H_
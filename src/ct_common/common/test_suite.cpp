@@ -0,0 +1,187 @@
+//===----- ct_common/common/test_suite.cpp ----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class TestSuite
+//
+//===----------------------------------------------------------------------===//
+
+#include <ct_common/common/test_suite.h>
+
+using namespace ct::common;
+
+TestSuiteRow::TestSuiteRow(const TestSuite &suite, std::size_t row)
+    : Assignment(), suite_(&suite), row_(row) {
+}
+
+TestSuiteRow::TestSuiteRow(const TestSuiteRow &from)
+    : Assignment(from), suite_(from.suite_), row_(from.row_) {
+}
+
+TestSuiteRow &TestSuiteRow::operator = (const TestSuiteRow &right) {
+  Assignment::operator = (right);
+  this->suite_ = right.suite_;
+  this->row_ = right.row_;
+  return *this;
+}
+
+TestSuiteRow::~TestSuiteRow(void) {
+}
+
+bool TestSuiteRow::IsContainParam(std::size_t pid) const {
+  return pid < this->suite_->get_num_params();
+}
+
+std::size_t TestSuiteRow::GetValue(std::size_t pid) const {
+  if (this->IsContainParam(pid)) {
+    return this->suite_->Get(this->row_, pid);
+  }
+  return PID_BOUND;
+}
+
+bool TestSuiteRow::IsSubAssignmentOf(const Assignment &assignment) const {
+  for (std::size_t i = 0; i < this->suite_->get_num_params(); ++i) {
+    if (!assignment.IsContainParam(i) || assignment.GetValue(i) != this->suite_->Get(this->row_, i)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+TestSuite::TestSuite(void)
+    : cell_width_(1), unassigned_cell_(0xFF), num_rows_(0) {
+}
+
+TestSuite::TestSuite(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs)
+    : cell_width_(1), unassigned_cell_(0xFF), num_rows_(0) {
+  this->Init(param_specs);
+}
+
+TestSuite::TestSuite(std::size_t num_params, std::size_t max_level)
+    : cell_width_(1), unassigned_cell_(0xFF), num_rows_(0) {
+  this->Init(num_params, max_level);
+}
+
+TestSuite::TestSuite(const TestSuite &from)
+    : cell_width_(from.cell_width_), unassigned_cell_(from.unassigned_cell_),
+      num_rows_(from.num_rows_), columns_(from.columns_) {
+}
+
+TestSuite &TestSuite::operator = (const TestSuite &right) {
+  this->cell_width_ = right.cell_width_;
+  this->unassigned_cell_ = right.unassigned_cell_;
+  this->num_rows_ = right.num_rows_;
+  this->columns_ = right.columns_;
+  return *this;
+}
+
+TestSuite::~TestSuite(void) {
+}
+
+void TestSuite::Init(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs) {
+  std::size_t max_level = 0;
+  for (std::size_t i = 0; i < param_specs.size(); ++i) {
+    if (param_specs[i]->get_level() > max_level) {
+      max_level = param_specs[i]->get_level();
+    }
+  }
+  this->Init(param_specs.size(), max_level);
+}
+
+void TestSuite::Init(std::size_t num_params, std::size_t max_level) {
+  // the invalid value id equals the level, and must differ from the unassigned pattern
+  if (max_level < 0xFF) {
+    this->cell_width_ = 1;
+    this->unassigned_cell_ = 0xFF;
+  } else if (max_level < 0xFFFF) {
+    this->cell_width_ = 2;
+    this->unassigned_cell_ = 0xFFFF;
+  } else if (max_level < 0xFFFFFFFF) {
+    this->cell_width_ = 4;
+    this->unassigned_cell_ = 0xFFFFFFFF;
+  } else {
+    CT_EXCEPTION("too many values for a test suite");
+  }
+  this->num_rows_ = 0;
+  this->columns_.assign(num_params, std::vector<unsigned char>());
+}
+
+void TestSuite::Clear(void) {
+  this->num_rows_ = 0;
+  for (std::size_t i = 0; i < this->columns_.size(); ++i) {
+    this->columns_[i].clear();
+  }
+}
+
+void TestSuite::Reserve(std::size_t num_rows) {
+  for (std::size_t i = 0; i < this->columns_.size(); ++i) {
+    this->columns_[i].reserve(num_rows * this->cell_width_);
+  }
+}
+
+void TestSuite::Set(std::size_t row, std::size_t pid, std::size_t vid) {
+  boost::uint32_t cell = vid == VID_BOUND ? this->unassigned_cell_ : boost::uint32_t(vid);
+  if (vid != VID_BOUND && vid >= this->unassigned_cell_) {
+    CT_EXCEPTION("the value id does not fit in the cell");
+  }
+  unsigned char *data = &this->columns_[pid][0];
+  switch (this->cell_width_) {
+    case 1: data[row] = boost::uint8_t(cell); break;
+    case 2: reinterpret_cast<boost::uint16_t *>(data)[row] = boost::uint16_t(cell); break;
+    default: reinterpret_cast<boost::uint32_t *>(data)[row] = cell; break;
+  }
+}
+
+std::size_t TestSuite::AppendRow(void) {
+  // the all-ones pattern is VID_BOUND for every width
+  for (std::size_t i = 0; i < this->columns_.size(); ++i) {
+    this->columns_[i].resize((this->num_rows_ + 1) * this->cell_width_, 0xFF);
+  }
+  return this->num_rows_++;
+}
+
+std::size_t TestSuite::AppendRow(const TestCase &test) {
+  if (test.size() != this->columns_.size()) {
+    CT_EXCEPTION("the test case does not match the parameters");
+  }
+  std::size_t tmp_return = this->AppendRow();
+  for (std::size_t i = 0; i < this->columns_.size(); ++i) {
+    this->Set(tmp_return, i, test[i]);
+  }
+  return tmp_return;
+}
+
+void TestSuite::Append(const std::vector<TestCase> &tests) {
+  this->Reserve(this->num_rows_ + tests.size());
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    this->AppendRow(tests[i]);
+  }
+}
+
+void TestSuite::PopRow(void) {
+  if (this->num_rows_ == 0) {
+    return;
+  }
+  --this->num_rows_;
+  for (std::size_t i = 0; i < this->columns_.size(); ++i) {
+    this->columns_[i].resize(this->num_rows_ * this->cell_width_);
+  }
+}
+
+void TestSuite::GetTestCase(std::size_t row, TestCase &test) const {
+  test.resize(this->columns_.size());
+  for (std::size_t i = 0; i < this->columns_.size(); ++i) {
+    test[i] = this->Get(row, i);
+  }
+}
+
+void TestSuite::GetTestCases(std::vector<TestCase> &tests) const {
+  tests.resize(this->num_rows_);
+  for (std::size_t i = 0; i < this->num_rows_; ++i) {
+    this->GetTestCase(i, tests[i]);
+  }
+}
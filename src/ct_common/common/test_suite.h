@@ -0,0 +1,144 @@
+//===----- ct_common/common/test_suite.h ------------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the columnar container of test suites
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_TEST_SUITE_H_
+#define CT_COMMON_TEST_SUITE_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/defs.h>
+#include <ct_common/common/assignment.h>
+#include <ct_common/common/paramspec.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+class TestSuite;
+
+/**
+ * The view of a row of a TestSuite as an assignment.
+ * The view is weak and becomes invalid when the suite is destroyed.
+ */
+class DLL_EXPORT TestSuiteRow : public Assignment {
+public:
+  TestSuiteRow(const TestSuite &suite, std::size_t row);
+  TestSuiteRow(const TestSuiteRow &from);
+  TestSuiteRow &operator = (const TestSuiteRow &right);
+  virtual ~TestSuiteRow(void);
+
+  virtual bool IsContainParam(std::size_t pid) const;
+  virtual std::size_t GetValue(std::size_t pid) const;
+  virtual bool IsSubAssignmentOf(const Assignment &assignment) const;
+
+  /** Get the index of the row */
+  std::size_t get_row(void) const { return this->row_; }
+
+private:
+  const TestSuite *suite_;  /**< The suite */
+  std::size_t row_;  /**< The index of the row */
+};
+
+/**
+ * The container of test suites storing cells by columns.
+ * Cells take 1, 2 or 4 bytes, the narrowest in which all value ids up to the
+ * invalid one of the largest level fit below the all-ones pattern, which
+ * stands for VID_BOUND (unassigned). Rows are appended to every column, so
+ * that no memory is allocated per row, and the columns can be scanned
+ * directly through get_column for coverage counting.
+ */
+class DLL_EXPORT TestSuite {
+public:
+  TestSuite(void);
+  /** Make an empty suite for the parameters */
+  explicit TestSuite(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs);
+  /** Make an empty suite for num_params parameters of at most max_level levels */
+  TestSuite(std::size_t num_params, std::size_t max_level);
+  TestSuite(const TestSuite &from);
+  TestSuite &operator = (const TestSuite &right);
+  ~TestSuite(void);
+
+  /** Reset to an empty suite for the parameters */
+  void Init(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs);
+  /** Reset to an empty suite for num_params parameters of at most max_level levels */
+  void Init(std::size_t num_params, std::size_t max_level);
+  /** Remove all rows, keeping the layout */
+  void Clear(void);
+  /** Reserve the memory for num_rows rows */
+  void Reserve(std::size_t num_rows);
+
+  /** Get the number of parameters */
+  std::size_t get_num_params(void) const { return this->columns_.size(); }
+  /** Get the number of rows */
+  std::size_t get_num_rows(void) const { return this->num_rows_; }
+  /** Get the number of bytes per cell */
+  std::size_t get_cell_width(void) const { return this->cell_width_; }
+  /** Get the cell pattern of VID_BOUND */
+  boost::uint32_t get_unassigned_cell(void) const { return this->unassigned_cell_; }
+
+  /** Get the value id of a cell */
+  std::size_t Get(std::size_t row, std::size_t pid) const {
+    boost::uint32_t cell;
+    const unsigned char *data = &this->columns_[pid][0];
+    switch (this->cell_width_) {
+      case 1: cell = data[row]; break;
+      case 2: cell = reinterpret_cast<const boost::uint16_t *>(data)[row]; break;
+      default: cell = reinterpret_cast<const boost::uint32_t *>(data)[row]; break;
+    }
+    return cell == this->unassigned_cell_ ? VID_BOUND : cell;
+  }
+  /** Set the value id of a cell, VID_BOUND for unassigned */
+  void Set(std::size_t row, std::size_t pid, std::size_t vid);
+
+  /** Append a row of unassigned cells, returns its index */
+  std::size_t AppendRow(void);
+  /** Append a test case, returns its index */
+  std::size_t AppendRow(const TestCase &test);
+  /** Append test cases */
+  void Append(const std::vector<TestCase> &tests);
+  /** Remove the last row */
+  void PopRow(void);
+
+  /** Get the view of a row */
+  TestSuiteRow GetRow(std::size_t row) const { return TestSuiteRow(*this, row); }
+  /** Copy a row into a test case */
+  void GetTestCase(std::size_t row, TestCase &test) const;
+  /** Copy all rows into test cases */
+  void GetTestCases(std::vector<TestCase> &tests) const;
+
+  /**
+   * Get the cells of a parameter, T being the unsigned integer type of
+   * get_cell_width() bytes. Returns 0 if there are no rows. The pointer is
+   * invalidated by appending rows beyond the reserved ones.
+   */
+  template <typename T>
+  const T *get_column(std::size_t pid) const {
+    if (sizeof(T) != this->cell_width_) {
+      CT_EXCEPTION("the cell type does not match the cell width");
+    }
+    if (this->num_rows_ == 0) {
+      return 0;
+    }
+    return reinterpret_cast<const T *>(&this->columns_[pid][0]);
+  }
+
+private:
+  std::size_t cell_width_;  /**< The number of bytes per cell */
+  boost::uint32_t unassigned_cell_;  /**< The cell pattern of VID_BOUND */
+  std::size_t num_rows_;  /**< The number of rows */
+  std::vector<std::vector<unsigned char> > columns_;  /**< The cells of each parameter */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_TEST_SUITE_H_
@@ -0,0 +1,150 @@
+//===----- ct_common/common/test_suite_file.cpp -----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the functions reading and writing test suites
+//
+//===----------------------------------------------------------------------===//
+
+#include <sstream>
+#include <ct_common/common/test_suite_file.h>
+#include <ct_common/common/defs.h>
+
+using namespace ct::common;
+
+namespace {
+/** Split a line by commas, trimming the cells */
+void split_line(const std::string &line, std::vector<std::string> &cells) {
+  cells.clear();
+  std::size_t start = 0;
+  while (true) {
+    std::size_t end = line.find(',', start);
+    std::size_t last = end == std::string::npos ? line.size() : end;
+    std::size_t first = start;
+    while (first < last && (line[first] == ' ' || line[first] == '\t')) {
+      ++first;
+    }
+    while (last > first && (line[last - 1] == ' ' || line[last - 1] == '\t' || line[last - 1] == '\r')) {
+      --last;
+    }
+    cells.push_back(line.substr(first, last - first));
+    if (end == std::string::npos) {
+      break;
+    }
+    start = end + 1;
+  }
+}
+
+bool is_blank(const std::string &line) {
+  return line.find_first_not_of(" \t\r") == std::string::npos;
+}
+
+std::string line_message(std::size_t line_no, const std::string &text) {
+  std::ostringstream ss;
+  ss << "line " << line_no << ": " << text;
+  return ss.str();
+}
+}  // namespace
+
+void ct::common::save_test_suite(std::ostream &out, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                                 const std::vector<TestCase> &tests) {
+  // auto parameters take no values in test cases
+  std::vector<std::size_t> pids;
+  for (std::size_t i = 0; i < param_specs.size(); ++i) {
+    if (!param_specs[i]->is_auto()) {
+      out << (pids.empty() ? "" : ",") << param_specs[i]->get_param_name();
+      pids.push_back(i);
+    }
+  }
+  out << std::endl;
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    for (std::size_t j = 0; j < pids.size(); ++j) {
+      out << (j > 0 ? "," : "") << param_specs[pids[j]]->get_string_value(tests[i][pids[j]]);
+    }
+    out << std::endl;
+  }
+}
+
+bool ct::common::load_test_suite(std::istream &in, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                                 std::vector<TestCase> &tests, std::string &message, bool allow_missing) {
+  std::string line;
+  std::size_t line_no = 0;
+  while (std::getline(in, line)) {
+    ++line_no;
+    if (!is_blank(line)) {
+      break;
+    }
+  }
+  if (is_blank(line)) {
+    message = "no header line";
+    return false;
+  }
+  std::vector<std::string> cells;
+  split_line(line, cells);
+  std::vector<std::size_t> pids;
+  std::vector<bool> has_column(param_specs.size(), false);
+  for (std::size_t i = 0; i < cells.size(); ++i) {
+    std::size_t pid = PID_BOUND;
+    for (std::size_t j = 0; j < param_specs.size() && pid == PID_BOUND; ++j) {
+      if (param_specs[j]->get_param_name() == cells[i]) {
+        pid = j;
+      }
+    }
+    if (pid == PID_BOUND || param_specs[pid]->is_auto()) {
+      message = line_message(line_no, "unknown parameter " + cells[i]);
+      return false;
+    }
+    if (has_column[pid]) {
+      message = line_message(line_no, "duplicated parameter " + cells[i]);
+      return false;
+    }
+    has_column[pid] = true;
+    pids.push_back(pid);
+  }
+  for (std::size_t i = 0; i < param_specs.size(); ++i) {
+    if (!has_column[i] && !param_specs[i]->is_auto() && !allow_missing) {
+      message = line_message(line_no, "missing parameter " + param_specs[i]->get_param_name());
+      return false;
+    }
+  }
+
+  TestCase empty_test;
+  empty_test.assign(param_specs.size(), VID_BOUND);
+  for (std::size_t i = 0; i < param_specs.size(); ++i) {
+    if (param_specs[i]->is_auto()) {
+      empty_test[i] = param_specs[i]->get_invalid_vid();
+    }
+  }
+  while (std::getline(in, line)) {
+    ++line_no;
+    if (is_blank(line)) {
+      continue;
+    }
+    split_line(line, cells);
+    if (cells.size() != pids.size()) {
+      message = line_message(line_no, "wrong number of values");
+      return false;
+    }
+    TestCase test = empty_test;
+    for (std::size_t i = 0; i < pids.size(); ++i) {
+      const ParamSpec &param_spec = *param_specs[pids[i]];
+      // the invalid value is written as its string, which is not indexed
+      std::size_t vid = param_spec.get_invalid_vid();
+      if (cells[i] != param_spec.get_string_value(vid)) {
+        vid = param_spec.query_value_id(cells[i]);
+      }
+      if (vid == VID_BOUND) {
+        message = line_message(line_no, "unknown value " + cells[i] + " of parameter " +
+                               param_specs[pids[i]]->get_param_name());
+        return false;
+      }
+      test[pids[i]] = vid;
+    }
+    tests.push_back(test);
+  }
+  return true;
+}
@@ -0,0 +1,47 @@
+//===----- ct_common/common/test_suite_file.h -------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the functions reading and writing test suites
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_TEST_SUITE_FILE_H_
+#define CT_COMMON_TEST_SUITE_FILE_H_
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/paramspec.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+/**
+ * Write a test suite as comma-separated values: a header line with the names
+ * of the non-auto parameters, then one line of value strings per test case.
+ */
+void save_test_suite(std::ostream &out, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                     const std::vector<TestCase> &tests);
+/**
+ * Read a test suite written by save_test_suite. The columns may come in any
+ * order, but every non-auto parameter must have one, unless allow_missing is
+ * set, in which case the cells of parameters without columns are left
+ * unassigned (VID_BOUND), e.g. for a suite of an earlier model to extend.
+ * The invalid values are read back from their strings ("#"). Blank lines are
+ * skipped and cells are trimmed. Returns false with a message
+ * naming the line on unknown parameters or values, leaving the test cases
+ * read so far.
+ */
+bool load_test_suite(std::istream &in, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                     std::vector<TestCase> &tests, std::string &message, bool allow_missing = false);
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_TEST_SUITE_FILE_H_
@@ -0,0 +1,193 @@
+//===----- ct_common/common/test_suite_reducer.cpp --------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class TestSuiteReducer
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <map>
+#include <boost/cstdint.hpp>
+#include <ct_common/common/test_suite_reducer.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/constraint_checker.h>
+
+using namespace ct::common;
+
+namespace {
+/**
+ * The coverage multiplicities of combinations, one byte each, the byte
+ * 0xFF telling that the multiplicity is in the overflow table
+ */
+class MultiplicityCounter {
+public:
+  explicit MultiplicityCounter(std::size_t num_combinations)
+      : counts_(num_combinations, 0) {
+  }
+
+  std::size_t Get(std::size_t cid) const {
+    if (this->counts_[cid] != OVERFLOWED) {
+      return this->counts_[cid];
+    }
+    return this->overflow_.find(cid)->second;
+  }
+
+  void Increase(std::size_t cid) {
+    boost::uint8_t &count = this->counts_[cid];
+    if (count + 1 < OVERFLOWED) {
+      ++count;
+    } else if (count + 1 == OVERFLOWED) {
+      count = OVERFLOWED;
+      this->overflow_[cid] = OVERFLOWED;
+    } else {
+      ++this->overflow_[cid];
+    }
+  }
+
+  void Decrease(std::size_t cid) {
+    boost::uint8_t &count = this->counts_[cid];
+    if (count != OVERFLOWED) {
+      --count;
+      return;
+    }
+    std::map<std::size_t, std::size_t>::iterator iter = this->overflow_.find(cid);
+    if (--iter->second + 1 == OVERFLOWED) {
+      this->overflow_.erase(iter);
+      count = OVERFLOWED - 1;
+    }
+  }
+
+private:
+  static const boost::uint8_t OVERFLOWED = 0xFF;
+
+  std::vector<boost::uint8_t> counts_;  /**< The multiplicities below 0xFF */
+  std::map<std::size_t, std::size_t> overflow_;  /**< The multiplicities from 0xFF on */
+};
+
+/** Get the combinations of the strengths covered by a test case */
+void get_combinations(const CoverageMap &coverage, const TestCase &test, std::vector<std::size_t> &cids) {
+  cids.clear();
+  for (std::size_t sid = 0; sid < coverage.get_num_raw_strengths(); ++sid) {
+    std::size_t cid = coverage.GetCombinationId(sid, test);
+    if (cid != CID_BOUND) {
+      cids.push_back(cid);
+    }
+  }
+}
+
+/** Orders candidates by larger scores first, then by later rows */
+struct CandidateLess {
+  bool operator () (const std::pair<std::size_t, std::size_t> &left,
+                    const std::pair<std::size_t, std::size_t> &right) const {
+    if (left.first != right.first) {
+      return left.first > right.first;
+    }
+    return left.second > right.second;
+  }
+};
+}  // namespace
+
+TestSuiteReducer::TestSuiteReducer(void)
+    : num_removed_(0), num_seeded_(0) {
+}
+
+TestSuiteReducer::TestSuiteReducer(const TestSuiteReducer &from)
+    : kept_(from.kept_), num_removed_(from.num_removed_), num_seeded_(from.num_seeded_) {
+}
+
+TestSuiteReducer &TestSuiteReducer::operator = (const TestSuiteReducer &right) {
+  this->kept_ = right.kept_;
+  this->num_removed_ = right.num_removed_;
+  this->num_seeded_ = right.num_seeded_;
+  return *this;
+}
+
+TestSuiteReducer::~TestSuiteReducer(void) {
+}
+
+void TestSuiteReducer::Reduce(const SUTModel &model, std::vector<TestCase> &tests) {
+  this->kept_.clear();
+  this->num_removed_ = 0;
+  this->num_seeded_ = 0;
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+
+  std::vector<bool> is_kept(tests.size(), false), is_seeded(tests.size(), false);
+  std::vector<bool> is_valid(tests.size(), false);
+  std::vector<std::size_t> cids;
+  MultiplicityCounter counter(coverage.get_num_combinations());
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    for (std::size_t j = 0; j < model.seeds_.size() && !is_seeded[i]; ++j) {
+      EvalType_Bool result = model.seeds_[j]->IsMatch(tests[i], model.param_specs_);
+      is_seeded[i] = result.is_valid_ && result.value_;
+    }
+    is_valid[i] = tests[i].size() == model.param_specs_.size() && checker.IsValid(tests[i]);
+    if (is_valid[i]) {
+      get_combinations(coverage, tests[i], cids);
+      for (std::size_t j = 0; j < cids.size(); ++j) {
+        counter.Increase(cids[j]);
+      }
+    }
+  }
+
+  // test cases with a combination of their own stay, the others are tried
+  // from the most redundant ones
+  std::vector<std::pair<std::size_t, std::size_t> > candidates;
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (is_seeded[i]) {
+      is_kept[i] = true;
+      ++this->num_seeded_;
+      continue;
+    }
+    if (!is_valid[i]) {
+      continue;
+    }
+    get_combinations(coverage, tests[i], cids);
+    std::size_t score = 0;
+    bool is_unique = false;
+    for (std::size_t j = 0; j < cids.size() && !is_unique; ++j) {
+      std::size_t count = counter.Get(cids[j]);
+      is_unique = count == 1;
+      score += count;
+    }
+    if (is_unique) {
+      is_kept[i] = true;
+    } else {
+      candidates.push_back(std::pair<std::size_t, std::size_t>(score, i));
+    }
+  }
+  std::sort(candidates.begin(), candidates.end(), CandidateLess());
+  for (std::size_t i = 0; i < candidates.size(); ++i) {
+    std::size_t row = candidates[i].second;
+    get_combinations(coverage, tests[row], cids);
+    bool is_redundant = true;
+    for (std::size_t j = 0; j < cids.size() && is_redundant; ++j) {
+      is_redundant = counter.Get(cids[j]) > 1;
+    }
+    if (!is_redundant) {
+      is_kept[row] = true;
+      continue;
+    }
+    for (std::size_t j = 0; j < cids.size(); ++j) {
+      counter.Decrease(cids[j]);
+    }
+  }
+
+  std::size_t num_kept = 0;
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (is_kept[i]) {
+      this->kept_.push_back(i);
+      if (num_kept != i) {
+        tests[num_kept] = tests[i];
+      }
+      ++num_kept;
+    }
+  }
+  this->num_removed_ = tests.size() - num_kept;
+  tests.resize(num_kept);
+}
@@ -0,0 +1,60 @@
+//===----- ct_common/common/test_suite_reducer.h ----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the reducer removing redundant test cases
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_TEST_SUITE_REDUCER_H_
+#define CT_COMMON_TEST_SUITE_REDUCER_H_
+
+#include <vector>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace common {
+/**
+ * The reducer removing redundant test cases from suites, such as ones merged
+ * from several generations. A test case is redundant if every combination of
+ * the strengths it covers is covered by another kept test case. The coverage
+ * multiplicities are kept in one byte per combination, with the rare larger
+ * ones in an overflow table, so that removing a test case only visits its
+ * own combinations. Test cases covering a combination alone are never
+ * tried; the others are tried from the ones whose combinations are covered
+ * most often. Test cases matching seeds are kept, as well as their
+ * combinations. Test cases violating the constraints cover nothing, as in
+ * CoverageVerifier, and are removed unless they match seeds.
+ */
+class DLL_EXPORT TestSuiteReducer {
+public:
+  TestSuiteReducer(void);
+  TestSuiteReducer(const TestSuiteReducer &from);
+  TestSuiteReducer &operator = (const TestSuiteReducer &right);
+  ~TestSuiteReducer(void);
+
+  /** Remove the redundant test cases of the model, keeping the order of the others */
+  void Reduce(const SUTModel &model, std::vector<TestCase> &tests);
+
+  /** Get the original indices of the test cases kept by the last reduction */
+  const std::vector<std::size_t> &get_kept(void) const { return this->kept_; }
+  /** Get the number of test cases removed by the last reduction */
+  std::size_t get_num_removed(void) const { return this->num_removed_; }
+  /** Get the number of test cases kept for matching seeds by the last reduction */
+  std::size_t get_num_seeded(void) const { return this->num_seeded_; }
+
+private:
+  std::vector<std::size_t> kept_;  /**< The original indices of the kept test cases */
+  std::size_t num_removed_;  /**< The number of removed test cases */
+  std::size_t num_seeded_;  /**< The number of test cases kept for matching seeds */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_TEST_SUITE_REDUCER_H_
@@ -0,0 +1,347 @@
+//===----- ct_common/common/tree_decomposition.cpp --------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of the tree decompositions
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <set>
+#include <ct_common/common/tree_decomposition.h>
+
+using namespace ct::common;
+
+namespace {
+/** Orders pids by their positions in the elimination orders */
+struct PositionLess {
+  explicit PositionLess(const std::vector<std::size_t> &positions) : positions_(&positions) {}
+  bool operator()(std::size_t left, std::size_t right) const {
+    return (*this->positions_)[left] < (*this->positions_)[right];
+  }
+  const std::vector<std::size_t> *positions_;
+};
+
+void add_to(boost::multiprecision::cpp_int &sum, const boost::multiprecision::cpp_int &value) {
+  sum += value;
+}
+
+void add_to(unsigned char &sum, unsigned char value) {
+  sum |= value;
+}
+
+void multiply_by(boost::multiprecision::cpp_int &product, const boost::multiprecision::cpp_int &value) {
+  product *= value;
+}
+
+void multiply_by(unsigned char &product, unsigned char value) {
+  product &= value;
+}
+
+bool is_zero(const boost::multiprecision::cpp_int &value) {
+  return value == 0;
+}
+
+bool is_zero(unsigned char value) {
+  return value == 0;
+}
+
+/** Whether a constraint is satisfied by a test case */
+bool is_satisfied(const Constraint &constraint, const std::vector<boost::shared_ptr<ParamSpec> > &param_specs,
+                  const TestCase &test) {
+  EvalType_Bool result = constraint.Evaluate(param_specs, test);
+  return result.is_valid_ && result.value_;
+}
+
+/** The number of edges eliminating a parameter adds between its neighbours */
+std::size_t count_fill(const std::vector<std::set<std::size_t> > &adjacency, std::size_t pid) {
+  std::size_t tmp_return = 0;
+  const std::set<std::size_t> &neighbours = adjacency[pid];
+  for (std::set<std::size_t>::const_iterator i = neighbours.begin(); i != neighbours.end(); ++i) {
+    std::set<std::size_t>::const_iterator j = i;
+    for (++j; j != neighbours.end(); ++j) {
+      if (adjacency[*i].find(*j) == adjacency[*i].end()) {
+        ++tmp_return;
+      }
+    }
+  }
+  return tmp_return;
+}
+/** Add the scopes of the tables and constraints to a bag, sorted in the elimination order */
+template <typename T>
+void make_bag(const ConstraintChecker &checker, const std::vector<std::size_t> &cids,
+              const std::vector<BagTable<T> > &tables, const std::vector<std::size_t> &positions,
+              std::vector<std::size_t> &bag) {
+  for (std::size_t i = 0; i < tables.size(); ++i) {
+    bag.insert(bag.end(), tables[i].pids_.begin(), tables[i].pids_.end());
+  }
+  for (std::size_t i = 0; i < cids.size(); ++i) {
+    const std::vector<std::size_t> &pids = checker.get_rel_pids(cids[i]);
+    bag.insert(bag.end(), pids.begin(), pids.end());
+  }
+  std::sort(bag.begin(), bag.end(), PositionLess(positions));
+  bag.erase(std::unique(bag.begin(), bag.end()), bag.end());
+}
+
+/** The number of assignments of bag[first:], throws if more than max_table_size */
+std::size_t get_table_size(const std::vector<std::size_t> &bag, std::size_t first,
+                           const std::vector<std::vector<std::size_t> > &domains, std::size_t max_table_size) {
+  std::size_t tmp_return = 1;
+  for (std::size_t i = first; i < bag.size(); ++i) {
+    tmp_return *= domains[bag[i]].size();
+    if (tmp_return > max_table_size) {
+      CT_EXCEPTION("the tree decomposition is too wide to eliminate the parameters");
+    }
+  }
+  return tmp_return;
+}
+
+/**
+ * Enumerate the assignments of a bag with the last parameter fastest, the
+ * entries being the products of the constraints and the tables. If summed is
+ * not null, the entries are summed over bag[0] there, the index of an
+ * assignment of the rest being the count modulo the size of summed; if
+ * entries is not null, they are kept there by counts.
+ */
+template <typename T>
+void eliminate_bag(const SUTModel &model, const std::vector<std::size_t> &bag,
+                   const std::vector<std::size_t> &cids, const std::vector<BagTable<T> > &tables,
+                   const std::vector<std::vector<std::size_t> > &domains, std::vector<std::size_t> &slots,
+                   TestCase &test, std::vector<T> *summed, std::vector<T> *entries) {
+  for (std::size_t i = 0; i < bag.size(); ++i) {
+    slots[bag[i]] = i;
+  }
+  // the strides of the tables in the bag
+  std::vector<std::vector<std::size_t> > table_slots(tables.size());
+  std::vector<std::vector<std::size_t> > table_strides(tables.size());
+  for (std::size_t i = 0; i < tables.size(); ++i) {
+    const std::vector<std::size_t> &pids = tables[i].pids_;
+    table_slots[i].resize(pids.size());
+    table_strides[i].resize(pids.size());
+    std::size_t stride = 1;
+    for (std::size_t j = pids.size(); j-- > 0;) {
+      table_slots[i][j] = slots[pids[j]];
+      table_strides[i][j] = stride;
+      stride *= domains[pids[j]].size();
+    }
+  }
+
+  std::vector<std::size_t> indices(bag.size(), 0);
+  std::size_t count = 0;
+  bool is_done = false;
+  for (std::size_t i = 0; i < bag.size(); ++i) {
+    is_done = is_done || domains[bag[i]].empty();
+  }
+  while (!is_done) {
+    for (std::size_t i = 0; i < bag.size(); ++i) {
+      test[bag[i]] = domains[bag[i]][indices[i]];
+    }
+    bool is_valid = true;
+    for (std::size_t i = 0; i < cids.size() && is_valid; ++i) {
+      is_valid = is_satisfied(*model.constraints_[cids[i]], model.param_specs_, test);
+    }
+    if (is_valid) {
+      T value = T(1);
+      for (std::size_t i = 0; i < tables.size() && !is_zero(value); ++i) {
+        std::size_t index = 0;
+        for (std::size_t j = 0; j < table_slots[i].size(); ++j) {
+          index += indices[table_slots[i][j]] * table_strides[i][j];
+        }
+        multiply_by(value, tables[i].table_[index]);
+      }
+      if (summed) {
+        add_to((*summed)[count % summed->size()], value);
+      }
+      if (entries) {
+        (*entries)[count] = value;
+      }
+    }
+    ++count;
+    std::size_t i = bag.size();
+    while (i > 0 && ++indices[i - 1] == domains[bag[i - 1]].size()) {
+      indices[i - 1] = 0;
+      --i;
+    }
+    is_done = i == 0;
+  }
+  for (std::size_t i = 0; i < bag.size(); ++i) {
+    test[bag[i]] = VID_BOUND;
+  }
+}
+
+/**
+ * Eliminate the parameters at the first num_eliminated positions, returns
+ * the product of the tables passed to no parameter. The tables passed to the
+ * later positions are left in passed.
+ */
+template <typename T>
+T eliminate_positions(const SUTModel &model, const ConstraintChecker &checker,
+                      const TreeDecomposition &decomposition, const std::vector<std::size_t> &positions,
+                      const std::vector<std::vector<std::size_t> > &domains, std::size_t max_table_size,
+                      std::size_t num_eliminated, TestCase &test, std::vector<std::vector<BagTable<T> > > &passed,
+                      std::vector<BagTable<T> > *bags) {
+  passed.assign(decomposition.order_.size(), std::vector<BagTable<T> >());
+  std::vector<std::size_t> slots(checker.get_num_params());
+  if (bags) {
+    bags->assign(decomposition.order_.size(), BagTable<T>());
+  }
+  T tmp_return = T(1);
+  for (std::size_t pos = 0; pos < num_eliminated && !is_zero(tmp_return); ++pos) {
+    const std::vector<std::size_t> &cids = decomposition.buckets_[pos];
+    std::vector<std::size_t> bag(1, decomposition.order_[pos]);
+    make_bag(checker, cids, passed[pos], positions, bag);
+    std::vector<T> table(get_table_size(bag, 1, domains, max_table_size), T(0));
+    std::vector<T> *entries = 0;
+    if (bags) {
+      (*bags)[pos].pids_ = bag;
+      (*bags)[pos].table_.assign(get_table_size(bag, 0, domains, max_table_size), T(0));
+      entries = &(*bags)[pos].table_;
+    }
+    eliminate_bag(model, bag, cids, passed[pos], domains, slots, test, &table, entries);
+    passed[pos].clear();
+    if (bag.size() == 1) {
+      multiply_by(tmp_return, table[0]);
+    } else {
+      BagTable<T> next;
+      next.pids_.assign(bag.begin() + 1, bag.end());
+      next.table_.swap(table);
+      passed[positions[bag[1]]].push_back(next);
+    }
+  }
+  return tmp_return;
+}
+}  // namespace
+
+void ct::common::decompose_component(const ConstraintChecker &checker, const std::vector<std::size_t> &component,
+                                     EliminationHeuristic heuristic, std::vector<std::size_t> &positions,
+                                     TreeDecomposition &decomposition, const std::vector<std::size_t> *kept_pids) {
+  std::vector<std::set<std::size_t> > adjacency(checker.get_num_params());
+  std::set<std::size_t> cids;
+  for (std::size_t i = 0; i < component.size(); ++i) {
+    const std::vector<std::size_t> &param_constraints = checker.get_param_constraints(component[i]);
+    cids.insert(param_constraints.begin(), param_constraints.end());
+  }
+  for (std::set<std::size_t>::const_iterator i = cids.begin(); i != cids.end(); ++i) {
+    const std::vector<std::size_t> &pids = checker.get_rel_pids(*i);
+    for (std::size_t j = 0; j < pids.size(); ++j) {
+      for (std::size_t k = j + 1; k < pids.size(); ++k) {
+        adjacency[pids[j]].insert(pids[k]);
+        adjacency[pids[k]].insert(pids[j]);
+      }
+    }
+  }
+
+  decomposition.order_.clear();
+  decomposition.width_ = 0;
+  std::set<std::size_t> remaining(component.begin(), component.end()), kept;
+  if (kept_pids) {
+    for (std::size_t i = 0; i < kept_pids->size(); ++i) {
+      remaining.erase((*kept_pids)[i]);
+    }
+    kept.insert(kept_pids->begin(), kept_pids->end());
+  }
+  while (!remaining.empty() || !kept.empty()) {
+    // the kept parameters come last
+    if (remaining.empty()) {
+      remaining.swap(kept);
+    }
+    std::size_t best = *remaining.begin();
+    std::size_t best_fill = 0, best_degree = adjacency[best].size();
+    if (heuristic == ELIMINATION_MIN_FILL) {
+      best_fill = count_fill(adjacency, best);
+    }
+    for (std::set<std::size_t>::const_iterator i = remaining.begin(); i != remaining.end(); ++i) {
+      std::size_t fill = heuristic == ELIMINATION_MIN_FILL ? count_fill(adjacency, *i) : 0;
+      std::size_t degree = adjacency[*i].size();
+      if (fill < best_fill || (fill == best_fill && degree < best_degree)) {
+        best = *i;
+        best_fill = fill;
+        best_degree = degree;
+      }
+    }
+    positions[best] = decomposition.order_.size();
+    decomposition.order_.push_back(best);
+    decomposition.width_ = std::max(decomposition.width_, best_degree);
+    remaining.erase(best);
+    const std::set<std::size_t> neighbours = adjacency[best];
+    for (std::set<std::size_t>::const_iterator i = neighbours.begin(); i != neighbours.end(); ++i) {
+      adjacency[*i].erase(best);
+      for (std::set<std::size_t>::const_iterator j = neighbours.begin(); j != neighbours.end(); ++j) {
+        if (*i != *j) {
+          adjacency[*i].insert(*j);
+        }
+      }
+    }
+    adjacency[best].clear();
+  }
+
+  decomposition.buckets_.assign(decomposition.order_.size(), std::vector<std::size_t>());
+  for (std::set<std::size_t>::const_iterator i = cids.begin(); i != cids.end(); ++i) {
+    const std::vector<std::size_t> &pids = checker.get_rel_pids(*i);
+    std::size_t first = *std::min_element(pids.begin(), pids.end(), PositionLess(positions));
+    decomposition.buckets_[positions[first]].push_back(*i);
+  }
+}
+
+
+template <typename T>
+T ct::common::eliminate_component(const SUTModel &model, const ConstraintChecker &checker,
+                                  const TreeDecomposition &decomposition, const std::vector<std::size_t> &positions,
+                                  const std::vector<std::vector<std::size_t> > &domains, std::size_t max_table_size,
+                                  TestCase &test, std::vector<BagTable<T> > *bags) {
+  std::vector<std::vector<BagTable<T> > > passed;
+  return eliminate_positions(model, checker, decomposition, positions, domains, max_table_size,
+                             decomposition.order_.size(), test, passed, bags);
+}
+
+template <typename T>
+void ct::common::project_component(const SUTModel &model, const ConstraintChecker &checker,
+                                   const TreeDecomposition &decomposition, const std::vector<std::size_t> &positions,
+                                   const std::vector<std::vector<std::size_t> > &domains, std::size_t max_table_size,
+                                   std::size_t num_kept, TestCase &test, BagTable<T> &projection) {
+  std::size_t num_positions = decomposition.order_.size();
+  std::vector<std::vector<BagTable<T> > > passed;
+  T product = eliminate_positions(model, checker, decomposition, positions, domains, max_table_size,
+                                  num_positions - num_kept, test, passed, static_cast<std::vector<BagTable<T> > *>(0));
+  // the kept parameters form a single bag, with all tables and constraints left
+  std::vector<std::size_t> cids;
+  std::vector<BagTable<T> > tables;
+  projection.pids_.clear();
+  for (std::size_t pos = num_positions - num_kept; pos < num_positions; ++pos) {
+    projection.pids_.push_back(decomposition.order_[pos]);
+    cids.insert(cids.end(), decomposition.buckets_[pos].begin(), decomposition.buckets_[pos].end());
+    tables.insert(tables.end(), passed[pos].begin(), passed[pos].end());
+  }
+  projection.table_.assign(get_table_size(projection.pids_, 0, domains, max_table_size), T(0));
+  if (is_zero(product)) {
+    return;
+  }
+  std::vector<std::size_t> slots(checker.get_num_params());
+  eliminate_bag(model, projection.pids_, cids, tables, domains, slots, test,
+                static_cast<std::vector<T> *>(0), &projection.table_);
+  for (std::size_t i = 0; i < projection.table_.size(); ++i) {
+    multiply_by(projection.table_[i], product);
+  }
+}
+
+template boost::multiprecision::cpp_int ct::common::eliminate_component(
+    const SUTModel &model, const ConstraintChecker &checker, const TreeDecomposition &decomposition,
+    const std::vector<std::size_t> &positions, const std::vector<std::vector<std::size_t> > &domains,
+    std::size_t max_table_size, TestCase &test, std::vector<BagTable<boost::multiprecision::cpp_int> > *bags);
+template unsigned char ct::common::eliminate_component(
+    const SUTModel &model, const ConstraintChecker &checker, const TreeDecomposition &decomposition,
+    const std::vector<std::size_t> &positions, const std::vector<std::vector<std::size_t> > &domains,
+    std::size_t max_table_size, TestCase &test, std::vector<BagTable<unsigned char> > *bags);
+template void ct::common::project_component(
+    const SUTModel &model, const ConstraintChecker &checker, const TreeDecomposition &decomposition,
+    const std::vector<std::size_t> &positions, const std::vector<std::vector<std::size_t> > &domains,
+    std::size_t max_table_size, std::size_t num_kept, TestCase &test,
+    BagTable<boost::multiprecision::cpp_int> &projection);
+template void ct::common::project_component(
+    const SUTModel &model, const ConstraintChecker &checker, const TreeDecomposition &decomposition,
+    const std::vector<std::size_t> &positions, const std::vector<std::vector<std::size_t> > &domains,
+    std::size_t max_table_size, std::size_t num_kept, TestCase &test, BagTable<unsigned char> &projection);
@@ -0,0 +1,99 @@
+//===----- ct_common/common/tree_decomposition.h ----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the tree decompositions of the constraints of SUT
+// models, and the elimination of parameters over them
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_TREE_DECOMPOSITION_H_
+#define CT_COMMON_TREE_DECOMPOSITION_H_
+
+#include <vector>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+#include <ct_common/common/constraint_checker.h>
+
+namespace ct {
+namespace common {
+/** The heuristics for the elimination orders of tree decompositions */
+enum EliminationHeuristic {
+  ELIMINATION_MIN_FILL,  /**< Eliminate the parameter adding the fewest edges */
+  ELIMINATION_MIN_DEGREE  /**< Eliminate the parameter with the fewest neighbours */
+};
+
+/**
+ * The elimination order of a constraint component. Eliminating a parameter
+ * links its neighbours in the primal graph, where parameters are linked when
+ * some constraint touches both; the bag of a parameter is the parameter with
+ * its neighbours when eliminated, and each constraint is placed in the bucket
+ * of its first parameter eliminated.
+ */
+struct DLL_EXPORT TreeDecomposition {
+  std::vector<std::size_t> order_;  /**< The pids in the elimination order */
+  std::vector<std::vector<std::size_t> > buckets_;  /**< The constraint ids placed at each position */
+  std::size_t width_;  /**< The largest bag size minus one */
+};
+
+/**
+ * A table over the values of some parameters, indexed by the positions of
+ * their values in the domains with the last parameter fastest
+ */
+template <typename T>
+struct BagTable {
+  std::vector<std::size_t> pids_;  /**< The parameters, in the elimination order */
+  std::vector<T> table_;  /**< The entries */
+};
+
+/**
+ * Decompose a component of a checker by the heuristic, ties broken by the
+ * degrees, then by the pids. positions[pid] is set for the pids of the
+ * component. If kept_pids is not null, those parameters of the component
+ * come last in the order, as needed by project_component.
+ */
+void decompose_component(const ConstraintChecker &checker, const std::vector<std::size_t> &component,
+                         EliminationHeuristic heuristic, std::vector<std::size_t> &positions,
+                         TreeDecomposition &decomposition, const std::vector<std::size_t> *kept_pids = 0);
+
+/**
+ * Sum the product of the constraints of a decomposed component over the
+ * values in the domains, eliminating the parameters in order: the entries of
+ * the bag of a parameter are the products of its constraints and of the
+ * tables passed to it, which summed over its values give the table passed to
+ * the next parameter of the bag. T is boost::multiprecision::cpp_int for
+ * counting, or unsigned char for deciding whether any assignment exists.
+ * Throws if a table would have more than max_table_size entries. The cells
+ * of the component in test must be unassigned, and are restored. If bags is
+ * not null, the tables of all bags are kept there by positions, the
+ * parameter itself first.
+ */
+template <typename T>
+T eliminate_component(const SUTModel &model, const ConstraintChecker &checker,
+                      const TreeDecomposition &decomposition, const std::vector<std::size_t> &positions,
+                      const std::vector<std::vector<std::size_t> > &domains, std::size_t max_table_size,
+                      TestCase &test, std::vector<BagTable<T> > *bags = 0);
+
+/**
+ * Eliminate all parameters of a decomposed component but the last num_kept
+ * ones, giving the table over the kept parameters whose entries sum the
+ * product of the constraints over the other parameters, e.g. whether each
+ * combination of the kept parameters extends to a valid assignment of the
+ * component for unsigned char. Throws as eliminate_component, the table of
+ * the kept parameters included.
+ */
+template <typename T>
+void project_component(const SUTModel &model, const ConstraintChecker &checker,
+                       const TreeDecomposition &decomposition, const std::vector<std::size_t> &positions,
+                       const std::vector<std::vector<std::size_t> > &domains, std::size_t max_table_size,
+                       std::size_t num_kept, TestCase &test, BagTable<T> &projection);
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_TREE_DECOMPOSITION_H_
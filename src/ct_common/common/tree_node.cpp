@@ -13,6 +13,7 @@
 #include <stack>
 #include <map>
 #include <ct_common/common/tree_node.h>
+#include <ct_common/common/node_arena.h>
 #include <ct_common/common/arithmetic_utils.h>
 
 using namespace ct::common;
@@ -47,6 +48,14 @@ TreeNode::~TreeNode(void) {
   }
 }
 
+void *TreeNode::operator new(std::size_t size) {
+  return NodeArena::Allocate(size);
+}
+
+void TreeNode::operator delete(void *ptr) {
+  NodeArena::Deallocate(ptr);
+}
+
 TreeNode &TreeNode::operator =(const TreeNode &right) {
   this->oprds_ = right.oprds_;
   return *this;
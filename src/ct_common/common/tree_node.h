@@ -35,6 +35,10 @@ public:
   TreeNode &operator = (const TreeNode &right);
   virtual ~TreeNode(void) = 0;
 
+  /** Nodes are placed in the current NodeArena, if any */
+  static void *operator new(std::size_t size);
+  static void operator delete(void *ptr);
+
   /** TODO: replace by typeid */
   virtual std::string get_class_name(void) const;
   /** TODO: replace by typeid */
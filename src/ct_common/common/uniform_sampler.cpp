@@ -0,0 +1,218 @@
+//===----- ct_common/common/uniform_sampler.cpp -----------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class UniformSampler
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <limits>
+#include <boost/cstdint.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <ct_common/common/uniform_sampler.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/strided_threads.h>
+
+using namespace ct::common;
+
+namespace {
+/** Draws the chunks first, first + step, ... */
+struct SampleWorker {
+  void operator()(std::size_t first) const {
+    for (std::size_t i = first; i * this->chunk_size_ < this->tests_->size(); i += this->step_) {
+      boost::random::mt19937 rng(static_cast<boost::uint32_t>(this->random_seed_ + i));
+      std::size_t last = std::min((i + 1) * this->chunk_size_, this->tests_->size());
+      for (std::size_t j = i * this->chunk_size_; j < last; ++j) {
+        this->sampler_->Sample(rng, (*this->tests_)[j]);
+      }
+    }
+  }
+
+  const UniformSampler *sampler_;
+  std::vector<TestCase> *tests_;
+  unsigned int random_seed_;
+  std::size_t chunk_size_;
+  std::size_t step_;
+};
+
+/** Draw uniformly from [0, bound) */
+boost::multiprecision::cpp_int draw(const boost::multiprecision::cpp_int &bound, boost::random::mt19937 &rng) {
+  // most weights fit in a machine word, where the draws are much cheaper
+  if (bound <= std::numeric_limits<boost::uint64_t>::max()) {
+    boost::random::uniform_int_distribution<boost::uint64_t> distribution(
+        0, bound.convert_to<boost::uint64_t>() - 1);
+    return boost::multiprecision::cpp_int(distribution(rng));
+  }
+  boost::random::uniform_int_distribution<boost::multiprecision::cpp_int> distribution(0, bound - 1);
+  return distribution(rng);
+}
+}  // namespace
+
+UniformSampler::UniformSampler(void)
+    : heuristic_(ELIMINATION_MIN_FILL), max_table_size_(1 << 24), random_seed_(0), chunk_size_(1024),
+      num_threads_(0), num_configurations_(0), treewidth_(0), num_entries_(0) {
+}
+
+UniformSampler::UniformSampler(const UniformSampler &from)
+    : heuristic_(from.heuristic_), max_table_size_(from.max_table_size_), random_seed_(from.random_seed_),
+      chunk_size_(from.chunk_size_), num_threads_(from.num_threads_), empty_test_(from.empty_test_),
+      levels_(from.levels_), free_pids_(from.free_pids_), tables_(from.tables_),
+      num_configurations_(from.num_configurations_), treewidth_(from.treewidth_), num_entries_(from.num_entries_) {
+}
+
+UniformSampler &UniformSampler::operator = (const UniformSampler &right) {
+  this->heuristic_ = right.heuristic_;
+  this->max_table_size_ = right.max_table_size_;
+  this->random_seed_ = right.random_seed_;
+  this->chunk_size_ = right.chunk_size_;
+  this->num_threads_ = right.num_threads_;
+  this->empty_test_ = right.empty_test_;
+  this->levels_ = right.levels_;
+  this->free_pids_ = right.free_pids_;
+  this->tables_ = right.tables_;
+  this->num_configurations_ = right.num_configurations_;
+  this->treewidth_ = right.treewidth_;
+  this->num_entries_ = right.num_entries_;
+  return *this;
+}
+
+UniformSampler::~UniformSampler(void) {
+}
+
+void UniformSampler::Compile(const SUTModel &model) {
+  std::size_t num_params = model.param_specs_.size();
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  TestCase test = checker.MakeEmptyTest();
+  this->empty_test_ = test;
+  this->levels_.assign(num_params, 0);
+  this->free_pids_.clear();
+  this->tables_.clear();
+  this->num_configurations_ = checker.IsValid(test) ? 1 : 0;
+  this->treewidth_ = 0;
+  this->num_entries_ = 0;
+
+  std::vector<std::vector<std::size_t> > domains(num_params);
+  std::vector<std::size_t> positions(num_params, 0);
+  std::vector<bool> is_decomposed(num_params, false);
+  for (std::size_t i = 0; i < num_params && this->num_configurations_ != 0; ++i) {
+    if (model.param_specs_[i]->is_auto()) {
+      continue;
+    }
+    this->levels_[i] = model.param_specs_[i]->get_level();
+    for (std::size_t vid = 0; vid < this->levels_[i]; ++vid) {
+      domains[i].push_back(vid);
+    }
+  }
+  for (std::size_t i = 0; i < num_params && this->num_configurations_ != 0; ++i) {
+    if (model.param_specs_[i]->is_auto() || is_decomposed[i]) {
+      continue;
+    } else if (checker.get_param_constraints(i).empty()) {
+      this->free_pids_.push_back(i);
+      this->num_configurations_ *= this->levels_[i];
+      continue;
+    }
+    const std::vector<std::size_t> &component = checker.get_component(i);
+    for (std::size_t j = 0; j < component.size(); ++j) {
+      is_decomposed[component[j]] = true;
+    }
+    TreeDecomposition decomposition;
+    decompose_component(checker, component, this->heuristic_, positions, decomposition);
+    this->treewidth_ = std::max(this->treewidth_, decomposition.width_);
+    std::vector<BagTable<boost::multiprecision::cpp_int> > bags;
+    this->num_configurations_ *= eliminate_component<boost::multiprecision::cpp_int>(
+        model, checker, decomposition, positions, domains, this->max_table_size_, test, &bags);
+    this->tables_.push_back(std::vector<CumulativeTable>(bags.size()));
+    for (std::size_t j = 0; j < bags.size(); ++j) {
+      this->accumulate(bags[j], this->tables_.back()[j]);
+      this->num_entries_ += bags[j].table_.size();
+    }
+  }
+}
+
+void UniformSampler::Sample(boost::random::mt19937 &rng, TestCase &test) const {
+  if (this->num_configurations_ == 0) {
+    CT_EXCEPTION("there is no valid test case to sample");
+  }
+  test = this->empty_test_;
+  for (std::size_t i = 0; i < this->free_pids_.size(); ++i) {
+    std::size_t pid = this->free_pids_[i];
+    boost::random::uniform_int_distribution<std::size_t> distribution(0, this->levels_[pid] - 1);
+    test[pid] = distribution(rng);
+  }
+  for (std::size_t i = 0; i < this->tables_.size(); ++i) {
+    this->sample_component(this->tables_[i], rng, test);
+  }
+}
+
+void UniformSampler::Sample(std::size_t num_samples, std::vector<TestCase> &tests) const {
+  if (this->num_configurations_ == 0) {
+    CT_EXCEPTION("there is no valid test case to sample");
+  }
+  tests.assign(num_samples, TestCase());
+  std::size_t chunk_size = std::max(this->chunk_size_, std::size_t(1));
+  std::size_t num_chunks = (num_samples + chunk_size - 1) / chunk_size;
+  std::size_t num_threads = resolve_num_threads(this->num_threads_, num_chunks);
+
+  SampleWorker worker;
+  worker.sampler_ = this;
+  worker.tests_ = &tests;
+  worker.random_seed_ = this->random_seed_;
+  worker.chunk_size_ = chunk_size;
+  worker.step_ = num_threads;
+  run_strided(num_threads, worker);
+}
+
+void UniformSampler::accumulate(const BagTable<boost::multiprecision::cpp_int> &bag,
+                                CumulativeTable &cumulative) const {
+  cumulative.pids_ = bag.pids_;
+  cumulative.weights_.clear();
+  cumulative.large_weights_.clear();
+  std::size_t level = this->levels_[bag.pids_[0]];
+  std::size_t rest_size = bag.table_.size() / level;
+  // row rest_index holds the running sums over the values of the first parameter
+  cumulative.large_weights_.resize(bag.table_.size());
+  bool is_small = true;
+  for (std::size_t rest_index = 0; rest_index < rest_size; ++rest_index) {
+    boost::multiprecision::cpp_int total = 0;
+    for (std::size_t vid = 0; vid < level; ++vid) {
+      total += bag.table_[vid * rest_size + rest_index];
+      cumulative.large_weights_[rest_index * level + vid] = total;
+    }
+    is_small = is_small && total <= std::numeric_limits<boost::uint64_t>::max();
+  }
+  if (is_small) {
+    cumulative.weights_.resize(cumulative.large_weights_.size());
+    for (std::size_t i = 0; i < cumulative.weights_.size(); ++i) {
+      cumulative.weights_[i] = cumulative.large_weights_[i].convert_to<boost::uint64_t>();
+    }
+    std::vector<boost::multiprecision::cpp_int>().swap(cumulative.large_weights_);
+  }
+}
+
+void UniformSampler::sample_component(const std::vector<CumulativeTable> &tables, boost::random::mt19937 &rng,
+                                      TestCase &test) const {
+  // the later parameters of a bag are drawn before the parameter itself
+  for (std::size_t pos = tables.size(); pos-- > 0;) {
+    const std::vector<std::size_t> &pids = tables[pos].pids_;
+    std::size_t rest_size = 1, rest_index = 0;
+    for (std::size_t i = pids.size(); i-- > 1;) {
+      rest_index += test[pids[i]] * rest_size;
+      rest_size *= this->levels_[pids[i]];
+    }
+    // the first value whose cumulative weight exceeds the draw
+    std::size_t level = this->levels_[pids[0]];
+    if (!tables[pos].weights_.empty()) {
+      const boost::uint64_t *row = &tables[pos].weights_[rest_index * level];
+      boost::random::uniform_int_distribution<boost::uint64_t> distribution(0, row[level - 1] - 1);
+      test[pids[0]] = std::upper_bound(row, row + level, distribution(rng)) - row;
+    } else {
+      const boost::multiprecision::cpp_int *row = &tables[pos].large_weights_[rest_index * level];
+      test[pids[0]] = std::upper_bound(row, row + level, draw(row[level - 1], rng)) - row;
+    }
+  }
+}
@@ -0,0 +1,126 @@
+//===----- ct_common/common/uniform_sampler.h -------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for sampling valid test cases uniformly
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_UNIFORM_SAMPLER_H_
+#define CT_COMMON_UNIFORM_SAMPLER_H_
+
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/multiprecision/cpp_int.hpp>
+#include <ct_common/common/utils.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_case.h>
+#include <ct_common/common/tree_decomposition.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for drawing valid test cases of a model uniformly at random,
+ * i.e. each assignment of valid values to all parameters but the auto ones
+ * satisfying all constraints with the same probability, auto parameters
+ * taking their invalid values.
+ *
+ * Compile counts the constraint components over their tree decompositions
+ * as ModelCounter does, keeping the table of each bag, whose entry is the
+ * number of valid assignments of the parameters eliminated so far given the
+ * values of the bag. The entries are kept as the cumulative weights of the
+ * values of the first parameter of the bag, for each assignment of the later
+ * ones. Sampling walks the elimination order backwards, drawing each
+ * parameter by a binary search of these weights given the later parameters
+ * already drawn, so that no constraint is evaluated and no draw is rejected.
+ * Unconstrained parameters are drawn uniformly from their valid values.
+ */
+class DLL_EXPORT UniformSampler {
+public:
+  UniformSampler(void);
+  UniformSampler(const UniformSampler &from);
+  UniformSampler &operator = (const UniformSampler &right);
+  ~UniformSampler(void);
+
+  /** Compile a model for sampling */
+  void Compile(const SUTModel &model);
+  /** Draw a valid test case, throws if there is none */
+  void Sample(boost::random::mt19937 &rng, TestCase &test) const;
+  /**
+   * Draw valid test cases, throws if there is none. The samples are drawn in
+   * chunks, chunk k from its own stream seeded with random_seed + k, and the
+   * threads take the chunks in turn, so that the results depend on the seed
+   * and the chunk size but not on the number of threads.
+   */
+  void Sample(std::size_t num_samples, std::vector<TestCase> &tests) const;
+
+  /** Set the heuristic for the elimination orders */
+  void set_heuristic(EliminationHeuristic heuristic) { this->heuristic_ = heuristic; }
+  /** Get the heuristic for the elimination orders */
+  EliminationHeuristic get_heuristic(void) const { return this->heuristic_; }
+  /** Set the largest number of entries of a table, beyond which compiling fails */
+  void set_max_table_size(std::size_t max_table_size) { this->max_table_size_ = max_table_size; }
+  /** Get the largest number of entries of a table */
+  std::size_t get_max_table_size(void) const { return this->max_table_size_; }
+  /** Set the seed of the random streams */
+  void set_random_seed(unsigned int random_seed) { this->random_seed_ = random_seed; }
+  /** Get the seed of the random streams */
+  unsigned int get_random_seed(void) const { return this->random_seed_; }
+  /** Set the number of samples drawn from each random stream */
+  void set_chunk_size(std::size_t chunk_size) { this->chunk_size_ = chunk_size; }
+  /** Get the number of samples drawn from each random stream */
+  std::size_t get_chunk_size(void) const { return this->chunk_size_; }
+  /** Set the number of threads, 0 for the number of hardware threads */
+  void set_num_threads(std::size_t num_threads) { this->num_threads_ = num_threads; }
+  /** Get the number of threads */
+  std::size_t get_num_threads(void) const { return this->num_threads_; }
+
+  /** Get the number of valid configurations */
+  const boost::multiprecision::cpp_int &get_num_configurations(void) const { return this->num_configurations_; }
+  /** Get the width of the tree decomposition */
+  std::size_t get_treewidth(void) const { return this->treewidth_; }
+  /** Get the number of entries of the tables kept */
+  std::size_t get_num_entries(void) const { return this->num_entries_; }
+
+private:
+  /**
+   * The cumulative weights of the values of the first parameter of a bag,
+   * row by row of the assignments of the later ones, in 64 bits if the totals
+   * of all rows fit
+   */
+  struct CumulativeTable {
+    std::vector<std::size_t> pids_;  /**< The parameters, in the elimination order */
+    std::vector<boost::uint64_t> weights_;  /**< The cumulative weights, if they fit in 64 bits */
+    std::vector<boost::multiprecision::cpp_int> large_weights_;  /**< The cumulative weights otherwise */
+  };
+
+  /** Make the cumulative table of a bag table */
+  void accumulate(const BagTable<boost::multiprecision::cpp_int> &bag, CumulativeTable &cumulative) const;
+  /** Draw the parameters of a component given by its cumulative tables */
+  void sample_component(const std::vector<CumulativeTable> &tables, boost::random::mt19937 &rng,
+                        TestCase &test) const;
+
+  EliminationHeuristic heuristic_;  /**< The heuristic for the elimination orders */
+  std::size_t max_table_size_;  /**< The largest number of entries of a table */
+  unsigned int random_seed_;  /**< The seed of the random streams */
+  std::size_t chunk_size_;  /**< The number of samples drawn from each random stream */
+  std::size_t num_threads_;  /**< The number of threads, 0 for the number of hardware threads */
+
+  TestCase empty_test_;  /**< The test case with the auto parameters assigned only */
+  std::vector<std::size_t> levels_;  /**< The levels of all parameters */
+  std::vector<std::size_t> free_pids_;  /**< The parameters in no constraint, but the auto ones */
+  /** The cumulative tables of each component by positions in its elimination order */
+  std::vector<std::vector<CumulativeTable> > tables_;
+  boost::multiprecision::cpp_int num_configurations_;  /**< The number of valid configurations */
+  std::size_t treewidth_;  /**< The width of the tree decomposition */
+  std::size_t num_entries_;  /**< The number of entries of the tables kept */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_UNIFORM_SAMPLER_H_
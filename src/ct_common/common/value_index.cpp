@@ -0,0 +1,121 @@
+//===----- ct_common/common/value_index.cpp ---------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file contains the function definitions of class ValueIndex
+//
+//===----------------------------------------------------------------------===//
+
+#include <cstring>
+#include <ct_common/common/value_index.h>
+#include <ct_common/common/defs.h>
+
+using namespace ct::common;
+
+const boost::uint32_t ValueIndex::EMPTY_SLOT;
+
+ValueIndex::ValueIndex(void)
+    : size_(0) {
+}
+
+ValueIndex::ValueIndex(const ValueIndex &from)
+    : slots_(from.slots_), size_(from.size_) {
+}
+
+ValueIndex &ValueIndex::operator = (const ValueIndex &right) {
+  this->slots_ = right.slots_;
+  this->size_ = right.size_;
+  return *this;
+}
+
+ValueIndex::~ValueIndex(void) {
+}
+
+boost::uint32_t ValueIndex::hash(const char *data, std::size_t size) {
+  boost::uint32_t tmp_return = 2166136261u;
+  for (std::size_t i = 0; i < size; ++i) {
+    tmp_return ^= static_cast<unsigned char>(data[i]);
+    tmp_return *= 16777619u;
+  }
+  return tmp_return;
+}
+
+void ValueIndex::Clear(std::size_t num_entries) {
+  // keep the load factor below 1/2
+  std::size_t capacity = 0;
+  if (num_entries > 0) {
+    capacity = 8;
+    while (capacity < num_entries * 2) {
+      capacity *= 2;
+    }
+  }
+  Slot empty_slot;
+  empty_slot.hash_ = 0;
+  empty_slot.vid_ = EMPTY_SLOT;
+  this->slots_.assign(capacity, empty_slot);
+  this->size_ = 0;
+}
+
+void ValueIndex::rehash(std::size_t capacity) {
+  std::vector<Slot> old_slots;
+  old_slots.swap(this->slots_);
+  Slot empty_slot;
+  empty_slot.hash_ = 0;
+  empty_slot.vid_ = EMPTY_SLOT;
+  this->slots_.assign(capacity, empty_slot);
+  std::size_t mask = capacity - 1;
+  for (std::size_t i = 0; i < old_slots.size(); ++i) {
+    if (old_slots[i].vid_ == EMPTY_SLOT) {
+      continue;
+    }
+    std::size_t pos = old_slots[i].hash_ & mask;
+    while (this->slots_[pos].vid_ != EMPTY_SLOT) {
+      pos = (pos + 1) & mask;
+    }
+    this->slots_[pos] = old_slots[i];
+  }
+}
+
+std::size_t ValueIndex::Insert(const std::vector<std::string> &keys, std::size_t vid) {
+  if ((this->size_ + 1) * 2 > this->slots_.size()) {
+    this->rehash(this->slots_.empty() ? 8 : this->slots_.size() * 2);
+  }
+  const std::string &key = keys[vid];
+  boost::uint32_t key_hash = hash(key.data(), key.size());
+  std::size_t mask = this->slots_.size() - 1;
+  std::size_t pos = key_hash & mask;
+  while (this->slots_[pos].vid_ != EMPTY_SLOT) {
+    if (this->slots_[pos].hash_ == key_hash && keys[this->slots_[pos].vid_] == key) {
+      return this->slots_[pos].vid_;
+    }
+    pos = (pos + 1) & mask;
+  }
+  this->slots_[pos].hash_ = key_hash;
+  this->slots_[pos].vid_ = static_cast<boost::uint32_t>(vid);
+  ++this->size_;
+  return VID_BOUND;
+}
+
+std::size_t ValueIndex::Find(const std::vector<std::string> &keys, const char *data, std::size_t size) const {
+  if (this->size_ == 0) {
+    return VID_BOUND;
+  }
+  boost::uint32_t key_hash = hash(data, size);
+  std::size_t mask = this->slots_.size() - 1;
+  std::size_t pos = key_hash & mask;
+  while (this->slots_[pos].vid_ != EMPTY_SLOT) {
+    const Slot &slot = this->slots_[pos];
+    if (slot.hash_ == key_hash) {
+      const std::string &key = keys[slot.vid_];
+      if (key.size() == size && (size == 0 || std::memcmp(key.data(), data, size) == 0)) {
+        return slot.vid_;
+      }
+    }
+    pos = (pos + 1) & mask;
+  }
+  return VID_BOUND;
+}
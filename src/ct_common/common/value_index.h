@@ -0,0 +1,72 @@
+//===----- ct_common/common/value_index.h -----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the class for looking up value ids by strings
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_VALUE_INDEX_H_
+#define CT_COMMON_VALUE_INDEX_H_
+
+#include <string>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <ct_common/common/utils.h>
+
+namespace ct {
+namespace common {
+/**
+ * The class for looking up value ids by their strings.
+ * It is a flat open-addressing hash table (linear probing) over the vids; the
+ * strings themselves are not copied but looked up in the vector passed to
+ * each call, which must be the one the index is built on.
+ */
+class DLL_EXPORT ValueIndex {
+public:
+  ValueIndex(void);
+  ValueIndex(const ValueIndex &from);
+  ValueIndex &operator = (const ValueIndex &right);
+  ~ValueIndex(void);
+
+  /** Remove all entries, reserving space for the given number of entries */
+  void Clear(std::size_t num_entries = 0);
+  /**
+   * Insert keys[vid], returns VID_BOUND if inserted, or the vid of the equal
+   * key already present (the index is not changed then)
+   */
+  std::size_t Insert(const std::vector<std::string> &keys, std::size_t vid);
+  /** Find the vid of the given string, VID_BOUND if absent */
+  std::size_t Find(const std::vector<std::string> &keys, const char *data, std::size_t size) const;
+  std::size_t Find(const std::vector<std::string> &keys, const std::string &str) const {
+    return this->Find(keys, str.data(), str.size());
+  }
+
+  /** Get the number of entries */
+  std::size_t size(void) const { return this->size_; }
+
+private:
+  /** Hash of strings (32-bit FNV-1a) */
+  static boost::uint32_t hash(const char *data, std::size_t size);
+  /** Rebuild the table with the given capacity (a power of 2) */
+  void rehash(std::size_t capacity);
+
+private:
+  /** A slot of the table */
+  struct Slot {
+    boost::uint32_t hash_;  /**< The hash of the key, for fast rejection */
+    boost::uint32_t vid_;  /**< The vid, EMPTY_SLOT for empty slots */
+  };
+  static const boost::uint32_t EMPTY_SLOT = 0xFFFFFFFFu;
+
+  std::vector<Slot> slots_;  /**< The slots, the number is 0 or a power of 2 */
+  std::size_t size_;  /**< The number of entries */
+};
+}  // namespace common
+}  // namespace ct
+
+#endif  // CT_COMMON_VALUE_INDEX_H_
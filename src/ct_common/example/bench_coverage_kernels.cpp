@@ -0,0 +1,87 @@
+// Benchmark for the vectorized coverage kernels on random test suites. The
+// suite is covered at every instruction set the CPU supports, and the bitmaps
+// must equal the one of the row-wise CoverageMap pass.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/coverage_kernels.h>
+#include <ct_common/common/test_suite.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+bool is_same_coverage(const CoverageMap &left, const CoverageMap &right) {
+  if (left.get_num_covered() != right.get_num_covered()) {
+    return false;
+  }
+  for (std::size_t cid = 0; cid < left.get_num_combinations(); ++cid) {
+    if (left.IsCovered(cid) != right.IsCovered(cid)) {
+      return false;
+    }
+  }
+  return true;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 20, num_values = 6, strength = 3, num_rows = 100000;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_rows = std::atoi(argv[4]);
+  }
+  std::srand(1);
+  SUTModel model;
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  const std::vector<boost::shared_ptr<ParamSpec> > &param_specs = model.param_specs_;
+  std::vector<Strength> strengths(1, Strength(pids, strength));
+  // a few invalid and unassigned cells, which take part in no combination
+  std::vector<TestCase> tests(num_rows);
+  for (std::size_t i = 0; i < num_rows; ++i) {
+    for (std::size_t j = 0; j < num_params; ++j) {
+      std::size_t r = std::rand() % 1000;
+      tests[i].push_back(r == 0 ? VID_BOUND : (r == 1 ? num_values : std::rand() % num_values));
+    }
+  }
+  TestSuite suite(param_specs);
+  suite.Append(tests);
+  std::cout << num_params << " parameters with " << num_values << " values, strength " << strength
+            << ", " << num_rows << " tests" << std::endl;
+
+  CoverageMap expected(param_specs, strengths);
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    expected.Cover(tests[i]);
+  }
+  std::cout << "row-wise: " << expected.get_num_covered() << " of " << expected.get_num_combinations()
+            << " covered in " << elapsed(start) << " s" << std::endl;
+
+  int tmp_return = 0;
+  CoverageMap coverage(param_specs, strengths);
+  for (int level = SIMD_SCALAR; level <= get_supported_simd_level(); ++level) {
+    set_simd_level(SimdLevel(level));
+    coverage.Reset();
+    start = boost::posix_time::microsec_clock::universal_time();
+    coverage.Cover(suite);
+    double time = elapsed(start);
+    std::cout << get_simd_level_name(SimdLevel(level)) << ": " << coverage.get_num_covered()
+              << " covered in " << time << " s";
+    if (!is_same_coverage(coverage, expected)) {
+      std::cout << ", which differs";
+      tmp_return = 1;
+    }
+    std::cout << std::endl;
+  }
+  return tmp_return;
+}
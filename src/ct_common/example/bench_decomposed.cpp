@@ -0,0 +1,82 @@
+// Benchmark for the decomposed generator on random models of independent
+// subsystems, comparing it with IPOG on the whole model and checking the
+// coverage of both test suites.
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/common/coverage_verifier.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Build a model of subsystems, each with its own strength and constraints */
+void build_model(SUTModel &model, std::size_t num_subsystems, std::size_t num_params, std::size_t num_values,
+                 std::size_t strength, std::size_t num_constraints) {
+  for (std::size_t s = 0; s < num_subsystems; ++s) {
+    std::size_t first = model.param_specs_.size();
+    std::ostringstream prefix;
+    prefix << "s" << s << "_p";
+    std::vector<std::size_t> pids = add_params(model, num_params, num_values, prefix.str());
+    model.strengths_.push_back(Strength(pids, strength));
+    for (std::size_t i = 0; i < num_constraints; ++i) {
+      model.constraints_.push_back(make_implication(first, num_params, num_values));
+    }
+  }
+}
+
+void run(Generator &generator, const SUTModel &model) {
+  std::vector<TestCase> tests;
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  generator.Generate(model, tests);
+  double time = elapsed(start);
+  CoverageVerifier verifier;
+  verifier.Verify(model, tests);
+  const StrengthCoverage &total = verifier.get_total_coverage();
+  std::cout << generator.get_class_name() << ": " << tests.size() << " tests in " << time << " s, "
+            << total.num_covered_ << " of " << total.num_combinations_ << " covered, "
+            << total.get_num_missing() << " missing, " << verifier.get_num_invalid() << " invalid" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_subsystems = 4, num_params = 12, num_values = 4, strength = 3, num_constraints = 3;
+  if (argc > 1) {
+    num_subsystems = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_params = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    num_values = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    strength = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    num_constraints = std::atoi(argv[5]);
+  }
+  std::srand(1);
+  SUTModel model;
+  build_model(model, num_subsystems, num_params, num_values, strength, num_constraints);
+  std::cout << num_subsystems << " subsystems of " << num_params << " parameters with " << num_values
+            << " values, strength " << strength << ", " << num_constraints << " constraints each" << std::endl;
+
+  Generator_IPOG ipog;
+  run(ipog, model);
+  Generator_Decomposed decomposed;
+  run(decomposed, model);
+  std::cout << "  " << decomposed.get_components().size() << " components of sizes";
+  for (std::size_t i = 0; i < decomposed.get_component_sizes().size(); ++i) {
+    std::cout << " " << decomposed.get_component_sizes()[i];
+  }
+  std::cout << std::endl;
+  return 0;
+}
@@ -0,0 +1,115 @@
+// Benchmark for the domain reduction on random models with unary and binary
+// constraints. IPOG runs on the model and on the reduced one, whose test
+// cases are mapped back and verified against the model.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/common/coverage_verifier.h>
+#include <ct_common/common/domain_reducer.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Build p != val */
+boost::shared_ptr<Constraint> make_unary(std::size_t pid, int val) {
+  boost::shared_ptr<Constraint_A_NE> ne(new Constraint_A_NE());
+  ne->set_loprd(make_param(pid));
+  ne->set_roprd(make_int(val));
+  return ne;
+}
+
+/** Build p1 < p2 */
+boost::shared_ptr<Constraint> make_binary(std::size_t p1, std::size_t p2) {
+  boost::shared_ptr<Constraint_A_LT> lt(new Constraint_A_LT());
+  lt->set_loprd(make_param(p1));
+  lt->set_roprd(make_param(p2));
+  return lt;
+}
+
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values, std::size_t strength,
+                 std::size_t num_unary, std::size_t num_binary) {
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, strength));
+  for (std::size_t i = 0; i < num_unary; ++i) {
+    model.constraints_.push_back(make_unary(std::rand() % num_params, int(std::rand() % num_values)));
+  }
+  // chains p1 < p2 cut the smallest and largest values off
+  for (std::size_t i = 0; i < num_binary; ++i) {
+    std::size_t p1 = std::rand() % num_params, p2 = std::rand() % num_params;
+    while (p2 == p1) {
+      p2 = std::rand() % num_params;
+    }
+    model.constraints_.push_back(make_binary(std::min(p1, p2), std::max(p1, p2)));
+  }
+}
+
+/** Verify the test cases against the model, returns whether they pass */
+bool verify(const SUTModel &model, const std::vector<TestCase> &tests) {
+  CoverageVerifier verifier;
+  verifier.Verify(model, tests);
+  const StrengthCoverage &total = verifier.get_total_coverage();
+  std::cout << "  " << total.num_covered_ << " of " << total.num_combinations_ << " covered, "
+            << total.num_infeasible_ << " infeasible, " << total.get_num_missing() << " missing, "
+            << verifier.get_num_invalid() << " invalid" << std::endl;
+  return verifier.IsPassed();
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 20, num_values = 5, strength = 3, num_unary = 15, num_binary = 10;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_unary = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    num_binary = std::atoi(argv[5]);
+  }
+  std::srand(1);
+  SUTModel model;
+  build_model(model, num_params, num_values, strength, num_unary, num_binary);
+  std::cout << num_params << " parameters with " << num_values << " values, strength " << strength
+            << ", " << num_unary << " unary and " << num_binary << " binary constraints" << std::endl;
+
+  int tmp_return = 0;
+  Generator_IPOG generator;
+  std::vector<TestCase> tests;
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  generator.Generate(model, tests);
+  std::cout << "IPOG on the model: " << tests.size() << " tests in " << elapsed(start) << " s, "
+            << generator.get_num_infeasible() << " infeasible" << std::endl;
+  if (!verify(model, tests)) {
+    tmp_return = 1;
+  }
+
+  DomainReducer reducer;
+  SUTModel reduced;
+  start = boost::posix_time::microsec_clock::universal_time();
+  reducer.Reduce(model, reduced);
+  std::cout << "DomainReducer: " << reducer.get_num_removed_values() << " values and "
+            << reducer.get_num_removed_combinations() << " target combinations removed, "
+            << reducer.get_num_revisions() << " revisions in " << elapsed(start) << " s" << std::endl;
+  start = boost::posix_time::microsec_clock::universal_time();
+  generator.Generate(reduced, tests);
+  reducer.RestoreTests(tests);
+  std::cout << "IPOG on the reduced model: " << tests.size() << " tests in " << elapsed(start) << " s, "
+            << generator.get_num_infeasible() << " infeasible" << std::endl;
+  if (!verify(model, tests)) {
+    tmp_return = 1;
+  }
+  return tmp_return;
+}
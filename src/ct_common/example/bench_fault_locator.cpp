@@ -0,0 +1,153 @@
+// Benchmark for the fault localization on a model with planted faults. A
+// large random suite is analyzed at once, which must find exactly the
+// planted combinations; then a small covering array is analyzed in rounds,
+// the follow-up test cases of each round being executed and appended to the
+// suite, until the top suspect is the planted one.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/common/fault_locator.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values) {
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, 2));
+  // p0 != p1
+  boost::shared_ptr<Constraint_A_NE> ne(new Constraint_A_NE());
+  ne->set_loprd(make_param(0));
+  ne->set_roprd(make_param(1));
+  model.constraints_.push_back(ne);
+}
+
+Tuple make_tuple(std::size_t pid1, std::size_t vid1, std::size_t pid2, std::size_t vid2) {
+  Tuple tmp_return;
+  tmp_return.push_back(PVPair(pid1, vid1));
+  tmp_return.push_back(PVPair(pid2, vid2));
+  return tmp_return;
+}
+
+/** Whether a test case contains any fault */
+bool is_failing(const TestCase &test, const std::vector<Tuple> &faults) {
+  for (std::size_t i = 0; i < faults.size(); ++i) {
+    bool is_contained = true;
+    for (std::size_t j = 0; j < faults[i].size() && is_contained; ++j) {
+      is_contained = test[faults[i][j].pid_] == faults[i][j].vid_;
+    }
+    if (is_contained) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void print_suspects(const FaultLocator &locator, std::size_t num_printed) {
+  const std::vector<FaultSuspect> &suspects = locator.get_suspects();
+  for (std::size_t i = 0; i < suspects.size() && i < num_printed; ++i) {
+    std::cout << "  #" << i + 1 << " {";
+    for (std::size_t j = 0; j < suspects[i].tuple_.size(); ++j) {
+      std::cout << (j == 0 ? "" : ", ") << "p" << suspects[i].tuple_[j].pid_ << "=" << suspects[i].tuple_[j].vid_;
+    }
+    std::cout << "} in " << suspects[i].num_failed_ << " failed, score " << suspects[i].score_ << std::endl;
+  }
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 20, num_values = 5, num_rows = 100000;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    num_rows = std::atoi(argv[3]);
+  }
+  SUTModel model;
+  build_model(model, num_params, num_values);
+  std::vector<Tuple> faults;
+  faults.push_back(make_tuple(3, 1, 7, 2));
+  Tuple fault = make_tuple(2, 0, 5, 3);
+  fault.push_back(PVPair(num_params - 1, 4 % num_values));
+  faults.push_back(fault);
+  std::cout << num_params << " parameters with " << num_values << " values, faults {p3=1, p7=2} and {p2=0, p5=3, p"
+            << num_params - 1 << "=" << 4 % num_values << "}" << std::endl;
+
+  int tmp_return = 0;
+  // a large random suite exposes exactly the faults
+  std::srand(1);
+  std::vector<TestCase> tests(num_rows);
+  std::vector<bool> is_failed(num_rows);
+  for (std::size_t i = 0; i < num_rows; ++i) {
+    tests[i].resize(num_params);
+    for (std::size_t j = 0; j < num_params; ++j) {
+      tests[i][j] = std::rand() % num_values;
+    }
+    is_failed[i] = is_failing(tests[i], faults);
+  }
+  for (std::size_t num_threads = 1; num_threads <= 4; num_threads *= 4) {
+    FaultLocator locator;
+    locator.set_max_strength(3);
+    locator.set_num_threads(num_threads);
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    locator.Analyze(model, tests, is_failed);
+    std::cout << num_rows << " random tests with " << num_threads << " threads: " << locator.get_num_failed()
+              << " failed, " << locator.get_num_ignored() << " ignored, " << locator.get_num_suspicious()
+              << " suspicious, " << locator.get_suspects().size() << " suspects in " << elapsed(start) << " s"
+              << std::endl;
+    print_suspects(locator, 5);
+    std::vector<Tuple> found;
+    for (std::size_t i = 0; i < locator.get_suspects().size(); ++i) {
+      found.push_back(locator.get_suspects()[i].tuple_);
+    }
+    if (found != faults) {
+      std::cout << "the suspects are not the faults" << std::endl;
+      tmp_return = 1;
+    }
+  }
+
+  // a pairwise suite with the 2-way fault, refined by the follow-ups
+  faults.pop_back();
+  Generator_IPOG generator;
+  generator.Generate(model, tests);
+  is_failed.resize(tests.size());
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    is_failed[i] = is_failing(tests[i], faults);
+  }
+  FaultLocator locator;
+  locator.set_num_follow_ups(5);
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  for (std::size_t round = 0; round < 10; ++round) {
+    locator.Analyze(model, tests, is_failed);
+    std::cout << "round " << round << ": " << tests.size() << " tests, " << locator.get_num_failed() << " failed, "
+              << locator.get_suspects().size() << " suspects" << std::endl;
+    print_suspects(locator, 3);
+    if (locator.get_suspects().size() == 1 && locator.get_suspects()[0].tuple_ == faults[0]) {
+      break;
+    }
+    const std::vector<TestCase> &follow_ups = locator.get_follow_ups();
+    for (std::size_t i = 0; i < follow_ups.size(); ++i) {
+      if (!checker.IsValid(follow_ups[i])) {
+        std::cout << "invalid follow-up" << std::endl;
+        tmp_return = 1;
+      }
+      tests.push_back(follow_ups[i]);
+      is_failed.push_back(is_failing(follow_ups[i], faults));
+    }
+  }
+  if (locator.get_suspects().size() != 1 || !(locator.get_suspects()[0].tuple_ == faults[0])) {
+    std::cout << "the follow-ups did not isolate the fault" << std::endl;
+    tmp_return = 1;
+  }
+  return tmp_return;
+}
@@ -0,0 +1,193 @@
+// Benchmark for the feasibility oracle on random models with binary and
+// ternary constraints. The oracle is computed with one thread and with
+// several, with the same table size, and by search alone, which must all
+// agree; the generators and the verifier are run with and without it, which
+// must give the same results. On a small model invalidating a parameter, the
+// oracle must agree with the search of the checker.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/common/coverage_verifier.h>
+#include <ct_common/common/feasibility_oracle.h>
+#include <ct_common/common/feasibility_cache.h>
+#include <ct_common/common/model_symmetry.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Build p1 < p2 */
+boost::shared_ptr<Constraint> make_binary(std::size_t p1, std::size_t p2) {
+  boost::shared_ptr<Constraint_A_LT> lt(new Constraint_A_LT());
+  lt->set_loprd(make_param(p1));
+  lt->set_roprd(make_param(p2));
+  return lt;
+}
+
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values, std::size_t strength,
+                 std::size_t num_constraints) {
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, strength));
+  for (std::size_t i = 0; i < num_constraints; ++i) {
+    std::size_t p1 = std::rand() % (num_params - 3);
+    std::size_t p2 = p1 + 1 + std::rand() % 3, p3 = p1 + 1 + std::rand() % 3;
+    if (p2 == p3) {
+      model.constraints_.push_back(make_binary(p1, p2));
+    } else {
+      model.constraints_.push_back(make_ternary(p1, p2, p3));
+    }
+  }
+}
+
+/** Build 3 binary parameters with p0 == 0 -> #p1 */
+void build_invalidating_model(SUTModel &model) {
+  build_model(model, 3, 2, 2, 0);
+  boost::shared_ptr<Constraint_A_EQ> eq(new Constraint_A_EQ());
+  eq->set_loprd(make_param(0));
+  eq->set_roprd(make_int(0));
+  boost::shared_ptr<Constraint_L_IVLD> invalid(new Constraint_L_IVLD());
+  invalid->set_pid(1);
+  boost::shared_ptr<Constraint_L_Imply> imply(new Constraint_L_Imply());
+  imply->set_loprd(eq);
+  imply->set_roprd(invalid);
+  model.constraints_.push_back(imply);
+}
+
+/** Whether the oracle agrees with the search of the checker on all combinations */
+bool is_agreeing(const SUTModel &model, const FeasibilityOracle &oracle) {
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  ModelSymmetry symmetry;
+  FeasibilityCache feasibility(checker, symmetry);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  std::vector<std::size_t> vids;
+  bool tmp_return = oracle.IsMatching(coverage);
+  for (std::size_t cid = 0; cid < coverage.get_num_combinations() && tmp_return; ++cid) {
+    std::size_t sid = coverage.GetRawStrengthId(cid);
+    coverage.GetValues(cid, vids);
+    tmp_return = oracle.IsFeasible(cid) == feasibility.IsFeasible(coverage.get_raw_strength(sid), vids);
+  }
+  return tmp_return;
+}
+
+/** Run a generator with and without the oracle, returns whether they agree */
+template <typename T>
+bool run(T &generator, const SUTModel &model, const boost::shared_ptr<const FeasibilityOracle> &oracle) {
+  std::vector<TestCase> tests[2];
+  std::size_t num_infeasible[2];
+  for (int i = 0; i < 2; ++i) {
+    generator.set_feasibility_oracle(i == 0 ? oracle : boost::shared_ptr<const FeasibilityOracle>());
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    generator.Generate(model, tests[i]);
+    double time = elapsed(start);
+    num_infeasible[i] = generator.get_num_infeasible();
+    std::cout << generator.get_class_name() << (i == 0 ? " with" : " without") << " the oracle: "
+              << tests[i].size() << " tests in " << time << " s, " << num_infeasible[i] << " infeasible" << std::endl;
+  }
+  return is_same_tests(tests[0], tests[1]) && num_infeasible[0] == num_infeasible[1];
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 24, num_values = 4, strength = 3, num_constraints = 12;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_constraints = std::atoi(argv[4]);
+  }
+  std::srand(1);
+  SUTModel model;
+  build_model(model, num_params, num_values, strength, num_constraints);
+  std::cout << num_params << " parameters with " << num_values << " values, strength " << strength
+            << ", " << num_constraints << " constraints" << std::endl;
+
+  int tmp_return = 0;
+  // the table size is the same for the thread runs, the last run searches every combination
+  FeasibilityOracle oracles[3];
+  const std::size_t num_threads[3] = {1, 4, 4};
+  for (int i = 0; i < 3; ++i) {
+    oracles[i].set_num_threads(num_threads[i]);
+    oracles[i].set_max_table_size(i < 2 ? oracles[i].get_max_table_size() : 0);
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    oracles[i].Compute(model);
+    std::cout << "FeasibilityOracle with " << oracles[i].get_num_threads() << " threads, max table size "
+              << oracles[i].get_max_table_size() << ": "
+              << oracles[i].get_num_feasible() << " of " << oracles[i].get_num_combinations() << " feasible, "
+              << oracles[i].get_num_projections() << " projections, " << oracles[i].get_num_searches()
+              << " searches in " << elapsed(start) << " s" << std::endl;
+  }
+  for (int i = 1; i < 3; ++i) {
+    bool is_same = oracles[0].get_num_feasible() == oracles[i].get_num_feasible();
+    for (std::size_t cid = 0; cid < oracles[0].get_num_combinations() && is_same; ++cid) {
+      is_same = oracles[0].IsFeasible(cid) == oracles[i].IsFeasible(cid);
+    }
+    if (!is_same) {
+      std::cout << "the oracle with " << oracles[i].get_num_threads() << " threads, max table size "
+                << oracles[i].get_max_table_size() << " differs" << std::endl;
+      tmp_return = 1;
+    }
+  }
+
+  // the eliminated parameters may take the invalid value
+  SUTModel invalidating_model;
+  build_invalidating_model(invalidating_model);
+  FeasibilityOracle invalidating_oracle;
+  invalidating_oracle.Compute(invalidating_model);
+  std::cout << "p0 == 0 -> #p1: " << invalidating_oracle.get_num_feasible() << " of "
+            << invalidating_oracle.get_num_combinations() << " feasible" << std::endl;
+  if (!is_agreeing(invalidating_model, invalidating_oracle)) {
+    std::cout << "the oracle differs from the checker" << std::endl;
+    tmp_return = 1;
+  }
+  Generator_IPOG invalidating_ipog;
+  if (!run(invalidating_ipog, invalidating_model,
+           boost::shared_ptr<const FeasibilityOracle>(new FeasibilityOracle(invalidating_oracle)))) {
+    std::cout << "the IPOG results differ" << std::endl;
+    tmp_return = 1;
+  }
+
+  boost::shared_ptr<const FeasibilityOracle> oracle(new FeasibilityOracle(oracles[0]));
+  Generator_IPOG ipog;
+  if (!run(ipog, model, oracle)) {
+    std::cout << "the IPOG results differ" << std::endl;
+    tmp_return = 1;
+  }
+  Generator_AETG aetg;
+  aetg.set_num_candidates(10);
+  if (!run(aetg, model, oracle)) {
+    std::cout << "the AETG results differ" << std::endl;
+    tmp_return = 1;
+  }
+  // a small suite leaves many combinations for the infeasibility check
+  std::vector<TestCase> tests;
+  ipog.Generate(model, tests);
+  tests.resize(tests.size() / 4);
+  std::size_t num_infeasible[2];
+  for (int i = 0; i < 2; ++i) {
+    CoverageVerifier verifier;
+    verifier.set_feasibility_oracle(i == 0 ? oracle : boost::shared_ptr<const FeasibilityOracle>());
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    verifier.Verify(model, tests);
+    num_infeasible[i] = verifier.get_total_coverage().num_infeasible_;
+    std::cout << "CoverageVerifier" << (i == 0 ? " with" : " without") << " the oracle: "
+              << verifier.get_total_coverage().num_covered_ << " covered, " << num_infeasible[i]
+              << " infeasible in " << elapsed(start) << " s" << std::endl;
+  }
+  if (num_infeasible[0] != num_infeasible[1]) {
+    std::cout << "the verifier results differ" << std::endl;
+    tmp_return = 1;
+  }
+  return tmp_return;
+}
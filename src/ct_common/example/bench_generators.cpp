@@ -0,0 +1,153 @@
+// Benchmark for the covering array generators on random models, checking the
+// validity and the coverage of the generated test suites.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/common/annealing_optimizer.h>
+#include <ct_common/common/test_suite_reducer.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values,
+                 std::size_t strength, std::size_t num_constraints) {
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, strength));
+  for (std::size_t i = 0; i < num_constraints; ++i) {
+    model.constraints_.push_back(make_implication(0, num_params, num_values));
+  }
+}
+
+/** Check the test suite, returns the number of uncovered combinations */
+std::size_t check_tests(const SUTModel &model, const std::vector<TestCase> &tests) {
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    for (std::size_t j = 0; j < tests[i].size(); ++j) {
+      if (tests[i][j] == VID_BOUND) {
+        std::cerr << "test case " << i << " is incomplete" << std::endl;
+      }
+    }
+    if (!checker.IsValid(tests[i])) {
+      std::cerr << "test case " << i << " violates the constraints" << std::endl;
+    }
+    coverage.Cover(tests[i]);
+  }
+  return coverage.get_num_uncovered();
+}
+
+/** Run a generator, returns whether every feasible combination is covered */
+bool run(Generator &generator, const SUTModel &model, std::vector<TestCase> &tests) {
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  generator.Generate(model, tests);
+  double time = elapsed(start);
+  std::size_t num_uncovered = check_tests(model, tests);
+  std::cout << generator.get_class_name() << ": " << tests.size() << " tests in " << time << " s, "
+            << generator.get_num_combinations() << " combinations, "
+            << generator.get_num_infeasible() << " infeasible";
+  if (num_uncovered != generator.get_num_infeasible()) {
+    std::cout << ", but " << num_uncovered << " uncovered";
+  }
+  std::cout << std::endl;
+  return num_uncovered == generator.get_num_infeasible();
+}
+
+void optimize(AnnealingOptimizer &optimizer, const SUTModel &model, std::vector<TestCase> &tests) {
+  std::size_t num_uncovered = check_tests(model, tests);
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  optimizer.Optimize(model, tests);
+  double time = elapsed(start);
+  std::cout << "AnnealingOptimizer: " << tests.size() << " tests (" << optimizer.get_num_removed()
+            << " removed) in " << time << " s, " << optimizer.get_num_iterations() << " iterations";
+  if (check_tests(model, tests) != num_uncovered) {
+    std::cout << ", but the coverage is lost";
+  }
+  std::cout << std::endl;
+}
+
+void reduce(TestSuiteReducer &reducer, const SUTModel &model, std::vector<TestCase> &tests) {
+  std::size_t num_uncovered = check_tests(model, tests);
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  reducer.Reduce(model, tests);
+  double time = elapsed(start);
+  std::cout << "TestSuiteReducer: " << tests.size() << " tests (" << reducer.get_num_removed()
+            << " removed) in " << time << " s";
+  if (check_tests(model, tests) != num_uncovered) {
+    std::cout << ", but the coverage is lost";
+  }
+  std::cout << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 100, num_values = 3, strength = 3, num_constraints = 10;
+  std::size_t num_candidates = 50, num_threads = 0;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_constraints = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    num_candidates = std::atoi(argv[5]);
+  }
+  if (argc > 6) {
+    num_threads = std::atoi(argv[6]);
+  }
+  std::srand(1);
+  SUTModel model;
+  build_model(model, num_params, num_values, strength, num_constraints);
+  std::cout << num_params << " parameters with " << num_values << " values, strength "
+            << strength << ", " << num_constraints << " constraints" << std::endl;
+
+  std::vector<TestCase> tests, merged;
+  Generator_IPOG ipog;
+  run(ipog, model, tests);
+  merged.insert(merged.end(), tests.begin(), tests.end());
+  AnnealingOptimizer optimizer;
+  optimizer.set_time_limit(10);
+  optimize(optimizer, model, tests);
+  Generator_AETG aetg;
+  aetg.set_num_candidates(num_candidates);
+  aetg.set_num_threads(num_threads);
+  run(aetg, model, tests);
+  merged.insert(merged.end(), tests.begin(), tests.end());
+  Generator_OA oa;
+  run(oa, model, tests);
+  merged.insert(merged.end(), tests.begin(), tests.end());
+  const char *constructions[] = { "none", "Bush", "Rao-Hamming" };
+  std::cout << "  construction: " << constructions[oa.get_construction()] << ", "
+            << oa.get_num_constructed() << " rows, " << oa.get_num_repaired() << " repaired, "
+            << oa.get_num_removed() << " removed" << std::endl;
+  // the suites of all generators merged
+  TestSuiteReducer reducer;
+  reduce(reducer, model, merged);
+
+  // a 3-way strength the array cannot be built for, inside a 2-way one
+  int tmp_return = 0;
+  SUTModel mixed_model;
+  build_model(mixed_model, 6, 6, 2, 0);
+  std::vector<std::size_t> pids;
+  pids.push_back(0);
+  pids.push_back(1);
+  pids.push_back(2);
+  mixed_model.strengths_.push_back(Strength(pids, 3));
+  std::cout << "6 parameters with 6 values, strength 2 and 3 on p0-p2" << std::endl;
+  if (!run(oa, mixed_model, tests)) {
+    tmp_return = 1;
+  }
+  return tmp_return;
+}
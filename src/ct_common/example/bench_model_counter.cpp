@@ -0,0 +1,134 @@
+// Benchmark for the model counting on random models with binary and ternary
+// constraints. The counts are checked against a brute force enumeration of
+// a small model, then taken of a large one out of reach of enumeration.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/model_counter.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Build p1 <= p2 */
+boost::shared_ptr<Constraint> make_binary(std::size_t p1, std::size_t p2) {
+  boost::shared_ptr<Constraint_A_LE> le(new Constraint_A_LE());
+  le->set_loprd(make_param(p1));
+  le->set_roprd(make_param(p2));
+  return le;
+}
+
+/** Constraints link parameters at most span apart, which bounds the treewidth */
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values, std::size_t strength,
+                 std::size_t num_constraints, std::size_t span) {
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, strength));
+  for (std::size_t i = 0; i < num_constraints; ++i) {
+    std::size_t p1 = std::rand() % (num_params - span);
+    std::size_t p2 = p1 + 1 + std::rand() % span, p3 = p1 + 1 + std::rand() % span;
+    if (p2 == p3) {
+      model.constraints_.push_back(make_binary(p1, p2));
+    } else {
+      model.constraints_.push_back(make_ternary(p1, p2, p3));
+    }
+  }
+}
+
+/** Count by enumerating all test cases, with the combinations they cover */
+void brute_force(const SUTModel &model, std::size_t &num_configurations, std::size_t &num_feasible) {
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  TestCase test = checker.MakeEmptyTest();
+  for (std::size_t i = 0; i < test.size(); ++i) {
+    test[i] = 0;
+  }
+  num_configurations = 0;
+  bool is_done = false;
+  while (!is_done) {
+    if (checker.IsValid(test)) {
+      ++num_configurations;
+      coverage.Cover(test);
+    }
+    std::size_t i = test.size();
+    while (i > 0 && ++test[i - 1] == model.param_specs_[i - 1]->get_level()) {
+      test[i - 1] = 0;
+      --i;
+    }
+    is_done = i == 0;
+  }
+  num_feasible = coverage.get_num_covered();
+}
+
+void report(const char *name, const ModelCounter &counter, double time) {
+  std::cout << name << ": " << counter.get_num_configurations() << " valid configurations, "
+            << counter.get_num_feasible_combinations() << " of " << counter.get_num_combinations()
+            << " combinations feasible, treewidth " << counter.get_treewidth() << " in " << time << " s" << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 100, num_values = 4, strength = 2, num_constraints = 60, span = 4;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_constraints = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    span = std::atoi(argv[5]);
+  }
+  std::srand(1);
+  int tmp_return = 0;
+
+  SUTModel small;
+  build_model(small, 9, 3, 3, 8, 3);
+  std::size_t num_configurations = 0, num_feasible = 0;
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  brute_force(small, num_configurations, num_feasible);
+  std::cout << "brute force on 9 parameters: " << num_configurations << " valid configurations, "
+            << num_feasible << " combinations feasible in " << elapsed(start) << " s" << std::endl;
+  for (int i = 0; i < 2; ++i) {
+    ModelCounter counter;
+    counter.set_heuristic(i == 0 ? ELIMINATION_MIN_FILL : ELIMINATION_MIN_DEGREE);
+    start = boost::posix_time::microsec_clock::universal_time();
+    counter.Count(small);
+    report(i == 0 ? "min-fill" : "min-degree", counter, elapsed(start));
+    if (counter.get_num_configurations() != num_configurations ||
+        counter.get_num_feasible_combinations() != num_feasible) {
+      std::cout << "the counts differ" << std::endl;
+      tmp_return = 1;
+    }
+  }
+
+  SUTModel model;
+  build_model(model, num_params, num_values, strength, num_constraints, span);
+  std::cout << num_params << " parameters with " << num_values << " values, strength " << strength
+            << ", " << num_constraints << " constraints spanning " << span << std::endl;
+  boost::multiprecision::cpp_int counts[2];
+  for (int i = 0; i < 2; ++i) {
+    ModelCounter counter;
+    counter.set_heuristic(i == 0 ? ELIMINATION_MIN_FILL : ELIMINATION_MIN_DEGREE);
+    start = boost::posix_time::microsec_clock::universal_time();
+    counter.Count(model);
+    report(i == 0 ? "min-fill" : "min-degree", counter, elapsed(start));
+    counts[i] = counter.get_num_configurations();
+  }
+  if (counts[0] != counts[1]) {
+    std::cout << "the heuristics disagree" << std::endl;
+    tmp_return = 1;
+  }
+  return tmp_return;
+}
@@ -0,0 +1,105 @@
+// Benchmark for the test prioritizer on random test suites. A prefix of the
+// suite is also ordered by the naive greedy scan, which must give the same order.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/test_prioritizer.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Order the test cases by rescanning all of them for every position */
+void naive_order(const SUTModel &model, const std::vector<TestCase> &tests, std::vector<std::size_t> &order) {
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  std::vector<bool> is_taken(tests.size(), false);
+  order.clear();
+  while (true) {
+    std::size_t best = tests.size(), best_gain = 0;
+    for (std::size_t i = 0; i < tests.size(); ++i) {
+      if (is_taken[i]) {
+        continue;
+      }
+      std::size_t gain = coverage.CountUncovered(tests[i]);
+      if (gain > best_gain) {
+        best = i;
+        best_gain = gain;
+      }
+    }
+    if (best == tests.size()) {
+      break;
+    }
+    coverage.Cover(tests[best]);
+    is_taken[best] = true;
+    order.push_back(best);
+  }
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (!is_taken[i]) {
+      order.push_back(i);
+    }
+  }
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 30, num_values = 4, strength = 2, num_rows = 100000, num_checked = 2000;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_rows = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    num_checked = std::atoi(argv[5]);
+  }
+  std::srand(1);
+  SUTModel model;
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, strength));
+  std::vector<TestCase> tests(num_rows);
+  for (std::size_t i = 0; i < num_rows; ++i) {
+    for (std::size_t j = 0; j < num_params; ++j) {
+      tests[i].push_back(std::rand() % num_values);
+    }
+  }
+  std::cout << num_params << " parameters with " << num_values << " values, strength " << strength
+            << ", " << num_rows << " tests" << std::endl;
+
+  TestPrioritizer prioritizer;
+  std::vector<TestCase> ordered = tests;
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  prioritizer.Prioritize(model, ordered);
+  double time = elapsed(start);
+  const std::vector<std::size_t> &cumulative = prioritizer.get_cumulative_coverage();
+  std::cout << "lazy greedy: " << prioritizer.get_num_evaluations() << " evaluations in " << time << " s" << std::endl;
+  for (std::size_t k = 10; k <= num_rows; k *= 10) {
+    std::cout << "  first " << k << " tests cover " << cumulative[k - 1] << " of "
+              << prioritizer.get_num_combinations() << std::endl;
+  }
+
+  int tmp_return = 0;
+  tests.resize(std::min(num_checked, num_rows));
+  std::vector<std::size_t> order;
+  start = boost::posix_time::microsec_clock::universal_time();
+  naive_order(model, tests, order);
+  time = elapsed(start);
+  prioritizer.Prioritize(model, tests);
+  std::cout << "naive greedy on the first " << tests.size() << " tests: " << time << " s, "
+            << prioritizer.get_num_evaluations() << " evaluations when lazy";
+  if (order != prioritizer.get_order()) {
+    std::cout << ", which differs";
+    tmp_return = 1;
+  }
+  std::cout << std::endl;
+  return tmp_return;
+}
@@ -0,0 +1,96 @@
+// Benchmark for the recursive constructions against the direct generator on
+// large uniform models, checking the validity and the coverage of the results.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values,
+                 std::size_t strength, std::size_t num_constraints) {
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, strength));
+  for (std::size_t i = 0; i < num_constraints; ++i) {
+    model.constraints_.push_back(make_implication(0, num_params, num_values));
+  }
+}
+
+/** Check the test suite, returns the number of uncovered combinations */
+std::size_t check_tests(const SUTModel &model, const std::vector<TestCase> &tests) {
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (!checker.IsValid(tests[i])) {
+      std::cerr << "test case " << i << " violates the constraints" << std::endl;
+    }
+    coverage.Cover(tests[i]);
+  }
+  return coverage.get_num_uncovered();
+}
+
+double run(Generator &generator, const SUTModel &model, std::vector<TestCase> &tests) {
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  generator.Generate(model, tests);
+  double time = elapsed(start);
+  std::size_t num_uncovered = check_tests(model, tests);
+  std::cout << generator.get_class_name() << ": " << tests.size() << " tests in " << time << " s, "
+            << generator.get_num_infeasible() << " infeasible";
+  if (num_uncovered != generator.get_num_infeasible()) {
+    std::cout << ", but " << num_uncovered << " uncovered";
+  }
+  std::cout << std::endl;
+  return time;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 2000, num_values = 3, strength = 2, num_constraints = 0;
+  std::size_t max_block_size = 50;
+  bool is_direct = true;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_constraints = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    max_block_size = std::atoi(argv[5]);
+  }
+  if (argc > 6) {
+    is_direct = std::atoi(argv[6]) != 0;
+  }
+  std::srand(1);
+  SUTModel model;
+  build_model(model, num_params, num_values, strength, num_constraints);
+  std::cout << num_params << " parameters with " << num_values << " values, strength "
+            << strength << ", " << num_constraints << " constraints" << std::endl;
+
+  std::vector<TestCase> tests;
+  Generator_Recursive recursive;
+  recursive.set_max_block_size(max_block_size);
+  double recursive_time = run(recursive, model, tests);
+  std::size_t recursive_size = tests.size();
+  std::cout << "  " << recursive.get_num_ingredients() << " ingredients, "
+            << recursive.get_num_composed() << " rows composed" << std::endl;
+  if (is_direct) {
+    Generator_IPOG ipog;
+    double direct_time = run(ipog, model, tests);
+    std::cout << "size ratio " << double(recursive_size) / tests.size()
+              << ", speedup " << direct_time / recursive_time << std::endl;
+  }
+  return 0;
+}
@@ -0,0 +1,133 @@
+// Benchmark for the symmetry detection on a model of interchangeable
+// parameters, at most one of which may take the largest value. The
+// generators and the verifier are run with and without the symmetries, which
+// must give the same results.
+#include <cstdlib>
+#include <iostream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/common/coverage_verifier.h>
+#include <ct_common/common/model_symmetry.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Build p == val */
+boost::shared_ptr<Constraint> make_eq(std::size_t pid, int val) {
+  boost::shared_ptr<Exp_A_Param> param(new Exp_A_Param());
+  param->set_pid(pid);
+  param->set_type(EAT_INT);
+  boost::shared_ptr<Exp_A_CInt> value(new Exp_A_CInt());
+  value->set_value(val);
+  value->set_type(EAT_INT);
+  boost::shared_ptr<Constraint_A_EQ> eq(new Constraint_A_EQ());
+  eq->set_loprd(param);
+  eq->set_roprd(value);
+  return eq;
+}
+
+/** Build !(p1 == val && p2 == val) */
+boost::shared_ptr<Constraint> make_constraint(std::size_t p1, std::size_t p2, int val) {
+  boost::shared_ptr<Constraint_L_And> both(new Constraint_L_And());
+  both->set_loprd(make_eq(p1, val));
+  both->set_roprd(make_eq(p2, val));
+  boost::shared_ptr<Constraint_L_Not> tmp_return(new Constraint_L_Not());
+  tmp_return->set_oprd(both);
+  return tmp_return;
+}
+
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values, std::size_t strength) {
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, strength));
+  for (std::size_t i = 0; i < num_params; ++i) {
+    for (std::size_t j = i + 1; j < num_params; ++j) {
+      model.constraints_.push_back(make_constraint(i, j, int(num_values) - 1));
+    }
+  }
+}
+
+/** Run a generator with and without the symmetries, returns whether they agree */
+template <typename T>
+bool run(T &generator, const SUTModel &model) {
+  std::vector<TestCase> tests[2];
+  std::size_t num_infeasible[2];
+  for (int i = 0; i < 2; ++i) {
+    generator.set_use_symmetry(i == 0);
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    generator.Generate(model, tests[i]);
+    double time = elapsed(start);
+    num_infeasible[i] = generator.get_num_infeasible();
+    std::cout << generator.get_class_name() << (i == 0 ? " with" : " without") << " symmetries: "
+              << tests[i].size() << " tests in " << time << " s, " << num_infeasible[i] << " infeasible" << std::endl;
+  }
+  return is_same_tests(tests[0], tests[1]) && num_infeasible[0] == num_infeasible[1];
+}
+
+/** Run the verifier with and without the symmetries, returns whether they agree */
+bool verify(const SUTModel &model, const std::vector<TestCase> &tests) {
+  std::size_t num_infeasible[2];
+  for (int i = 0; i < 2; ++i) {
+    CoverageVerifier verifier;
+    verifier.set_use_symmetry(i == 0);
+    boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+    verifier.Verify(model, tests);
+    double time = elapsed(start);
+    num_infeasible[i] = verifier.get_total_coverage().num_infeasible_;
+    std::cout << "CoverageVerifier" << (i == 0 ? " with" : " without") << " symmetries: "
+              << verifier.get_total_coverage().num_covered_ << " covered, " << num_infeasible[i]
+              << " infeasible in " << time << " s" << std::endl;
+  }
+  return num_infeasible[0] == num_infeasible[1];
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 12, num_values = 4, strength = 3;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  SUTModel model;
+  build_model(model, num_params, num_values, strength);
+  std::cout << num_params << " parameters with " << num_values << " values, strength " << strength
+            << ", " << model.constraints_.size() << " constraints" << std::endl;
+
+  ModelSymmetry symmetry;
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  symmetry.Detect(model);
+  std::cout << "ModelSymmetry: " << symmetry.get_classes().size() << " classes, group order "
+            << symmetry.get_group_order() << ", detected in " << elapsed(start) << " s" << std::endl;
+
+  int tmp_return = 0;
+  Generator_IPOG ipog;
+  if (!run(ipog, model)) {
+    std::cout << "the IPOG results differ" << std::endl;
+    tmp_return = 1;
+  }
+  Generator_AETG aetg;
+  aetg.set_num_candidates(10);
+  if (!run(aetg, model)) {
+    std::cout << "the AETG results differ" << std::endl;
+    tmp_return = 1;
+  }
+  // a small suite leaves many combinations for the infeasibility check
+  std::vector<TestCase> tests;
+  ipog.Generate(model, tests);
+  tests.resize(tests.size() / 4);
+  if (!verify(model, tests)) {
+    std::cout << "the verifier results differ" << std::endl;
+    tmp_return = 1;
+  }
+  return tmp_return;
+}
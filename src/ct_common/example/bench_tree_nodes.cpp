@@ -0,0 +1,109 @@
+// Benchmark for building and evaluating constraint trees, with the tree nodes
+// placed on the heap or in a NodeArena.
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/test_case.h>
+#include <ct_common/common/node_arena.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Build (p1 + p2 > c) -> (p3 != p4 || p1 * p2 <= p3) */
+boost::shared_ptr<Constraint> make_constraint(std::size_t num_params, std::size_t num_values) {
+  std::size_t p1 = std::rand() % num_params, p2 = std::rand() % num_params;
+  std::size_t p3 = std::rand() % num_params, p4 = std::rand() % num_params;
+  boost::shared_ptr<Exp_A_Add> add(new Exp_A_Add());
+  add->set_loprd(make_param(p1));
+  add->set_roprd(make_param(p2));
+  add->set_type(EAT_INT);
+  boost::shared_ptr<Constraint_A_GT> gt(new Constraint_A_GT());
+  gt->set_loprd(add);
+  gt->set_roprd(make_int(int(std::rand() % (2 * num_values))));
+  boost::shared_ptr<Constraint_A_NE> ne(new Constraint_A_NE());
+  ne->set_loprd(make_param(p3));
+  ne->set_roprd(make_param(p4));
+  boost::shared_ptr<Exp_A_Mult> mult(new Exp_A_Mult());
+  mult->set_loprd(make_param(p1));
+  mult->set_roprd(make_param(p2));
+  mult->set_type(EAT_INT);
+  boost::shared_ptr<Constraint_A_LE> le(new Constraint_A_LE());
+  le->set_loprd(mult);
+  le->set_roprd(make_param(p3));
+  boost::shared_ptr<Constraint_L_Or> disj(new Constraint_L_Or());
+  disj->set_loprd(ne);
+  disj->set_roprd(le);
+  boost::shared_ptr<Constraint_L_Imply> imply(new Constraint_L_Imply());
+  imply->set_loprd(gt);
+  imply->set_roprd(disj);
+  return imply;
+}
+
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values,
+                 std::size_t num_constraints, bool use_arena) {
+  model = SUTModel();
+  add_params(model, num_params, num_values);
+  if (use_arena) {
+    model.arena_ = NodeArena::Create();
+  }
+  NodeArena::Scope arena_scope(model.arena_.get());
+  for (std::size_t i = 0; i < num_constraints; ++i) {
+    model.constraints_.push_back(make_constraint(num_params, num_values));
+  }
+}
+
+double seconds_since(std::clock_t start) {
+  return double(std::clock() - start) / CLOCKS_PER_SEC;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 50, num_values = 5, num_constraints = 20000;
+  std::size_t num_models = 20, num_tests = 200;
+  if (argc > 1) {
+    num_constraints = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_tests = std::atoi(argv[2]);
+  }
+  std::vector<TestCase> tests(num_tests);
+  for (std::size_t i = 0; i < num_tests; ++i) {
+    for (std::size_t j = 0; j < num_params; ++j) {
+      tests[i].push_back(std::rand() % num_values);
+    }
+  }
+  for (int use_arena = 0; use_arena <= 1; ++use_arena) {
+    std::srand(1);
+    std::clock_t start = std::clock();
+    for (std::size_t i = 0; i < num_models; ++i) {
+      SUTModel model;
+      build_model(model, num_params, num_values, num_constraints, use_arena != 0);
+    }
+    double build_time = seconds_since(start);
+
+    SUTModel model;
+    build_model(model, num_params, num_values, num_constraints, use_arena != 0);
+    std::size_t num_satisfied = 0;
+    start = std::clock();
+    for (std::size_t i = 0; i < num_tests; ++i) {
+      for (std::size_t j = 0; j < model.constraints_.size(); ++j) {
+        EvalType_Bool result = model.constraints_[j]->Evaluate(model.param_specs_, tests[i]);
+        if (result.is_valid_ && result.value_) {
+          ++num_satisfied;
+        }
+      }
+    }
+    double eval_time = seconds_since(start);
+    std::cout << (use_arena ? "arena: " : "heap:  ")
+              << "build+free " << build_time / num_models * 1000 << " ms/model, "
+              << "evaluation " << (num_tests * num_constraints) / (eval_time > 0 ? eval_time : 1e-9) << " constraints/s"
+              << " (" << num_satisfied << " satisfied)" << std::endl;
+  }
+  return 0;
+}
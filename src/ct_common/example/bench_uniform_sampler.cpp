@@ -0,0 +1,155 @@
+// Benchmark for the uniform sampling on random models with binary and ternary
+// constraints. On a small model, the frequencies of the configurations drawn
+// are tested against the uniform distribution and the acceptance rate of
+// rejection sampling is reported; on a large one, the draws are timed with
+// different numbers of threads, which must give the same samples.
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_int_distribution.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/uniform_sampler.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Build p1 <= p2 */
+boost::shared_ptr<Constraint> make_binary(std::size_t p1, std::size_t p2) {
+  boost::shared_ptr<Constraint_A_LE> le(new Constraint_A_LE());
+  le->set_loprd(make_param(p1));
+  le->set_roprd(make_param(p2));
+  return le;
+}
+
+/** Constraints link parameters at most span apart, which bounds the treewidth */
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values, std::size_t num_constraints,
+                 std::size_t span) {
+  add_params(model, num_params, num_values);
+  for (std::size_t i = 0; i < num_constraints; ++i) {
+    std::size_t p1 = std::rand() % (num_params - span);
+    std::size_t p2 = p1 + 1 + std::rand() % span, p3 = p1 + 1 + std::rand() % span;
+    if (p2 == p3) {
+      model.constraints_.push_back(make_binary(p1, p2));
+    } else {
+      model.constraints_.push_back(make_ternary(p1, p2, p3));
+    }
+  }
+}
+
+/** Draw test cases uniformly from all test cases, returns the number of valid ones */
+std::size_t reject(const SUTModel &model, std::size_t num_draws) {
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  TestCase test = checker.MakeEmptyTest();
+  boost::random::mt19937 rng(1);
+  std::size_t tmp_return = 0;
+  for (std::size_t i = 0; i < num_draws; ++i) {
+    for (std::size_t j = 0; j < test.size(); ++j) {
+      boost::random::uniform_int_distribution<std::size_t> distribution(0, model.param_specs_[j]->get_level() - 1);
+      test[j] = distribution(rng);
+    }
+    if (checker.IsValid(test)) {
+      ++tmp_return;
+    }
+  }
+  return tmp_return;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 200, num_values = 4, num_constraints = 150, span = 4, num_samples = 100000;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    num_constraints = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    span = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    num_samples = std::atoi(argv[5]);
+  }
+  std::srand(1);
+  int tmp_return = 0;
+
+  // every valid configuration of the small model is expected 100 times
+  SUTModel small;
+  build_model(small, 8, 3, 8, 3);
+  UniformSampler sampler;
+  sampler.Compile(small);
+  std::size_t num_configurations = sampler.get_num_configurations().convert_to<std::size_t>();
+  std::vector<TestCase> tests;
+  sampler.Sample(100 * num_configurations, tests);
+  ConstraintChecker checker(small.param_specs_, small.constraints_);
+  std::map<std::vector<std::size_t>, std::size_t> frequencies;
+  std::size_t num_invalid = 0;
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    if (!checker.IsValid(tests[i])) {
+      ++num_invalid;
+    }
+    std::vector<std::size_t> key;
+    for (std::size_t j = 0; j < tests[i].size(); ++j) {
+      key.push_back(tests[i][j]);
+    }
+    ++frequencies[key];
+  }
+  double chi_square = 0;
+  for (std::map<std::vector<std::size_t>, std::size_t>::const_iterator i = frequencies.begin();
+       i != frequencies.end(); ++i) {
+    chi_square += (i->second - 100.0) * (i->second - 100.0) / 100.0;
+  }
+  // unseen configurations count as well
+  chi_square += 100.0 * (num_configurations - frequencies.size());
+  std::cout << "8 parameters: " << num_configurations << " valid configurations, " << frequencies.size()
+            << " drawn, " << num_invalid << " invalid samples, chi-square " << chi_square << " with "
+            << num_configurations - 1 << " degrees of freedom" << std::endl;
+  std::size_t num_accepted = reject(small, tests.size());
+  std::cout << "rejection sampling accepts " << num_accepted << " of " << tests.size() << " draws" << std::endl;
+  // a deviation of more than 5 standard deviations from the mean
+  double deviation = chi_square - (num_configurations - 1.0);
+  if (num_invalid > 0 || frequencies.size() > num_configurations || deviation * deviation > 50.0 * num_configurations) {
+    std::cout << "the samples are not uniform" << std::endl;
+    tmp_return = 1;
+  }
+
+  SUTModel model;
+  build_model(model, num_params, num_values, num_constraints, span);
+  std::cout << num_params << " parameters with " << num_values << " values, " << num_constraints
+            << " constraints spanning " << span << std::endl;
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  sampler.Compile(model);
+  std::cout << "compiled " << sampler.get_num_configurations() << " valid configurations into "
+            << sampler.get_num_entries() << " entries, treewidth " << sampler.get_treewidth() << " in "
+            << elapsed(start) << " s" << std::endl;
+  std::vector<TestCase> results[2];
+  for (int i = 0; i < 2; ++i) {
+    sampler.set_num_threads(i == 0 ? 1 : 4);
+    start = boost::posix_time::microsec_clock::universal_time();
+    sampler.Sample(num_samples, results[i]);
+    std::cout << num_samples << " samples with " << sampler.get_num_threads() << " threads in "
+              << elapsed(start) << " s" << std::endl;
+  }
+  checker.Init(model.param_specs_, model.constraints_);
+  num_invalid = 0;
+  for (std::size_t i = 0; i < results[0].size(); ++i) {
+    if (!checker.IsValid(results[0][i])) {
+      ++num_invalid;
+    }
+  }
+  if (num_invalid > 0 || !is_same_tests(results[0], results[1])) {
+    std::cout << num_invalid << " invalid samples, or the threads disagree" << std::endl;
+    tmp_return = 1;
+  }
+  return tmp_return;
+}
@@ -0,0 +1,122 @@
+//===----- ct_common/example/bench_util.h -----------------------*- C++ -*-===//
+//
+//                      The ct_common Library
+//
+// This file is distributed under the MIT license. See LICENSE for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This header file contains the helpers shared by the benchmarks, which build
+// their models programmatically
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CT_COMMON_EXAMPLE_BENCH_UTIL_H_
+#define CT_COMMON_EXAMPLE_BENCH_UTIL_H_
+
+#include <cstdlib>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/shared_ptr.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/test_case.h>
+
+namespace ct {
+namespace example {
+/** Get the seconds passed since start */
+inline double elapsed(const boost::posix_time::ptime &start) {
+  return (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+}
+
+/** Build an integer reference to a parameter */
+inline boost::shared_ptr<common::Exp_A> make_param(std::size_t pid) {
+  boost::shared_ptr<common::Exp_A_Param> exp(new common::Exp_A_Param());
+  exp->set_pid(pid);
+  exp->set_type(common::EAT_INT);
+  return exp;
+}
+
+/** Build an integer constant */
+inline boost::shared_ptr<common::Exp_A> make_int(int val) {
+  boost::shared_ptr<common::Exp_A_CInt> exp(new common::Exp_A_CInt());
+  exp->set_value(val);
+  exp->set_type(common::EAT_INT);
+  return exp;
+}
+
+/** Build p1 + p2 != p3 */
+inline boost::shared_ptr<common::Constraint> make_ternary(std::size_t p1, std::size_t p2, std::size_t p3) {
+  boost::shared_ptr<common::Exp_A_Add> sum(new common::Exp_A_Add());
+  sum->set_loprd(make_param(p1));
+  sum->set_roprd(make_param(p2));
+  sum->set_type(common::EAT_INT);
+  boost::shared_ptr<common::Constraint_A_NE> ne(new common::Constraint_A_NE());
+  ne->set_loprd(sum);
+  ne->set_roprd(make_param(p3));
+  return ne;
+}
+
+/** Build p1 == v1 -> p2 != v2 on two random parameters from first to first + num_params - 1 */
+inline boost::shared_ptr<common::Constraint> make_implication(std::size_t first, std::size_t num_params,
+                                                              std::size_t num_values) {
+  std::size_t p1 = std::rand() % num_params, p2 = std::rand() % num_params;
+  while (p2 == p1) {
+    p2 = std::rand() % num_params;
+  }
+  boost::shared_ptr<common::Constraint_A_EQ> eq(new common::Constraint_A_EQ());
+  eq->set_loprd(make_param(first + p1));
+  eq->set_roprd(make_int(int(std::rand() % num_values)));
+  boost::shared_ptr<common::Constraint_A_NE> ne(new common::Constraint_A_NE());
+  ne->set_loprd(make_param(first + p2));
+  ne->set_roprd(make_int(int(std::rand() % num_values)));
+  boost::shared_ptr<common::Constraint_L_Imply> imply(new common::Constraint_L_Imply());
+  imply->set_loprd(eq);
+  imply->set_roprd(ne);
+  return imply;
+}
+
+/**
+ * Append integer parameters named prefix0, prefix1, ..., each with the values
+ * 0 to num_values - 1, returns their pids
+ */
+inline std::vector<std::size_t> add_params(common::SUTModel &model, std::size_t num_params, std::size_t num_values,
+                                           const std::string &prefix = "p") {
+  std::vector<std::string> values;
+  for (std::size_t j = 0; j < num_values; ++j) {
+    std::ostringstream ss;
+    ss << j;
+    values.push_back(ss.str());
+  }
+  std::vector<std::size_t> tmp_return;
+  for (std::size_t i = 0; i < num_params; ++i) {
+    std::ostringstream ss;
+    ss << prefix << i;
+    boost::shared_ptr<common::ParamSpec> param_spec(new common::ParamSpec_Int());
+    param_spec->set_param_name(ss.str());
+    param_spec->set_values(values);
+    tmp_return.push_back(model.param_specs_.size());
+    model.param_specs_.push_back(param_spec);
+  }
+  return tmp_return;
+}
+
+/** Whether two test suites are the same, row by row */
+inline bool is_same_tests(const std::vector<common::TestCase> &left, const std::vector<common::TestCase> &right) {
+  bool tmp_return = left.size() == right.size();
+  for (std::size_t i = 0; i < left.size() && tmp_return; ++i) {
+    tmp_return = left[i].size() == right[i].size();
+    for (std::size_t j = 0; j < left[i].size() && tmp_return; ++j) {
+      tmp_return = left[i][j] == right[i][j];
+    }
+  }
+  return tmp_return;
+}
+}  // namespace example
+}  // namespace ct
+
+#endif  // CT_COMMON_EXAMPLE_BENCH_UTIL_H_
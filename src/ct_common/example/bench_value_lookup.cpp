@@ -0,0 +1,81 @@
+// Benchmark for looking up value ids by strings, with the ValueIndex of
+// ParamSpec and with a std::map as the previous implementation did.
+#include <cstdlib>
+#include <ctime>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <ct_common/common/defs.h>
+#include <ct_common/common/paramspecs.h>
+
+using namespace ct::common;
+
+namespace {
+double seconds_since(std::clock_t start) {
+  return double(std::clock() - start) / CLOCKS_PER_SEC;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_values = 5000, num_lookups = 5000000;
+  if (argc > 1) {
+    num_values = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_lookups = std::atoi(argv[2]);
+  }
+  std::vector<std::string> values;
+  for (std::size_t i = 0; i < num_values; ++i) {
+    std::ostringstream ss;
+    ss << "config_option_value_" << i;
+    values.push_back(ss.str());
+  }
+  std::vector<std::string> queries;
+  std::srand(1);
+  for (std::size_t i = 0; i < 4096; ++i) {
+    // one query in 16 is absent from the domain
+    if (i % 16 == 0) {
+      queries.push_back("unknown_value");
+    } else {
+      queries.push_back(values[std::rand() % num_values]);
+    }
+  }
+
+  std::clock_t start = std::clock();
+  std::map<std::string, std::size_t> map_string_values_2_vid;
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    map_string_values_2_vid.insert(std::pair<std::string, std::size_t>(values[i], i));
+  }
+  double map_build_time = seconds_since(start);
+  std::size_t map_sum = 0;
+  start = std::clock();
+  for (std::size_t i = 0; i < num_lookups; ++i) {
+    std::map<std::string, std::size_t>::const_iterator iter =
+        map_string_values_2_vid.find(queries[i % queries.size()]);
+    map_sum += (iter != map_string_values_2_vid.end()) ? iter->second : VID_BOUND;
+  }
+  double map_time = seconds_since(start);
+
+  start = std::clock();
+  ParamSpec_String param_spec;
+  param_spec.set_param_name("p");
+  param_spec.set_values(values);
+  double index_build_time = seconds_since(start);
+  std::size_t index_sum = 0;
+  start = std::clock();
+  for (std::size_t i = 0; i < num_lookups; ++i) {
+    index_sum += param_spec.query_value_id(queries[i % queries.size()]);
+  }
+  double index_time = seconds_since(start);
+
+  std::cout << num_values << " values, " << num_lookups << " lookups" << std::endl;
+  std::cout << "std::map:   build " << map_build_time * 1000 << " ms, "
+            << num_lookups / (map_time > 0 ? map_time : 1e-9) << " lookups/s" << std::endl;
+  std::cout << "ValueIndex: build " << index_build_time * 1000 << " ms, "
+            << num_lookups / (index_time > 0 ? index_time : 1e-9) << " lookups/s" << std::endl;
+  if (map_sum != index_sum) {
+    std::cerr << "mismatching results" << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,117 @@
+// Benchmark for the coverage verifier on random test suites, comparing it with
+// a sequential CoverageMap pass. The suite goes through the CSV format first.
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/constraints.h>
+#include <ct_common/common/exps.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/constraint_checker.h>
+#include <ct_common/common/coverage_verifier.h>
+#include <ct_common/common/test_suite_file.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 20, num_values = 3, strength = 4, num_rows = 100000;
+  std::size_t num_constraints = 5, num_threads = 0;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_rows = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    num_constraints = std::atoi(argv[5]);
+  }
+  if (argc > 6) {
+    num_threads = std::atoi(argv[6]);
+  }
+  std::srand(1);
+  SUTModel model;
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, strength));
+  for (std::size_t i = 0; i < num_constraints; ++i) {
+    model.constraints_.push_back(make_implication(0, num_params, num_values));
+  }
+  std::vector<TestCase> tests(num_rows);
+  for (std::size_t i = 0; i < num_rows; ++i) {
+    for (std::size_t j = 0; j < num_params; ++j) {
+      tests[i].push_back(std::rand() % num_values);
+    }
+  }
+  std::cout << num_params << " parameters with " << num_values << " values, strength " << strength
+            << ", " << num_constraints << " constraints, " << num_rows << " tests" << std::endl;
+
+  std::stringstream csv;
+  save_test_suite(csv, model.param_specs_, tests);
+  std::vector<TestCase> loaded;
+  std::string message;
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  if (!load_test_suite(csv, model.param_specs_, loaded, message) || loaded.size() != tests.size()) {
+    std::cerr << "failed to load the test suite: " << message << std::endl;
+    return 1;
+  }
+  std::cout << "loaded in " << elapsed(start) << " s" << std::endl;
+
+  // a suite with invalid values reads back the same
+  std::vector<TestCase> invalid_tests(tests.begin(), tests.begin() + std::min<std::size_t>(num_rows, 100));
+  for (std::size_t i = 0; i < invalid_tests.size(); i += 3) {
+    std::size_t pid = i % num_params;
+    invalid_tests[i][pid] = model.param_specs_[pid]->get_invalid_vid();
+  }
+  std::stringstream invalid_csv;
+  save_test_suite(invalid_csv, model.param_specs_, invalid_tests);
+  std::vector<TestCase> invalid_loaded;
+  bool is_same = load_test_suite(invalid_csv, model.param_specs_, invalid_loaded, message) &&
+      invalid_loaded.size() == invalid_tests.size();
+  for (std::size_t i = 0; i < invalid_tests.size() && is_same; ++i) {
+    for (std::size_t j = 0; j < num_params && is_same; ++j) {
+      is_same = invalid_loaded[i][j] == invalid_tests[i][j];
+    }
+  }
+  if (!is_same) {
+    std::cerr << "the suite with invalid values does not read back: " << message << std::endl;
+    return 1;
+  }
+
+  CoverageVerifier verifier;
+  verifier.set_num_threads(num_threads);
+  start = boost::posix_time::microsec_clock::universal_time();
+  verifier.Verify(model, loaded);
+  double time = elapsed(start);
+  const StrengthCoverage &total = verifier.get_total_coverage();
+  std::cout << "CoverageVerifier: " << total.num_covered_ << " of " << total.num_combinations_
+            << " covered, " << total.num_infeasible_ << " infeasible, " << total.get_num_missing()
+            << " missing, " << verifier.get_num_invalid() << " invalid tests in " << time << " s" << std::endl;
+
+  // the sequential pass over valid test cases
+  start = boost::posix_time::microsec_clock::universal_time();
+  ConstraintChecker checker(model.param_specs_, model.constraints_);
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  for (std::size_t i = 0; i < loaded.size(); ++i) {
+    if (checker.IsValid(loaded[i])) {
+      coverage.Cover(loaded[i]);
+    }
+  }
+  time = elapsed(start);
+  std::cout << "CoverageMap: " << coverage.get_num_covered() << " covered in " << time << " s";
+  if (coverage.get_num_covered() != total.num_covered_) {
+    std::cout << ", which differs";
+  }
+  std::cout << std::endl;
+  return 0;
+}
@@ -0,0 +1,142 @@
+// Benchmark for the weighted coverage targets. With all weights scaled by the
+// same factor, the generators and the prioritizer must give exactly the
+// unweighted results; with a heavy strength and a heavy value, the weighted
+// suites must still cover every combination, while their prefixes cover the
+// heavy combinations sooner.
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/coverage_weights.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/common/test_prioritizer.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+void build_model(SUTModel &model, std::size_t num_params, std::size_t num_values) {
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  model.strengths_.push_back(Strength(pids, 2));
+  pids.resize(4);
+  model.strengths_.push_back(Strength(pids, 3));
+}
+
+/** Generate a suite, printing the time and the size */
+void generate(const std::string &name, Generator &generator, const SUTModel &model, std::vector<TestCase> &tests) {
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  generator.Generate(model, tests);
+  std::cout << "  " << name << ": " << tests.size() << " tests in " << elapsed(start) << " s" << std::endl;
+}
+
+/** Whether a suite covers all combinations */
+bool is_covering(const SUTModel &model, const std::vector<TestCase> &tests) {
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    coverage.Cover(tests[i]);
+  }
+  return coverage.get_num_uncovered() == 0;
+}
+
+/** Get the weights covered by the prefixes of a suite */
+void weigh_prefixes(const SUTModel &model, const std::vector<TestCase> &tests, std::vector<double> &cumulative) {
+  CoverageMap coverage(model.param_specs_, model.strengths_);
+  CoverageWeightTable weights;
+  weights.Init(model.strengths_, model.weights_, coverage);
+  double covered = 0;
+  cumulative.clear();
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    covered += weights.WeighUncovered(coverage, tests[i]);
+    coverage.Cover(tests[i]);
+    cumulative.push_back(covered / weights.get_total_weight());
+  }
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 20, num_values = 4;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  SUTModel model;
+  build_model(model, num_params, num_values);
+  std::cout << num_params << " parameters with " << num_values << " values, strength 2 on all and 3 on p0-p3"
+            << std::endl;
+
+  int tmp_return = 0;
+  Generator_IPOG ipog;
+  Generator_AETG aetg;
+  TestPrioritizer prioritizer;
+  std::vector<TestCase> ipog_tests, aetg_tests, ordered;
+  std::cout << "unweighted" << std::endl;
+  generate("IPOG", ipog, model, ipog_tests);
+  generate("AETG", aetg, model, aetg_tests);
+  ordered = aetg_tests;
+  prioritizer.Prioritize(model, ordered);
+  std::vector<std::size_t> order = prioritizer.get_order();
+
+  // scaling all weights keeps every choice
+  SUTModel scaled_model = model;
+  scaled_model.weights_.set_strength_weight(0, 2);
+  scaled_model.weights_.set_strength_weight(1, 2);
+  std::vector<TestCase> tests;
+  std::cout << "all strengths weighing 2" << std::endl;
+  generate("IPOG", ipog, scaled_model, tests);
+  if (!is_same_tests(tests, ipog_tests)) {
+    std::cout << "  the IPOG suite differs" << std::endl;
+    tmp_return = 1;
+  }
+  generate("AETG", aetg, scaled_model, tests);
+  if (!is_same_tests(tests, aetg_tests)) {
+    std::cout << "  the AETG suite differs" << std::endl;
+    tmp_return = 1;
+  }
+  prioritizer.Prioritize(scaled_model, tests);
+  if (prioritizer.get_order() != order) {
+    std::cout << "  the prioritized order differs" << std::endl;
+    tmp_return = 1;
+  }
+
+  // the 3-way strength and the first value of the last parameter weigh more
+  SUTModel weighted_model = model;
+  weighted_model.weights_.set_strength_weight(1, 10);
+  weighted_model.weights_.set_value_weight(num_params - 1, 0, 5);
+  std::vector<double> unweighted_prefixes, weighted_prefixes;
+  std::cout << "the 3-way strength weighing 10, p" << num_params - 1 << "=0 weighing 5" << std::endl;
+  generate("IPOG", ipog, weighted_model, tests);
+  weigh_prefixes(weighted_model, ipog_tests, unweighted_prefixes);
+  weigh_prefixes(weighted_model, tests, weighted_prefixes);
+  if (!is_covering(weighted_model, tests)) {
+    std::cout << "  the IPOG suite is not covering" << std::endl;
+    tmp_return = 1;
+  }
+  generate("AETG", aetg, weighted_model, tests);
+  if (!is_covering(weighted_model, tests)) {
+    std::cout << "  the AETG suite is not covering" << std::endl;
+    tmp_return = 1;
+  }
+  std::vector<double> ordered_prefixes;
+  weigh_prefixes(weighted_model, ordered, ordered_prefixes);
+  prioritizer.Prioritize(weighted_model, aetg_tests);
+  const std::vector<double> &cumulative = prioritizer.get_cumulative_weights();
+  std::cout << "weighted coverage of the first tests (IPOG unweighted/weighted, AETG ordered unweighted/weighted)"
+            << std::endl;
+  for (std::size_t k = 1; k <= 64 && k <= ordered.size() && k <= ipog_tests.size(); k *= 2) {
+    std::cout << "  " << k << ": " << unweighted_prefixes[k - 1] << " / " << weighted_prefixes[k - 1] << ", "
+              << ordered_prefixes[k - 1] << " / " << cumulative[k - 1] / (cumulative.back() > 0 ? cumulative.back() : 1)
+              << std::endl;
+  }
+  // the weighted greedy takes the heaviest test case first
+  if (cumulative[0] / cumulative.back() < ordered_prefixes[0]) {
+    std::cout << "the weighted order starts with a lighter test case" << std::endl;
+    tmp_return = 1;
+  }
+  return tmp_return;
+}
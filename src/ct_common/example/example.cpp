@@ -1,3 +1,4 @@
+#include <cstdlib>
 #include <iostream>
 #include <fstream>
 #include <map>
@@ -8,17 +9,44 @@
 #include <ct_common/file_parse/err_logger_cerr.h>
 #include <ct_common/common/sutmodel.h>
 #include <ct_common/common/tuplepool.h>
+#include <ct_common/common/mapped_file.h>
+#include <ct_common/common/model_cache.h>
+#include <ct_common/common/generators.h>
+#include <ct_common/common/test_suite_file.h>
+#include <ct_common/common/domain_reducer.h>
+#include <ct_common/common/model_counter.h>
+#include <ct_common/common/uniform_sampler.h>
 
 using namespace ct;
 using namespace ct::common;
 
 int main(int argc, char* argv[]) {
   std::string file_name;
-  if (argc < 2) {
+  bool use_cache = false;
+  bool use_ipog = false;
+  bool use_reduce = false;
+  std::size_t num_samples = 0;
+  std::string base_file_name;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string(argv[i]) == "--cache") {
+      use_cache = true;
+    } else if (std::string(argv[i]) == "--ipog") {
+      use_ipog = true;
+    } else if (std::string(argv[i]) == "--reduce") {
+      use_reduce = true;
+    } else if (std::string(argv[i]) == "--sample" && i + 1 < argc) {
+      num_samples = std::strtoul(argv[++i], 0, 10);
+    } else if (std::string(argv[i]) == "--extend" && i + 1 < argc) {
+      use_ipog = true;
+      base_file_name = argv[++i];
+    } else {
+      file_name = argv[i];
+    }
+  }
+  if (file_name.empty()) {
     std::cerr << "please specify the file name" << std::endl;
     return 1;
   }
-  file_name = argv[1];
   std::ifstream infile;
 #ifdef _MSC_VER
   // handling file names with non-ascii characters
@@ -36,34 +64,124 @@ int main(int argc, char* argv[]) {
     return 1;
   }
   SUTModel sut_model;
-  Assembler assembler;
-  try {
-    ct::lexer lexer(&infile);
-    assembler.setErrLogger(boost::shared_ptr<ErrLogger>(new ErrLogger_Cerr()));
-    yy::ct_parser parser(lexer,
-                         sut_model.param_specs_,
-                         sut_model.strengths_, 
-                         sut_model.seeds_,
-                         sut_model.constraints_,
-                         assembler);
-    parser.parse();
-  } catch (std::runtime_error e) {
-    std::cerr << e.what() << std::endl;
-  } catch (...) {
-    std::cerr << "unhandled exception when parsing input file" << std::endl;
-    std::cerr << "exiting" << std::endl;
-    return 1;
+  // with --cache, the model is loaded from <file>.ctc if it is built from the same source
+  std::string cache_name = file_name + ".ctc";
+  boost::uint64_t source_hash = 0;
+  bool is_cached = false;
+  if (use_cache) {
+    MappedFile source;
+    if (source.Open(file_name)) {
+      source_hash = hash_model_source(source.get_data(), source.get_size());
+    }
+    try {
+      is_cached = load_model_cache(cache_name, source_hash, sut_model);
+    } catch (std::runtime_error &e) {
+      std::cerr << e.what() << ", ignoring the cache" << std::endl;
+      is_cached = false;
+    }
   }
-  if (assembler.numErrs() > 0) {
-    std::cerr << assembler.numErrs() << " errors in the input file, exiting" << std::endl;
-    return 2;
+  Assembler assembler;
+  if (!is_cached) {
+    try {
+      ct::lexer lexer(&infile);
+      assembler.setErrLogger(boost::shared_ptr<ErrLogger>(new ErrLogger_Cerr()));
+      // place all tree nodes of the model contiguously
+      sut_model.arena_ = NodeArena::Create();
+      NodeArena::Scope arena_scope(sut_model.arena_.get());
+      yy::ct_parser parser(lexer,
+                           sut_model.param_specs_,
+                           sut_model.strengths_, 
+                           sut_model.seeds_,
+                           sut_model.constraints_,
+                           assembler);
+      parser.parse();
+      sut_model.weights_ = assembler.get_weights();
+    } catch (std::runtime_error e) {
+      std::cerr << e.what() << std::endl;
+    } catch (...) {
+      std::cerr << "unhandled exception when parsing input file" << std::endl;
+      std::cerr << "exiting" << std::endl;
+      return 1;
+    }
+    if (assembler.numErrs() > 0) {
+      std::cerr << assembler.numErrs() << " errors in the input file, exiting" << std::endl;
+      return 2;
+    }
+    if (use_cache && !save_model_cache(cache_name, sut_model, source_hash)) {
+      std::cerr << "cannot write the model cache " << cache_name << std::endl;
+    }
   }
   std::cout << "successfully parsed the input file" << std::endl;
   std::cout << "# parameters:  " << sut_model.param_specs_.size() << std::endl;
   std::cout << "# strengths:   " << sut_model.strengths_.size() << std::endl;
   std::cout << "# seeds:       " << sut_model.seeds_.size() << std::endl;
   std::cout << "# constraints: " << sut_model.constraints_.size() << std::endl;
-  
+
+  // with --reduce, the values no valid test case can take are removed first,
+  // the test cases being reported in the original values
+  DomainReducer reducer;
+  SUTModel original_model = sut_model;
+  if (use_reduce) {
+    reducer.Reduce(original_model, sut_model);
+    std::cout << "# removed values: " << reducer.get_num_removed_values() << std::endl;
+    std::cout << "# removed target combinations: " << reducer.get_num_removed_combinations() << std::endl;
+  }
+
+  // with --ipog, a covering array is generated and printed instead;
+  // with --extend <suite>, the suite of an earlier model is extended
+  if (use_ipog) {
+    Generator_IPOG generator;
+    std::vector<TestCase> tests;
+    if (!base_file_name.empty()) {
+      std::ifstream base_file(base_file_name.c_str());
+      std::string message;
+      if (!base_file || !load_test_suite(base_file, original_model.param_specs_, tests, message, true)) {
+        std::cerr << base_file_name << ": " << (base_file ? message : "cannot open the file") << std::endl;
+        return 1;
+      }
+      for (std::size_t i = 0; i < tests.size(); ++i) {
+        if (!reducer.ReduceTest(tests[i])) {
+          std::cerr << base_file_name << ": test case " << i + 1 << " takes a removed value" << std::endl;
+          return 1;
+        }
+      }
+      generator.set_base_tests(tests);
+    }
+    try {
+      generator.Generate(sut_model, tests);
+    } catch (std::exception &e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+    std::cout << "# infeasible combinations: " << generator.get_num_infeasible() << std::endl;
+    std::cout << "# tests: " << tests.size();
+    if (!base_file_name.empty()) {
+      std::cout << " (" << generator.get_base_tests().size() << " extended)";
+    }
+    std::cout << std::endl;
+    reducer.RestoreTests(tests);
+    save_test_suite(std::cout, original_model.param_specs_, tests);
+    return 0;
+  }
+
+  // with --sample <n>, n valid test cases drawn uniformly are printed instead
+  if (num_samples > 0) {
+    UniformSampler sampler;
+    std::vector<TestCase> tests;
+    try {
+      sampler.Compile(sut_model);
+      sampler.Sample(num_samples, tests);
+    } catch (std::exception &e) {
+      std::cerr << e.what() << std::endl;
+      return 1;
+    }
+    std::cout << "# valid configurations: " << sampler.get_num_configurations() << std::endl;
+    std::cout << "# tests: " << tests.size() << std::endl;
+    reducer.RestoreTests(tests);
+    save_test_suite(std::cout, original_model.param_specs_, tests);
+    return 0;
+  }
+
   std::vector<RawStrength> raw_strengths;
   TuplePool tuple_pool;
   for (std::size_t i = 0; i < sut_model.strengths_.size(); ++i) {
@@ -99,5 +217,19 @@ int main(int argc, char* argv[]) {
     } while (tuple.to_the_next_tuple_with_ivld(sut_model.param_specs_));
   }
   std::cout << "# forbidden combinations: " << forbidden_tuple_pool.size() << std::endl;
+
+  ModelCounter counter;
+  try {
+    counter.Count(sut_model);
+    std::cout << "# valid configurations: " << counter.get_num_configurations() << std::endl;
+    std::cout << "# feasible target combinations: " << counter.get_num_feasible_combinations();
+    if (counter.get_num_combinations() > 0) {
+      std::cout << " (" << 100.0 * counter.get_num_feasible_combinations() / counter.get_num_combinations() << "%)";
+    }
+    std::cout << std::endl;
+    std::cout << "# treewidth: " << counter.get_treewidth() << std::endl;
+  } catch (std::exception &e) {
+    std::cerr << "cannot count the configurations: " << e.what() << std::endl;
+  }
   return 0;
 }
@@ -0,0 +1,140 @@
+// Stress test for the lock-free coverage map: several threads cover the rows of
+// the same random test case stream, while the main thread takes snapshot counts.
+// The final counts, the bitmap and the sum of the per-call counts must equal
+// those of a single-threaded CoverageMap pass over the stream.
+#include <cstdlib>
+#include <iostream>
+#include <boost/atomic.hpp>
+#include <boost/thread/thread.hpp>
+#include <boost/date_time/posix_time/posix_time.hpp>
+#include <ct_common/common/paramspecs.h>
+#include <ct_common/common/coverage_map.h>
+#include <ct_common/common/concurrent_coverage_map.h>
+#include <ct_common/example/bench_util.h>
+
+using namespace ct::common;
+using namespace ct::example;
+
+namespace {
+/** Covers the rows first, first + step, ... */
+struct CoverWorker {
+  void operator () () const {
+    std::size_t num_covered = 0;
+    for (std::size_t i = this->first_; i < this->tests_->size(); i += this->step_) {
+      num_covered += this->coverage_->Cover((*this->tests_)[i]);
+    }
+    *this->num_covered_ = num_covered;
+    this->num_finished_->fetch_add(1);
+  }
+
+  ConcurrentCoverageMap *coverage_;
+  const std::vector<TestCase> *tests_;
+  std::size_t *num_covered_;
+  boost::atomic<std::size_t> *num_finished_;
+  std::size_t first_;
+  std::size_t step_;
+};
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::size_t num_params = 30, num_values = 3, strength = 3, num_rows = 20000, num_rounds = 10;
+  if (argc > 1) {
+    num_params = std::atoi(argv[1]);
+  }
+  if (argc > 2) {
+    num_values = std::atoi(argv[2]);
+  }
+  if (argc > 3) {
+    strength = std::atoi(argv[3]);
+  }
+  if (argc > 4) {
+    num_rows = std::atoi(argv[4]);
+  }
+  if (argc > 5) {
+    num_rounds = std::atoi(argv[5]);
+  }
+  std::srand(1);
+  SUTModel model;
+  std::vector<std::size_t> pids = add_params(model, num_params, num_values);
+  const std::vector<boost::shared_ptr<ParamSpec> > &param_specs = model.param_specs_;
+  std::vector<Strength> strengths;
+  strengths.push_back(Strength(pids, strength));
+  strengths.push_back(Strength(std::vector<std::size_t>(pids.begin(), pids.begin() + pids.size() / 2), strength + 1));
+  std::vector<TestCase> tests(num_rows);
+  for (std::size_t i = 0; i < num_rows; ++i) {
+    for (std::size_t j = 0; j < num_params; ++j) {
+      tests[i].push_back(std::rand() % num_values);
+    }
+  }
+  std::cout << num_params << " parameters with " << num_values << " values, strength " << strength
+            << ", " << num_rows << " tests" << std::endl;
+
+  CoverageMap expected(param_specs, strengths);
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  for (std::size_t i = 0; i < tests.size(); ++i) {
+    expected.Cover(tests[i]);
+  }
+  std::cout << "single-threaded: " << expected.get_num_covered() << " of " << expected.get_num_combinations()
+            << " covered in " << elapsed(start) << " s" << std::endl;
+
+  int tmp_return = 0;
+  CoverageMap layout(param_specs, strengths);
+  ConcurrentCoverageMap coverage(layout);
+  for (std::size_t round = 0; round < num_rounds; ++round) {
+    std::size_t num_threads = 2 + round % 7;
+    coverage.Reset();
+    std::vector<std::size_t> num_covered(num_threads, 0);
+    boost::atomic<std::size_t> num_finished(0);
+    CoverWorker worker;
+    worker.coverage_ = &coverage;
+    worker.tests_ = &tests;
+    worker.num_finished_ = &num_finished;
+    worker.step_ = num_threads;
+    start = boost::posix_time::microsec_clock::universal_time();
+    boost::thread_group threads;
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      worker.first_ = i;
+      worker.num_covered_ = &num_covered[i];
+      threads.create_thread(worker);
+    }
+    // the snapshots never decrease nor exceed the final count
+    std::size_t num_snapshots = 0, last_snapshot = 0;
+    bool is_monotonic = true;
+    while (num_finished.load() < num_threads) {
+      std::size_t snapshot = coverage.GetNumCovered();
+      is_monotonic = is_monotonic && snapshot >= last_snapshot && snapshot <= expected.get_num_covered();
+      last_snapshot = snapshot;
+      ++num_snapshots;
+    }
+    threads.join_all();
+    double time = elapsed(start);
+
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i < num_threads; ++i) {
+      sum += num_covered[i];
+    }
+    CoverageMap stored(param_specs, strengths);
+    coverage.Store(stored);
+    bool is_same = coverage.GetNumCovered() == expected.get_num_covered() &&
+        sum == expected.get_num_covered() && stored.get_num_covered() == expected.get_num_covered();
+    for (std::size_t cid = 0; cid < expected.get_num_combinations() && is_same; ++cid) {
+      is_same = stored.IsCovered(cid) == expected.IsCovered(cid) && coverage.IsCovered(cid) == expected.IsCovered(cid);
+    }
+    for (std::size_t sid = 0; sid < expected.get_num_raw_strengths() && is_same; ++sid) {
+      is_same = coverage.GetNumCovered(sid) ==
+          expected.CountCovered(expected.get_offset(sid), expected.get_offset(sid + 1));
+    }
+    std::cout << "round " << round << ", " << num_threads << " threads: " << coverage.GetNumCovered()
+              << " covered in " << time << " s, " << num_snapshots << " snapshots";
+    if (!is_monotonic) {
+      std::cout << ", a snapshot went backwards";
+      tmp_return = 1;
+    }
+    if (!is_same) {
+      std::cout << ", which differs";
+      tmp_return = 1;
+    }
+    std::cout << std::endl;
+  }
+  return tmp_return;
+}
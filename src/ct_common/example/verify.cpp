@@ -0,0 +1,106 @@
+// Verifies that a test suite, given as comma-separated values with a header
+// line of parameter names, covers the strengths of a model under its constraints.
+// Usage: verify [--threads N] [--max-listed N] <model file> <test suite file>
+#include <cstdlib>
+#include <iostream>
+#include <fstream>
+#include <boost/date_time/posix_time/posix_time.hpp>
+
+#include <ct_common/file_parse/ct_lexer.hpp>
+#include <ct_common/file_parse/ct_parser.tab.hpp>
+#include <ct_common/file_parse/assembler.h>
+#include <ct_common/file_parse/err_logger_cerr.h>
+#include <ct_common/common/sutmodel.h>
+#include <ct_common/common/test_suite_file.h>
+#include <ct_common/common/coverage_verifier.h>
+
+using namespace ct;
+using namespace ct::common;
+
+namespace {
+void print_coverage(const StrengthCoverage &coverage) {
+  std::cout << coverage.num_covered_ << " of " << coverage.num_combinations_ << " covered, "
+            << coverage.num_infeasible_ << " infeasible, " << coverage.get_num_missing() << " missing"
+            << std::endl;
+}
+}  // namespace
+
+int main(int argc, char* argv[]) {
+  std::vector<std::string> file_names;
+  CoverageVerifier verifier;
+  for (int i = 1; i < argc; ++i) {
+    if (std::string(argv[i]) == "--threads" && i + 1 < argc) {
+      verifier.set_num_threads(std::atoi(argv[++i]));
+    } else if (std::string(argv[i]) == "--max-listed" && i + 1 < argc) {
+      verifier.set_max_listed(std::atoi(argv[++i]));
+    } else {
+      file_names.push_back(argv[i]);
+    }
+  }
+  if (file_names.size() != 2) {
+    std::cerr << "usage: verify [--threads N] [--max-listed N] <model file> <test suite file>" << std::endl;
+    return 1;
+  }
+  std::ifstream model_file(file_names[0].c_str());
+  if (!model_file.is_open()) {
+    std::cerr << "cannot open the model file" << std::endl;
+    return 1;
+  }
+  SUTModel sut_model;
+  Assembler assembler;
+  try {
+    ct::lexer lexer(&model_file);
+    assembler.setErrLogger(boost::shared_ptr<ErrLogger>(new ErrLogger_Cerr()));
+    yy::ct_parser parser(lexer,
+                         sut_model.param_specs_,
+                         sut_model.strengths_,
+                         sut_model.seeds_,
+                         sut_model.constraints_,
+                         assembler);
+    parser.parse();
+    sut_model.weights_ = assembler.get_weights();
+  } catch (std::runtime_error &e) {
+    std::cerr << e.what() << std::endl;
+    return 1;
+  }
+  if (assembler.numErrs() > 0) {
+    std::cerr << assembler.numErrs() << " errors in the model file, exiting" << std::endl;
+    return 2;
+  }
+
+  std::ifstream suite_file(file_names[1].c_str());
+  if (!suite_file.is_open()) {
+    std::cerr << "cannot open the test suite file" << std::endl;
+    return 1;
+  }
+  std::vector<TestCase> tests;
+  std::string message;
+  if (!load_test_suite(suite_file, sut_model.param_specs_, tests, message)) {
+    std::cerr << file_names[1] << ": " << message << std::endl;
+    return 2;
+  }
+
+  boost::posix_time::ptime start = boost::posix_time::microsec_clock::universal_time();
+  verifier.Verify(sut_model, tests);
+  double time = (boost::posix_time::microsec_clock::universal_time() - start).total_microseconds() / 1e6;
+  std::cout << "# tests: " << tests.size() << " (" << verifier.get_num_incomplete() << " incomplete, "
+            << verifier.get_num_invalid() << " invalid), verified in " << time << " s" << std::endl;
+  for (std::size_t i = 0; i < sut_model.strengths_.size(); ++i) {
+    std::cout << "strength " << sut_model.strengths_[i].second << " over "
+              << sut_model.strengths_[i].first.size() << " parameters: ";
+    print_coverage(verifier.get_strength_coverages()[i]);
+  }
+  std::cout << "total: ";
+  print_coverage(verifier.get_total_coverage());
+  const std::vector<Tuple> &missing = verifier.get_missing();
+  for (std::size_t i = 0; i < missing.size(); ++i) {
+    std::cout << "missing:";
+    for (Tuple::const_iterator iter = missing[i].begin(); iter != missing[i].end(); ++iter) {
+      std::cout << " " << sut_model.param_specs_[iter->pid_]->get_param_name() << "="
+                << sut_model.param_specs_[iter->pid_]->get_string_value(iter->vid_);
+    }
+    std::cout << std::endl;
+  }
+  std::cout << (verifier.IsPassed() ? "PASSED" : "FAILED") << std::endl;
+  return verifier.IsPassed() ? 0 : 3;
+}
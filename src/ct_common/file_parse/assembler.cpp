@@ -29,6 +29,7 @@ Assembler::Assembler(const Assembler &from) {
   this->default_precision_ = from.default_precision_;
   this->err_logger_ = from.err_logger_;
   this->stored_invalidations_ = from.stored_invalidations_;
+  this->weights_ = from.weights_;
 }
 
 Assembler::~Assembler(void) {
@@ -38,6 +39,7 @@ const Assembler &Assembler::operator =(const Assembler &right) {
   this->default_precision_ = right.default_precision_;
   this->err_logger_ = right.err_logger_;
   this->stored_invalidations_ = right.stored_invalidations_;
+  this->weights_ = right.weights_;
   return (*this);
 }
 
@@ -96,8 +98,31 @@ ParamSpec *Assembler::asm_paramspec(
       this->reportWarning("bool <param>;");
       this->reportWarning("bool <param>: true, false;");
     }
+  } else if (TYPE_CHECK(tmp_return, ParamSpec_Int*) && vals.size() == 1 &&
+             TYPE_CHECK(vals[0].get(), Exp_A_CIntRange*)) {
+    // a single range is kept as an arithmetic progression
+    const Exp_A_CIntRange *range = dynamic_cast<const Exp_A_CIntRange *>(vals[0].get());
+    dynamic_cast<ParamSpec_Int *>(tmp_return)->set_range(
+        range->get_begin(), range->get_step(), range->get_num_values());
+    return tmp_return;
   } else {
     for (std::size_t i = 0; i < vals.size(); ++i) {
+      if (TYPE_CHECK(vals[i].get(), Exp_A_CIntRange*)) {
+        const Exp_A_CIntRange *range = dynamic_cast<const Exp_A_CIntRange *>(vals[i].get());
+        if (TYPE_CHECK(tmp_return, ParamSpec_String*)) {
+          std::ostringstream ss;
+          range->dump(ss, std::vector<boost::shared_ptr<ParamSpec> >());
+          this->reportWarning(
+              std::string("warning: forcing integer range ") + ss.str()
+              + " as strings for parameter " + tmp_return->get_param_name());
+        }
+        for (std::size_t j = 0; j < range->get_num_values(); ++j) {
+          std::ostringstream ss;
+          ss << range->get_value(j);
+          str_vals.push_back(ss.str());
+        }
+        continue;
+      }
       if (TYPE_CHECK(tmp_return, ParamSpec_Int*) &&
           TYPE_CHECK(vals[i].get(), Exp_S_CString*)) {
         this->reportWarning(
@@ -302,6 +327,10 @@ TreeNode *Assembler::asm_param(const std::vector<boost::shared_ptr<ParamSpec> >
     CT_EXCEPTION((std::string("parameter ") + identifier + " not found").c_str());
     return 0;
   }
+  return this->asm_param(param_specs, pid);
+}
+
+TreeNode *Assembler::asm_param(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs, std::size_t pid) {
   TreeNode *tmp_return = 0;
   if (TYPE_CHECK(param_specs[pid].get(), ParamSpec_String*)) {
     Exp_S_Param *exp = new Exp_S_Param();
@@ -718,3 +747,31 @@ void Assembler::set_option(const std::string &identifier, const ct::common::Tree
     CT_EXCEPTION("unhandled option");
   }
 }
+
+namespace {
+/** Get the numeric value of a weight */
+double weight_value(const ct::common::TreeNode *value) {
+  if (dynamic_cast<const Exp_A_CInt*>(value)) {
+    return dynamic_cast<const Exp_A_CInt*>(value)->get_value();
+  } else if (dynamic_cast<const Exp_A_CDouble*>(value)) {
+    return dynamic_cast<const Exp_A_CDouble*>(value)->get_value();
+  }
+  CT_EXCEPTION("weights should be numbers");
+  return 0;
+}
+}  // namespace
+
+void Assembler::set_strength_weight(std::size_t index, const ct::common::TreeNode *value) {
+  this->weights_.set_strength_weight(index, weight_value(value));
+}
+
+void Assembler::set_value_weight(const std::string &identifier, const ct::common::PVPair *pvpair,
+                                 const ct::common::TreeNode *value) {
+  if (identifier != "weight") {
+    CT_EXCEPTION(std::string("unhandled option ")+identifier);
+  }
+  if (pvpair == NULL) {
+    CT_EXCEPTION("encountered null pvpair");
+  }
+  this->weights_.set_value_weight(pvpair->pid_, pvpair->vid_, weight_value(value));
+}
@@ -22,6 +22,7 @@
 #include <ct_common/common/seed.h>
 #include <ct_common/common/exps.h>
 #include <ct_common/common/strength.h>
+#include <ct_common/common/coverage_weights.h>
 #include <ct_common/file_parse/err_logger.h>
 
 namespace ct {
@@ -146,15 +147,25 @@ public:
 
   /** Setting an option */
   void set_option(const std::string &identifier, const ct::common::TreeNode *value);
+  /** Set the weight of the strength of an index */
+  void set_strength_weight(std::size_t index, const ct::common::TreeNode *value);
+  /** Set the weight of a parameter value, by an option of the form weight(pvpair) */
+  void set_value_weight(const std::string &identifier, const ct::common::PVPair *pvpair,
+                        const ct::common::TreeNode *value);
+  /** Get the weights of the strengths and values assembled */
+  const CoverageWeights &get_weights(void) const { return this->weights_; }
 
 private:
   /** Geting the conjunction of a set of constraints */
   Constraint *conjunction(const std::vector<boost::shared_ptr<TreeNode> > &constrs);
+  /** Assemble a parameter constraint/expression by pid */
+  TreeNode *asm_param(const std::vector<boost::shared_ptr<ParamSpec> > &param_specs, std::size_t pid);
 
 private:
   boost::shared_ptr<ErrLogger> err_logger_;  /**< The error logger */
   std::map<std::size_t, std::vector<boost::shared_ptr<TreeNode> > > stored_invalidations_;  /**< Stored parameter invalidation constraint */
   double default_precision_;  /**< The default floating-point precision */
+  CoverageWeights weights_;  /**< The weights of the strengths and values */
 };
 }  // namepsace common
 }  // namespace ct